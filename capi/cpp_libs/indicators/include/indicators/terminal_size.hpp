@@ -1,44 +0,0 @@
-
-#ifndef INDICATORS_TERMINAL_SIZE
-#define INDICATORS_TERMINAL_SIZE
-#include <utility>
-
-
-#if defined(_WIN32)
-#include <windows.h>
-
-namespace indicators {
-
-static inline std::pair<size_t, size_t> terminal_size() {
-  CONSOLE_SCREEN_BUFFER_INFO csbi;
-  int cols, rows;
-  GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
-  cols = csbi.srWindow.Right - csbi.srWindow.Left + 1;
-  rows = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
-  return {static_cast<size_t>(rows), static_cast<size_t>(cols)};
-}
-
-static inline size_t terminal_width() { return terminal_size().second; }
-
-} // namespace indicators
-
-#else
-
-#include <sys/ioctl.h> //ioctl() and TIOCGWINSZ
-#include <unistd.h>    // for STDOUT_FILENO
-
-namespace indicators {
-
-static inline std::pair<size_t, size_t> terminal_size() {
-  struct winsize size{};
-  ioctl(STDOUT_FILENO, TIOCGWINSZ, &size);
-  return {static_cast<size_t>(size.ws_row), static_cast<size_t>(size.ws_col)};
-}
-
-static inline size_t terminal_width() { return terminal_size().second; }
-
-} // namespace indicators
-
-#endif
-
-#endif
\ No newline at end of file
@@ -11,6 +11,22 @@ class GraphFilePaths(IGraphFilePaths):
     def default_graph_path(self) -> str:
         return os.path.join(self._folder_path, "default")
 
+    @property
+    def coarse_graph_path(self) -> str:
+        return os.path.join(self._folder_path, "coarse")
+
+    @property
+    def contraction_hierarchy_path(self) -> str:
+        return os.path.join(self._folder_path, "contraction_hierarchy")
+
+    @property
+    def landmarks_path(self) -> str:
+        return os.path.join(self._folder_path, "landmarks")
+
+    @property
+    def sparse_graph_path(self) -> str:
+        return os.path.join(self._folder_path, "sparse")
+
     @property
     def folder_path(self) -> str:
         return self._folder_path
@@ -0,0 +1,13 @@
+import typing
+from dataclasses import dataclass
+
+from capi.src.implementation.dtos.coordinate import Coordinate
+
+
+@dataclass
+class DistanceMatrix:
+    # distances[i][j] is the length in degrees of the shortest path from the ith source to the jth destination, and
+    # infinite where there is none
+    distances: typing.Sequence[typing.Sequence[float]]
+    # paths[i][j] is that path, when paths are asked for
+    paths: typing.Optional[typing.Sequence[typing.Sequence[typing.Optional[typing.Sequence[Coordinate]]]]] = None
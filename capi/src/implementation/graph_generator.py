@@ -1,3 +1,4 @@
+import math
 import os
 import typing
 from functools import reduce
@@ -5,48 +6,218 @@ from functools import reduce
 from capi.src.implementation.datastructures.graph_file_paths import GraphFilePaths
 from capi.src.implementation.shapefiles.shapefile_reader import ShapefileReader
 from capi.src.implementation.visibility_graphs import (
+    VisGraph,
     VisGraphCoord,
+    VisGraphGenerationStats,
     VisGraphPolygon,
+    VisGraphSimplificationMethod,
+    VisGraphSparse,
+    build_contraction_hierarchy as build_visgraph_contraction_hierarchy,
+    build_landmarks,
+    generate_coarse_visgraph,
+    generate_sparse_visgraph_to_file,
     generate_visgraph,
+    generate_visgraph_tile,
+    generate_visgraph_with_checkpoints,
     generate_visgraph_with_shuffled_range,
+    load_sparse_graph_from_file,
+    save_contraction_hierarchy_to_file,
     save_graph_to_file,
+    save_landmarks_to_file,
+    simplify_polygons,
+    simplify_polygons_outwards,
+    visgraph_tile_ids,
 )
 from capi.src.interfaces.graph_generator import IGraphGenerator
 from capi.src.interfaces.shapefiles.shapefile_reader import IShapefileReader
 
 
+_SIMPLIFICATION_METHODS = {
+    "douglas_peucker": VisGraphSimplificationMethod.DOUGLAS_PEUCKER,
+    "visvalingam": VisGraphSimplificationMethod.VISVALINGAM,
+}
+
+
 class GraphGenerator(IGraphGenerator):
     def __init__(self, shapefile_reader: typing.Optional[IShapefileReader] = None):
         self._shapefile_reader = ShapefileReader() if shapefile_reader is None else shapefile_reader
 
-    def generate(self, shape_file_path: str, output_path: str) -> None:
-        os.mkdir(output_path)
+    def generate(
+        self,
+        shape_file_path: str,
+        output_path: str,
+        periodic_replication_margin: float = math.inf,
+        max_edge_length: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
+        checkpoint_path: typing.Optional[str] = None,
+        stats: typing.Optional[VisGraphGenerationStats] = None,
+        coarse_simplification_tolerance_metres: typing.Optional[float] = None,
+        build_contraction_hierarchy: bool = False,
+        num_landmarks: int = 0,
+    ) -> None:
+        # A checkpointed generation may have died after creating the output directory
+        if checkpoint_path is None or not os.path.isdir(output_path):
+            os.mkdir(output_path)
         graph_file = GraphFilePaths(output_path)
 
         curr_file_output_path = graph_file.default_graph_path
 
-        polygons = self._read_polygons_from_shapefile(shape_file_path)
+        polygons = self._simplify_polygons(
+            self._read_polygons_from_shapefile(shape_file_path), simplification_method, simplification_tolerance_metres
+        )
 
-        graph = generate_visgraph(polygons)
+        if checkpoint_path is None:
+            graph = generate_visgraph(polygons, periodic_replication_margin, max_edge_length, stats)
+        else:
+            graph = generate_visgraph_with_checkpoints(
+                polygons, checkpoint_path, periodic_replication_margin, max_edge_length, stats=stats
+            )
 
         save_graph_to_file(graph, curr_file_output_path)
 
+        self._save_search_data(
+            graph,
+            polygons,
+            graph_file,
+            periodic_replication_margin,
+            max_edge_length,
+            coarse_simplification_tolerance_metres,
+            build_contraction_hierarchy,
+            num_landmarks,
+        )
+
+        if checkpoint_path is not None:
+            os.remove(checkpoint_path)
+
+    def resume(
+        self,
+        shape_file_path: str,
+        output_path: str,
+        checkpoint_path: str,
+        periodic_replication_margin: float = math.inf,
+        max_edge_length: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
+        stats: typing.Optional[VisGraphGenerationStats] = None,
+        coarse_simplification_tolerance_metres: typing.Optional[float] = None,
+        build_contraction_hierarchy: bool = False,
+        num_landmarks: int = 0,
+    ) -> None:
+        if not os.path.exists(checkpoint_path):
+            raise FileNotFoundError(f"No checkpoint to resume from at {checkpoint_path}")
+
+        self.generate(
+            shape_file_path,
+            output_path,
+            periodic_replication_margin=periodic_replication_margin,
+            max_edge_length=max_edge_length,
+            simplification_method=simplification_method,
+            simplification_tolerance_metres=simplification_tolerance_metres,
+            checkpoint_path=checkpoint_path,
+            stats=stats,
+            coarse_simplification_tolerance_metres=coarse_simplification_tolerance_metres,
+            build_contraction_hierarchy=build_contraction_hierarchy,
+            num_landmarks=num_landmarks,
+        )
+
+    def generate_with_memory_limit(
+        self,
+        shape_file_path: str,
+        output_path: str,
+        memory_limit_bytes: int,
+        periodic_replication_margin: float = math.inf,
+        max_edge_length: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
+        stats: typing.Optional[VisGraphGenerationStats] = None,
+        coarse_simplification_tolerance_metres: typing.Optional[float] = None,
+        build_contraction_hierarchy: bool = False,
+        num_landmarks: int = 0,
+    ) -> None:
+        os.mkdir(output_path)
+        graph_file = GraphFilePaths(output_path)
+
+        polygons = self._simplify_polygons(
+            self._read_polygons_from_shapefile(shape_file_path), simplification_method, simplification_tolerance_metres
+        )
+
+        generate_sparse_visgraph_to_file(
+            polygons,
+            graph_file.sparse_graph_path,
+            memory_limit_bytes,
+            periodic_replication_margin,
+            max_edge_length,
+            stats,
+        )
+
+        # The sparse graph is memory mapped, so building from it stays within the limit as far as the graph goes
+        self._save_search_data(
+            load_sparse_graph_from_file(graph_file.sparse_graph_path),
+            polygons,
+            graph_file,
+            periodic_replication_margin,
+            max_edge_length,
+            coarse_simplification_tolerance_metres,
+            build_contraction_hierarchy,
+            num_landmarks,
+        )
+
     def generate_for_vertex_range(
-        self, shape_file_path: str, output_path: str, current_split_num: int, num_splits: int, seed: int
+        self,
+        shape_file_path: str,
+        output_path: str,
+        current_split_num: int,
+        num_splits: int,
+        seed: int,
+        periodic_replication_margin: float = math.inf,
+        max_edge_length: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
     ) -> None:
         os.mkdir(output_path)
         graph_file = GraphFilePaths(output_path)
 
         curr_file_output_path = graph_file.default_graph_path
 
-        polygons = self._read_polygons_from_shapefile(shape_file_path)
+        polygons = self._simplify_polygons(
+            self._read_polygons_from_shapefile(shape_file_path), simplification_method, simplification_tolerance_metres
+        )
         num_vertices = self._get_num_vertices_in_polygons(polygons)
         split_size = num_vertices // num_splits
 
         split_start = split_size * current_split_num
         split_end = (split_size * (current_split_num + 1)) if current_split_num < num_splits - 1 else num_vertices
 
-        graph = generate_visgraph_with_shuffled_range(polygons, split_start, split_end, seed)
+        graph = generate_visgraph_with_shuffled_range(
+            polygons, split_start, split_end, seed, periodic_replication_margin, max_edge_length
+        )
+
+        save_graph_to_file(graph, curr_file_output_path)
+
+    def get_tile_ids(self, shape_file_path: str, tile_level: int) -> typing.Sequence[int]:
+        return visgraph_tile_ids(self._read_polygons_from_shapefile(shape_file_path), tile_level)
+
+    def generate_for_tile(
+        self,
+        shape_file_path: str,
+        output_path: str,
+        tile_id: int,
+        halo: float,
+        periodic_replication_margin: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
+    ) -> None:
+        os.mkdir(output_path)
+        graph_file = GraphFilePaths(output_path)
+
+        curr_file_output_path = graph_file.default_graph_path
+
+        polygons = self._simplify_polygons(
+            self._read_polygons_from_shapefile(shape_file_path), simplification_method, simplification_tolerance_metres
+        )
+
+        graph = generate_visgraph_tile(polygons, tile_id, halo, periodic_replication_margin)
 
         save_graph_to_file(graph, curr_file_output_path)
 
@@ -59,6 +230,52 @@ class GraphGenerator(IGraphGenerator):
 
         return unadjusted_polygons
 
+    @staticmethod
+    def _save_search_data(
+        graph: typing.Union[VisGraph, VisGraphSparse],
+        polygons: typing.Sequence[VisGraphPolygon],
+        graph_file: GraphFilePaths,
+        periodic_replication_margin: float,
+        max_edge_length: float,
+        coarse_simplification_tolerance_metres: typing.Optional[float],
+        build_contraction_hierarchy: bool,
+        num_landmarks: int,
+    ) -> None:
+        # The coarse level for long-haul queries keeps the vertices of the detailed polygons that paths bend around
+        if coarse_simplification_tolerance_metres is not None:
+            coarse_polygons = simplify_polygons_outwards(
+                polygons, VisGraphSimplificationMethod.VISVALINGAM, coarse_simplification_tolerance_metres
+            )
+            coarse_graph = generate_coarse_visgraph(
+                polygons, coarse_polygons, periodic_replication_margin, max_edge_length
+            )
+            save_graph_to_file(coarse_graph, graph_file.coarse_graph_path)
+
+        # Paid for once here so that queries can use VisGraphSearchAlgorithm.CONTRACTION_HIERARCHY
+        if build_contraction_hierarchy:
+            save_contraction_hierarchy_to_file(
+                build_visgraph_contraction_hierarchy(graph), graph_file.contraction_hierarchy_path
+            )
+
+        # and so that they can use VisGraphSearchHeuristic.LANDMARKS
+        if num_landmarks > 0:
+            save_landmarks_to_file(build_landmarks(graph, num_landmarks), graph_file.landmarks_path)
+
+    @staticmethod
+    def _simplify_polygons(
+        polygons: typing.Sequence[VisGraphPolygon],
+        simplification_method: typing.Optional[str],
+        simplification_tolerance_metres: float,
+    ) -> typing.Sequence[VisGraphPolygon]:
+        if simplification_method is None:
+            return polygons
+        if simplification_method not in _SIMPLIFICATION_METHODS:
+            raise ValueError(f"Unknown simplification method: {simplification_method}")
+
+        return simplify_polygons(
+            polygons, _SIMPLIFICATION_METHODS[simplification_method], simplification_tolerance_metres
+        )
+
     @staticmethod
     def _get_num_vertices_in_polygons(polygons: typing.Sequence[VisGraphPolygon]) -> int:
         return reduce(lambda a, b: a + b, map(lambda polygon: len(polygon.vertices), polygons))
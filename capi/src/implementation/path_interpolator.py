@@ -1,14 +1,23 @@
 import math
+import os
 import typing
 import warnings
 
 from capi.src.implementation.datastructures.graph_file_paths import GraphFilePaths
 from capi.src.implementation.dtos.coordinate import Coordinate
+from capi.src.implementation.dtos.distance_matrix import DistanceMatrix
 from capi.src.implementation.visibility_graphs import (
     VisGraphBatchInterpolateResult,
+    VisGraphCacheStatsSnapshot,
     VisGraphCoord,
+    VisGraphSearchAlgorithm,
+    VisGraphSearchHeuristic,
+    VisGraphSearchStats,
     VisGraphShortestPathComputer,
+    load_contraction_hierarchy_from_file,
     load_graph_from_file,
+    load_landmarks_from_file,
+    load_sparse_graph_from_file,
 )
 from capi.src.interfaces.path_interpolator import IPathInterpolator
 
@@ -17,11 +26,51 @@ class PathInterpolator(IPathInterpolator):
     def __init__(
         self,
         visibility_graph_file_path: str,
+        refinement_radius: typing.Optional[float] = None,
+        endpoint_cache_capacity: typing.Optional[int] = None,
+        path_cache_capacity: typing.Optional[int] = None,
+        path_cache_cell_size: typing.Optional[float] = None,
     ):
         graph_paths = GraphFilePaths(visibility_graph_file_path)
-        graph = load_graph_from_file(graph_paths.default_graph_path)
+        # Graphs generated within a memory limit are only written in the sparse format
+        if os.path.exists(graph_paths.default_graph_path):
+            graph = load_graph_from_file(graph_paths.default_graph_path)
+        else:
+            graph = load_sparse_graph_from_file(graph_paths.sparse_graph_path)
 
-        self._shortest_path_computer = VisGraphShortestPathComputer(graph)
+        # Graphs generated with a coarse level route long-haul queries over it
+        coarse_graph = None
+        if os.path.exists(graph_paths.coarse_graph_path):
+            coarse_graph = load_graph_from_file(graph_paths.coarse_graph_path)
+
+        # and graphs generated with a contraction hierarchy can be searched with it
+        contraction_hierarchy = None
+        if os.path.exists(graph_paths.contraction_hierarchy_path):
+            contraction_hierarchy = load_contraction_hierarchy_from_file(graph_paths.contraction_hierarchy_path)
+
+        # and graphs generated with landmarks can guide searches with them
+        landmarks = None
+        if os.path.exists(graph_paths.landmarks_path):
+            landmarks = load_landmarks_from_file(graph_paths.landmarks_path)
+
+        # Options left unset take the computer's own defaults
+        options = {
+            name: value
+            for name, value in (
+                ("refinement_radius", refinement_radius),
+                ("endpoint_cache_capacity", endpoint_cache_capacity),
+                ("path_cache_capacity", path_cache_capacity),
+                ("path_cache_cell_size", path_cache_cell_size),
+            )
+            if value is not None
+        }
+        self._shortest_path_computer = VisGraphShortestPathComputer(
+            graph,
+            coarse_graph,
+            contraction_hierarchy=contraction_hierarchy,
+            landmarks=landmarks,
+            **options,
+        )
 
     def interpolate(
         self,
@@ -30,12 +79,22 @@ class PathInterpolator(IPathInterpolator):
         search_distance_from_source_limit: float = math.inf,
         correct_vertices_on_land: bool = False,
         a_star_greediness_weighting: float = 1.0,
+        search_algorithm: VisGraphSearchAlgorithm = VisGraphSearchAlgorithm.A_STAR,
+        heuristic: VisGraphSearchHeuristic = VisGraphSearchHeuristic.STRAIGHT_LINE,
+        stats: typing.Optional[VisGraphSearchStats] = None,
     ) -> typing.Sequence[Coordinate]:
         point_1 = VisGraphCoord(coord_1.longitude, coord_1.latitude)
         point_2 = VisGraphCoord(coord_2.longitude, coord_2.latitude)
 
         path = self._get_shortest_path(
-            point_1, point_2, search_distance_from_source_limit, correct_vertices_on_land, a_star_greediness_weighting
+            point_1,
+            point_2,
+            search_distance_from_source_limit,
+            correct_vertices_on_land,
+            a_star_greediness_weighting,
+            search_algorithm,
+            heuristic,
+            stats,
         )
 
         return path
@@ -46,6 +105,9 @@ class PathInterpolator(IPathInterpolator):
         search_distance_from_source_limit: float = math.inf,
         correct_vertices_on_land: bool = False,
         a_star_greediness_weighting: float = 1.0,
+        search_algorithm: VisGraphSearchAlgorithm = VisGraphSearchAlgorithm.A_STAR,
+        heuristic: VisGraphSearchHeuristic = VisGraphSearchHeuristic.STRAIGHT_LINE,
+        stats: typing.Optional[VisGraphSearchStats] = None,
     ) -> typing.Sequence[typing.Optional[typing.Sequence[Coordinate]]]:
         _coord_pairs = [
             (
@@ -56,9 +118,54 @@ class PathInterpolator(IPathInterpolator):
         ]
 
         return self._batch_get_shortest_path(
-            _coord_pairs, search_distance_from_source_limit, correct_vertices_on_land, a_star_greediness_weighting
+            _coord_pairs,
+            search_distance_from_source_limit,
+            correct_vertices_on_land,
+            a_star_greediness_weighting,
+            search_algorithm,
+            heuristic,
+            stats,
         )
 
+    def distance_matrix(
+        self,
+        sources: typing.Sequence[Coordinate],
+        destinations: typing.Sequence[Coordinate],
+        search_distance_from_source_limit: float = math.inf,
+        correct_vertices_on_land: bool = False,
+        include_paths: bool = False,
+        stats: typing.Optional[VisGraphSearchStats] = None,
+    ) -> DistanceMatrix:
+        matrix = self._shortest_path_computer.distance_matrix(
+            [VisGraphCoord(source.longitude, source.latitude) for source in sources],
+            [VisGraphCoord(destination.longitude, destination.latitude) for destination in destinations],
+            search_distance_from_source_limit,
+            correct_vertices_on_land,
+            include_paths,
+            stats,
+        )
+
+        for error_msg in [*matrix.source_error_msgs, *matrix.target_error_msgs]:
+            if error_msg is not None:
+                warnings.warn(f"CAPI Distance Matrix: {error_msg}")
+
+        if not include_paths:
+            return DistanceMatrix(distances=matrix.distances)
+
+        return DistanceMatrix(
+            distances=matrix.distances,
+            paths=[
+                [None if path is None else self._convert_visgraph_coords_list_to_coordinates(path) for path in row]
+                for row in matrix.paths
+            ],
+        )
+
+    def endpoint_cache_stats(self) -> VisGraphCacheStatsSnapshot:
+        return self._shortest_path_computer.endpoint_cache_stats()
+
+    def path_cache_stats(self) -> VisGraphCacheStatsSnapshot:
+        return self._shortest_path_computer.path_cache_stats()
+
     def _get_shortest_path(
         self,
         start: VisGraphCoord,
@@ -66,6 +173,9 @@ class PathInterpolator(IPathInterpolator):
         search_distance_from_source_limit: float,
         correct_vertices_on_land: bool,
         a_star_greediness_weighting: float,
+        search_algorithm: VisGraphSearchAlgorithm,
+        heuristic: VisGraphSearchHeuristic,
+        stats: typing.Optional[VisGraphSearchStats],
     ) -> typing.Sequence[Coordinate]:
         path = self._shortest_path_computer.shortest_path(
             start,
@@ -73,6 +183,9 @@ class PathInterpolator(IPathInterpolator):
             search_distance_from_source_limit,
             correct_vertices_on_land,
             a_star_greediness_weighting,
+            search_algorithm,
+            heuristic,
+            stats,
         )
         return self._convert_visgraph_coords_list_to_coordinates(path)
 
@@ -82,9 +195,18 @@ class PathInterpolator(IPathInterpolator):
         search_distance_from_source_limit: float,
         correct_vertices_on_land: bool,
         a_star_greediness_weighting: float,
+        search_algorithm: VisGraphSearchAlgorithm,
+        heuristic: VisGraphSearchHeuristic,
+        stats: typing.Optional[VisGraphSearchStats],
     ) -> typing.Sequence[typing.Optional[typing.Sequence[Coordinate]]]:
         results = self._shortest_path_computer.shortest_paths(
-            coord_pairs, search_distance_from_source_limit, correct_vertices_on_land, a_star_greediness_weighting
+            coord_pairs,
+            search_distance_from_source_limit,
+            correct_vertices_on_land,
+            a_star_greediness_weighting,
+            search_algorithm,
+            heuristic,
+            stats,
         )
 
         interpolated_paths: typing.List[typing.Optional[typing.Sequence[Coordinate]]] = []
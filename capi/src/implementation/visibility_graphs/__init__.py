@@ -1,14 +1,45 @@
 from capi.src.implementation.visibility_graphs._vis_graph import (  # type: ignore
     VisGraph,
     VisGraphBatchInterpolateResult,
+    VisGraphCacheStatsSnapshot,
+    VisGraphContractionHierarchy,
     VisGraphCoord,
+    VisGraphDistanceMatrix,
+    VisGraphGenerationStats,
+    VisGraphGenerationStatsSnapshot,
+    VisGraphLandmarks,
     VisGraphPolygon,
+    VisGraphSearchAlgorithm,
+    VisGraphSearchHeuristic,
+    VisGraphSearchStats,
+    VisGraphSearchStatsSnapshot,
     VisGraphShortestPathComputer,
+    VisGraphSimplificationMethod,
+    VisGraphSparse,
     VisGraphVisibleVertex,
     VistreeGenerator,
+    build_contraction_hierarchy,
+    build_landmarks,
+    generate_coarse_visgraph,
+    generate_sparse_visgraph_to_file,
+    generate_tiled_visgraph,
     generate_visgraph,
+    generate_visgraph_tile,
+    generate_visgraph_with_checkpoints,
     generate_visgraph_with_shuffled_range,
+    get_num_threads,
+    load_contraction_hierarchy_from_file,
     load_graph_from_file,
+    load_landmarks_from_file,
+    load_sparse_graph_from_file,
     merge_graphs,
+    save_contraction_hierarchy_to_file,
     save_graph_to_file,
+    save_landmarks_to_file,
+    save_sparse_graph_to_file,
+    set_num_threads,
+    simplify_polygons,
+    simplify_polygons_outwards,
+    update_visgraph,
+    visgraph_tile_ids,
 )
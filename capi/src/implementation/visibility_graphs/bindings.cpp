@@ -6,14 +6,27 @@
 // Created by James.Balajan on 30/03/2021.
 //
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
+#include <omp.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/stl.h>
 #include <pybind11/iostream.h>
 
+#include "datastructures/contraction_hierarchy/contraction_hierarchy.hpp"
 #include "datastructures/graph/graph.hpp"
+#include "datastructures/landmarks/landmarks.hpp"
+#include "datastructures/sparse_graph/sparse_graph.hpp"
+#include "geom/polygon_simplifier/polygon_simplifier.hpp"
+#include "serialization/contraction_hierarchy_serializer.hpp"
 #include "serialization/graph_serializer.hpp"
+#include "serialization/landmarks_serializer.hpp"
+#include "serialization/sparse_graph_serializer.hpp"
+#include "shortest_path/contraction_hierarchy_builder.hpp"
+#include "shortest_path/landmark_builder.hpp"
+#include "shortest_path/search_stats.hpp"
 #include "shortest_path/shortest_path_computer.hpp"
 #include "visgraph/visgraph_generator.hpp"
 #include "visgraph/vistree_generator.hpp"
@@ -23,6 +36,28 @@
 
 namespace py = pybind11;
 
+namespace {
+// Copies a flattened batch into NumPy arrays: an (N, 2) array of longitude and latitude in degrees,
+// the per-observer offsets into it and the per-vertex meridian flags
+py::tuple visible_vertex_batch_to_numpy(const VisibleVertexBatch &batch) {
+    auto coordinates = py::array_t<double>({batch.coords.size(), static_cast<size_t>(2)});
+    auto coordinates_view = coordinates.mutable_unchecked<2>();
+    for (size_t i = 0; i < batch.coords.size(); ++i) {
+        coordinates_view(i, 0) = batch.coords[i].get_longitude();
+        coordinates_view(i, 1) = batch.coords[i].get_latitude();
+    }
+
+    auto offsets = py::array_t<int64_t>(batch.offsets.size());
+    std::copy(batch.offsets.begin(), batch.offsets.end(), offsets.mutable_data());
+
+    auto is_visible_across_meridian = py::array_t<bool>(batch.is_visible_across_meridian.size());
+    std::transform(batch.is_visible_across_meridian.begin(), batch.is_visible_across_meridian.end(),
+                   is_visible_across_meridian.mutable_data(), [](uint8_t flag) { return flag != 0; });
+
+    return py::make_tuple(coordinates, offsets, is_visible_across_meridian);
+}
+} // namespace
+
 PYBIND11_MODULE(_vis_graph, m) {
     m.doc() = "CAPI visibility graphs";
 
@@ -62,54 +97,281 @@ PYBIND11_MODULE(_vis_graph, m) {
         .def_property_readonly("polygons", &Graph::get_polygons)
         .def("get_neighbors", &Graph::get_neighbors);
 
+    py::class_<SparseGraph, std::shared_ptr<SparseGraph>>(m, "VisGraphSparse")
+        .def("has_edge", &SparseGraph::has_edge)
+        .def("has_vertex", &SparseGraph::has_vertex)
+        .def("is_edge_meridian_crossing", &SparseGraph::is_edge_meridian_crossing)
+        .def_property_readonly("vertices", &SparseGraph::get_vertices)
+        .def_property_readonly("polygons", &SparseGraph::get_polygons)
+        .def_property_readonly("num_directed_edges", &SparseGraph::num_directed_edges)
+        .def("get_neighbors", &SparseGraph::get_neighbors);
+
+    py::class_<ContractionHierarchy, std::shared_ptr<ContractionHierarchy>>(m, "VisGraphContractionHierarchy")
+        .def_property_readonly("num_vertices", &ContractionHierarchy::get_num_vertices)
+        .def_property_readonly("vertices", &ContractionHierarchy::get_coordinates)
+        .def_property_readonly("num_upward_edges",
+                               [](const ContractionHierarchy &self) { return self.get_edges().size(); });
+
+    py::class_<Landmarks, std::shared_ptr<Landmarks>>(m, "VisGraphLandmarks")
+        .def_property_readonly("num_vertices", &Landmarks::get_num_vertices)
+        .def_property_readonly("num_landmarks", &Landmarks::get_num_landmarks)
+        .def_property_readonly("vertices", &Landmarks::get_coordinates)
+        .def_property_readonly("landmark_vertices", &Landmarks::get_landmark_vertices);
+
+    py::enum_<SearchAlgorithm>(m, "VisGraphSearchAlgorithm")
+        .value("A_STAR", SearchAlgorithm::A_STAR)
+        .value("BIDIRECTIONAL_A_STAR", SearchAlgorithm::BIDIRECTIONAL_A_STAR)
+        .value("CONTRACTION_HIERARCHY", SearchAlgorithm::CONTRACTION_HIERARCHY);
+
+    py::enum_<SearchHeuristic>(m, "VisGraphSearchHeuristic")
+        .value("STRAIGHT_LINE", SearchHeuristic::STRAIGHT_LINE)
+        .value("LANDMARKS", SearchHeuristic::LANDMARKS);
+
     py::class_<ShortestPathComputer>(m, "VisGraphShortestPathComputer")
         .def(py::init<const std::shared_ptr<Graph> &>())
+        .def(py::init<const std::shared_ptr<SparseGraph> &>())
+        .def(py::init<const std::shared_ptr<Graph> &, const std::shared_ptr<Graph> &, double,
+                      const std::shared_ptr<ContractionHierarchy> &, const std::shared_ptr<Landmarks> &, size_t, size_t,
+                      double>(),
+             py::arg("graph"), py::arg("coarse_graph"), py::arg("refinement_radius") = DEFAULT_REFINEMENT_RADIUS,
+             py::arg("contraction_hierarchy") = nullptr, py::arg("landmarks") = nullptr,
+             py::arg("endpoint_cache_capacity") = DEFAULT_ENDPOINT_CACHE_CAPACITY, py::arg("path_cache_capacity") = 0,
+             py::arg("path_cache_cell_size") = DEFAULT_PATH_CACHE_CELL_SIZE)
+        .def(py::init<const std::shared_ptr<SparseGraph> &, const std::shared_ptr<Graph> &, double,
+                      const std::shared_ptr<ContractionHierarchy> &, const std::shared_ptr<Landmarks> &, size_t, size_t,
+                      double>(),
+             py::arg("graph"), py::arg("coarse_graph"), py::arg("refinement_radius") = DEFAULT_REFINEMENT_RADIUS,
+             py::arg("contraction_hierarchy") = nullptr, py::arg("landmarks") = nullptr,
+             py::arg("endpoint_cache_capacity") = DEFAULT_ENDPOINT_CACHE_CAPACITY, py::arg("path_cache_capacity") = 0,
+             py::arg("path_cache_cell_size") = DEFAULT_PATH_CACHE_CELL_SIZE)
         .def(
             "shortest_path",
             [](ShortestPathComputer &self, const Coordinate &source, const Coordinate &destination,
                double maximum_distance_to_search_from_source, bool correct_vertices_on_land,
-               double a_star_greediness_weighting) {
+               double a_star_greediness_weighting, SearchAlgorithm search_algorithm, SearchHeuristic heuristic,
+               const std::shared_ptr<SearchStats> &stats) {
                 py::scoped_ostream_redirect output;
                 return self.shortest_path(source, destination, maximum_distance_to_search_from_source,
-                                          correct_vertices_on_land, a_star_greediness_weighting);
+                                          correct_vertices_on_land, a_star_greediness_weighting, search_algorithm,
+                                          heuristic, stats);
             },
             py::arg("source"), py::arg("destination"), py::arg("maximum_distance_to_search_from_source") = INFINITY,
-            py::arg("correct_vertices_on_land") = false, py::arg("a_star_greediness_weighting") = 1.0)
+            py::arg("correct_vertices_on_land") = false, py::arg("a_star_greediness_weighting") = 1.0,
+            py::arg("search_algorithm") = SearchAlgorithm::A_STAR,
+            py::arg("heuristic") = SearchHeuristic::STRAIGHT_LINE, py::arg("stats") = nullptr)
         .def(
             "shortest_paths",
             [](ShortestPathComputer &self, const std::vector<std::pair<Coordinate, Coordinate>> &source_dest_pairs,
                double maximum_distance_to_search_from_source, bool correct_vertices_on_land,
-               double a_star_greediness_weighting) {
+               double a_star_greediness_weighting, SearchAlgorithm search_algorithm, SearchHeuristic heuristic,
+               const std::shared_ptr<SearchStats> &stats) {
                 return self.shortest_paths(source_dest_pairs, maximum_distance_to_search_from_source,
-                                           correct_vertices_on_land, a_star_greediness_weighting);
+                                           correct_vertices_on_land, a_star_greediness_weighting, search_algorithm,
+                                           heuristic, stats);
             },
             py::arg("source_dest_pairs"), py::arg("maximum_distance_to_search_from_source") = INFINITY,
-            py::arg("correct_vertices_on_land") = false, py::arg("a_star_greediness_weighting") = 1.0);
+            py::arg("correct_vertices_on_land") = false, py::arg("a_star_greediness_weighting") = 1.0,
+            py::arg("search_algorithm") = SearchAlgorithm::A_STAR,
+            py::arg("heuristic") = SearchHeuristic::STRAIGHT_LINE, py::arg("stats") = nullptr)
+        .def("distance_matrix", &ShortestPathComputer::distance_matrix,
+             "Finds the shortest paths from each source to every target with one search per source",
+             py::arg("sources"), py::arg("targets"), py::arg("maximum_distance_to_search_from_source") = INFINITY,
+             py::arg("correct_vertices_on_land") = false, py::arg("include_paths") = false,
+             py::arg("stats") = nullptr, py::call_guard<py::gil_scoped_release>())
+        .def("endpoint_cache_stats", &ShortestPathComputer::endpoint_cache_stats,
+             "How often endpoints were found among those remembered from past searches")
+        .def("path_cache_stats", &ShortestPathComputer::path_cache_stats,
+             "How often searches followed a path remembered from a past search, with the cache's size in bytes");
+
+    py::class_<CacheStatsSnapshot>(m, "VisGraphCacheStatsSnapshot")
+        .def_readonly("num_hits", &CacheStatsSnapshot::num_hits)
+        .def_readonly("num_misses", &CacheStatsSnapshot::num_misses)
+        .def_readonly("num_entries", &CacheStatsSnapshot::num_entries)
+        .def_readonly("size", &CacheStatsSnapshot::size)
+        .def_readonly("capacity", &CacheStatsSnapshot::capacity)
+        .def_property_readonly("hit_rate", [](const CacheStatsSnapshot &self) {
+            const auto num_lookups = self.num_hits + self.num_misses;
+            return num_lookups == 0 ? 0.0 : static_cast<double>(self.num_hits) / static_cast<double>(num_lookups);
+        });
+
+    py::class_<SearchStatsSnapshot>(m, "VisGraphSearchStatsSnapshot")
+        .def_readonly("num_searches", &SearchStatsSnapshot::num_searches)
+        .def_readonly("num_expanded_vertices", &SearchStatsSnapshot::num_expanded_vertices)
+        .def_readonly("num_skipped_heap_entries", &SearchStatsSnapshot::num_skipped_heap_entries)
+        .def_readonly("num_relaxed_edges", &SearchStatsSnapshot::num_relaxed_edges);
+
+    py::class_<SearchStats, std::shared_ptr<SearchStats>>(m, "VisGraphSearchStats")
+        .def(py::init<>())
+        .def("snapshot", &SearchStats::snapshot,
+             "Takes a snapshot of the work done by the searches recorded so far, which is safe to do while they run");
 
     py::class_<BatchInterpolateResult>(m, "VisGraphBatchInterpolateResult")
         .def_readwrite("path", &BatchInterpolateResult::path)
         .def_readwrite("error_msg", &BatchInterpolateResult::error_msg);
 
+    py::class_<DistanceMatrix>(m, "VisGraphDistanceMatrix")
+        .def_readonly("distances", &DistanceMatrix::distances)
+        .def_readonly("paths", &DistanceMatrix::paths)
+        .def_readonly("source_error_msgs", &DistanceMatrix::source_error_msgs)
+        .def_readonly("target_error_msgs", &DistanceMatrix::target_error_msgs);
+
     py::class_<VistreeGenerator>(m, "VistreeGenerator")
         .def(py::init<const std::vector<Polygon> &>())
-        .def("get_visible_vertices", &VistreeGenerator::get_visible_vertices);
+        .def("get_visible_vertices", &VistreeGenerator::get_visible_vertices)
+        .def(
+            "get_visible_vertices_batch",
+            [](const VistreeGenerator &self, const std::vector<Coordinate> &observers, bool half_scan) {
+                auto batch = VisibleVertexBatch();
+                {
+                    py::gil_scoped_release release;
+                    batch = self.get_visible_vertices_batch(observers, half_scan);
+                }
+                return visible_vertex_batch_to_numpy(batch);
+            },
+            "Gets the visible vertices of every observer in parallel, as a tuple of an (N, 2) array of visible "
+            "vertex longitudes and latitudes, an array of offsets where observer i's vertices are rows "
+            "offsets[i] to offsets[i + 1] - 1, and an array of whether each is visible across the meridian",
+            py::arg("observers"), py::arg("half_scan") = false)
+        .def(
+            "get_visible_vertices_batch",
+            [](const VistreeGenerator &self,
+               const py::array_t<double, py::array::c_style | py::array::forcecast> &observers, bool half_scan) {
+                if (observers.ndim() != 2 || observers.shape(1) != 2) {
+                    throw std::runtime_error("Observers must be an (N, 2) array of longitudes and latitudes");
+                }
+
+                const auto observers_view = observers.unchecked<2>();
+                auto observer_coords = std::vector<Coordinate>();
+                observer_coords.reserve(observers_view.shape(0));
+                for (size_t i = 0; i < static_cast<size_t>(observers_view.shape(0)); ++i) {
+                    observer_coords.emplace_back(observers_view(i, 0), observers_view(i, 1));
+                }
+
+                auto batch = VisibleVertexBatch();
+                {
+                    py::gil_scoped_release release;
+                    batch = self.get_visible_vertices_batch(observer_coords, half_scan);
+                }
+                return visible_vertex_batch_to_numpy(batch);
+            },
+            "Gets the visible vertices of every observer in an (N, 2) array of longitudes and latitudes",
+            py::arg("observers"), py::arg("half_scan") = false);
+
+    py::class_<GenerationStatsSnapshot>(m, "VisGraphGenerationStatsSnapshot")
+        .def_readonly("num_observers", &GenerationStatsSnapshot::num_observers)
+        .def_readonly("num_completed_observers", &GenerationStatsSnapshot::num_completed_observers)
+        .def_readonly("num_emitted_edges", &GenerationStatsSnapshot::num_emitted_edges)
+        .def_readonly("thread_busy_seconds", &GenerationStatsSnapshot::thread_busy_seconds)
+        .def_readonly("elapsed_seconds", &GenerationStatsSnapshot::elapsed_seconds)
+        .def_readonly("observers_per_second", &GenerationStatsSnapshot::observers_per_second);
+
+    py::class_<GenerationStats, std::shared_ptr<GenerationStats>>(m, "VisGraphGenerationStats")
+        .def(py::init<>())
+        .def("snapshot", &GenerationStats::snapshot,
+             "Takes a snapshot of the generation's progress, which is safe to do while it runs in another thread");
 
     py::class_<VisibleVertex>(m, "VisGraphVisibleVertex")
         .def_readwrite("coord", &VisibleVertex::coord)
         .def_readwrite("is_visible_across_meridian", &VisibleVertex::is_visible_across_meridian);
 
-    m.def("generate_visgraph",
-     [](const std::vector<Polygon> &polygons) {
+    py::enum_<SimplificationMethod>(m, "VisGraphSimplificationMethod")
+        .value("DOUGLAS_PEUCKER", SimplificationMethod::DOUGLAS_PEUCKER)
+        .value("VISVALINGAM", SimplificationMethod::VISVALINGAM);
+
+    m.def("simplify_polygons", &PolygonSimplifier::simplify,
+          "Simplifies polygons without growing them, introducing self intersections or overlaps",
+          py::arg("polygons"), py::arg("method"), py::arg("tolerance_metres"));
+    m.def("simplify_polygons_outwards", &PolygonSimplifier::simplify_outwards,
+          "Simplifies polygons without shrinking them, keeping the vertices paths around them bend at",
+          py::arg("polygons"), py::arg("method"), py::arg("tolerance_metres"));
+    m.def("generate_visgraph", &VisgraphGenerator::generate,
+          "Generates a visgraph from the supplied polygons, recording progress in stats if given",
+          py::arg("polygons"), py::arg("periodic_replication_margin") = INFINITY,
+          py::arg("max_edge_length") = INFINITY, py::arg("stats") = nullptr,
+          py::call_guard<py::gil_scoped_release>());
+    m.def("generate_visgraph_with_shuffled_range", &VisgraphGenerator::generate_with_shuffled_range,
+          "Generates a visgraph from the supplied polygons using only a certain range of vertices (after shuffling)",
+          py::arg("polygons"), py::arg("range_start"), py::arg("range_end"), py::arg("seed"),
+          py::arg("periodic_replication_margin") = INFINITY, py::arg("max_edge_length") = INFINITY);
+    m.def("generate_visgraph_with_checkpoints", &VisgraphGenerator::generate_with_checkpoints,
+          "Generates a visgraph from the supplied polygons, checkpointing progress and resuming from an existing "
+          "checkpoint",
+          py::arg("polygons"), py::arg("checkpoint_path"), py::arg("periodic_replication_margin") = INFINITY,
+          py::arg("max_edge_length") = INFINITY, py::arg("checkpoint_interval") = 1000, py::arg("stats") = nullptr,
+          py::call_guard<py::gil_scoped_release>());
+    m.def("generate_sparse_visgraph_to_file", &VisgraphGenerator::generate_to_sparse_file,
+          "Generates a visgraph from the supplied polygons straight into a sparse graph file, buffering at most "
+          "memory_limit_bytes of edges in memory",
+          py::arg("polygons"), py::arg("output_path"), py::arg("memory_limit_bytes"),
+          py::arg("periodic_replication_margin") = INFINITY, py::arg("max_edge_length") = INFINITY,
+          py::arg("stats") = nullptr, py::call_guard<py::gil_scoped_release>());
+    m.def("generate_coarse_visgraph", &VisgraphGenerator::generate_coarse,
+          "Generates the coarse level of a hierarchical visgraph over polygons simplified from the detailed polygons",
+          py::arg("polygons"), py::arg("coarse_polygons"), py::arg("periodic_replication_margin") = INFINITY,
+          py::arg("max_edge_length") = INFINITY, py::arg("stats") = nullptr,
+          py::call_guard<py::gil_scoped_release>());
+    m.def("update_visgraph", &VisgraphGenerator::update,
+          "Updates a visgraph for added and removed polygons, sweeping only from the vertices affected",
+          py::arg("graph"), py::arg("added_polygons"), py::arg("removed_polygons"),
+          py::arg("periodic_replication_margin") = INFINITY, py::arg("max_edge_length") = INFINITY);
+    m.def("visgraph_tile_ids", &VisgraphGenerator::tile_ids,
+          "Lists the S2 cell ids at the given level holding polygon vertices", py::arg("polygons"),
+          py::arg("tile_level"));
+    m.def("generate_visgraph_tile", &VisgraphGenerator::generate_tile,
+          "Generates the visgraph edges from the vertices of a single tile, using only polygons within its halo",
+          py::arg("polygons"), py::arg("tile_id"), py::arg("halo"),
+          py::arg("periodic_replication_margin") = INFINITY);
+    m.def("generate_tiled_visgraph",
+        [](const std::vector<Polygon> &polygons, int tile_level, double halo, double periodic_replication_margin) {
             py::scoped_ostream_redirect output;
-            return VisgraphGenerator::generate(polygons);
+            return VisgraphGenerator::generate_tiled(polygons, tile_level, halo, periodic_replication_margin);
         },
-        "Generates a visgraph from the supplied polygons");
-    m.def("generate_visgraph_with_shuffled_range", &VisgraphGenerator::generate_with_shuffled_range,
-          "Generates a visgraph from the supplied polygons using only a certain range of vertices (after shuffling)");
+        "Generates a visgraph tile by tile and stitches the tiles together",
+        py::arg("polygons"), py::arg("tile_level"), py::arg("halo"), py::arg("periodic_replication_margin") = INFINITY);
+
+    m.def(
+        "set_num_threads", [](int num_threads) { omp_set_num_threads(num_threads); },
+        "Sets the number of threads used for graph generation and batch path queries", py::arg("num_threads"));
+    m.def(
+        "get_num_threads", []() { return omp_get_max_threads(); },
+        "Gets the number of threads used for graph generation and batch path queries");
 
     m.def("load_graph_from_file", &GraphSerializer::deserialize_from_file, "Loads serialized graph from file");
     m.def("save_graph_to_file", &GraphSerializer::serialize_to_file, "Serializes graph to file");
+    m.def("load_sparse_graph_from_file", &SparseGraphSerializer::deserialize_from_file,
+          "Loads sparse graph from file");
+    m.def("save_sparse_graph_to_file", &SparseGraphSerializer::serialize_to_file, "Serializes sparse graph to file");
     m.def("merge_graphs", &merge_graphs, "Merges graphs into one");
+    m.def(
+        "build_contraction_hierarchy",
+        [](const std::shared_ptr<Graph> &graph) { return ContractionHierarchyBuilder::build(*graph); },
+        "Builds a contraction hierarchy of a graph for SearchAlgorithm.CONTRACTION_HIERARCHY", py::arg("graph"),
+        py::call_guard<py::gil_scoped_release>());
+    m.def(
+        "build_contraction_hierarchy",
+        [](const std::shared_ptr<SparseGraph> &graph) { return ContractionHierarchyBuilder::build(*graph); },
+        "Builds a contraction hierarchy of a sparse graph for SearchAlgorithm.CONTRACTION_HIERARCHY", py::arg("graph"),
+        py::call_guard<py::gil_scoped_release>());
+    m.def("load_contraction_hierarchy_from_file", &ContractionHierarchySerializer::deserialize_from_file,
+          "Loads contraction hierarchy from file");
+    m.def("save_contraction_hierarchy_to_file", &ContractionHierarchySerializer::serialize_to_file,
+          "Serializes contraction hierarchy to file");
+    m.def(
+        "build_landmarks",
+        [](const std::shared_ptr<Graph> &graph, uint32_t num_landmarks) {
+            return LandmarkBuilder::build(*graph, num_landmarks);
+        },
+        "Picks landmarks of a graph and finds their distances to every vertex for SearchHeuristic.LANDMARKS",
+        py::arg("graph"), py::arg("num_landmarks") = DEFAULT_NUM_LANDMARKS, py::call_guard<py::gil_scoped_release>());
+    m.def(
+        "build_landmarks",
+        [](const std::shared_ptr<SparseGraph> &graph, uint32_t num_landmarks) {
+            return LandmarkBuilder::build(*graph, num_landmarks);
+        },
+        "Picks landmarks of a sparse graph and finds their distances to every vertex for SearchHeuristic.LANDMARKS",
+        py::arg("graph"), py::arg("num_landmarks") = DEFAULT_NUM_LANDMARKS, py::call_guard<py::gil_scoped_release>());
+    m.def("load_landmarks_from_file", &LandmarksSerializer::deserialize_from_file, "Loads landmarks from file");
+    m.def("save_landmarks_to_file", &LandmarksSerializer::serialize_to_file, "Serializes landmarks to file");
 
 #ifdef VERSION_INFO
     m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
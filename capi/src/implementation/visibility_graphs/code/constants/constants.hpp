@@ -5,6 +5,9 @@
 #ifndef CAPI_CONSTANTS_HPP
 #define CAPI_CONSTANTS_HPP
 
+#include <cstddef>
+#include <cstdint>
+
 static constexpr double EPSILON_TOLERANCE = 0.000001;
 static constexpr double EPSILON_TOLERANCE_SQUARED = EPSILON_TOLERANCE * EPSILON_TOLERANCE;
 
@@ -20,4 +23,23 @@ static constexpr int32_t MAX_PERIODIC_LONGITUDE_MICRODEGREES =
 static constexpr double MAX_LATITUDE = 90.0;
 static constexpr double MIN_LATITUDE = -90.0;
 
+static constexpr double EARTH_RADIUS_METRES = 6371008.8;
+
+// Radius (in degrees) around the source and destination searched on the detailed graph when routing over a coarse graph
+static constexpr double DEFAULT_REFINEMENT_RADIUS = 5.0;
+
+// Radii (in degrees) between which the coastline around a point off the graph is searched for segments enclosing it, so
+// that it can be linked to the vertices it sees without sweeping every vertex in the world
+static constexpr double MIN_ENDPOINT_ENCLOSURE_RADIUS = 0.25;
+static constexpr double MAX_ENDPOINT_ENCLOSURE_RADIUS = 16.0;
+
+// Endpoints of past searches remembered, each with the graph vertices visible from it when off the graph
+static constexpr size_t DEFAULT_ENDPOINT_CACHE_CAPACITY = 4096;
+
+// Width (in degrees) of the grid cells endpoints snap to when looking up remembered paths
+static constexpr double DEFAULT_PATH_CACHE_CELL_SIZE = 0.1;
+
+// Landmarks picked for the landmark heuristic, each costing a distance per graph vertex
+static constexpr uint32_t DEFAULT_NUM_LANDMARKS = 16;
+
 #endif // CAPI_CONSTANTS_HPP
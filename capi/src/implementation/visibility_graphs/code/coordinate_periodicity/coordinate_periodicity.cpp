@@ -2,6 +2,7 @@
 // Created by James.Balajan on 18/05/2021.
 //
 
+#include <algorithm>
 #include <cmath>
 
 #include "constants/constants.hpp"
@@ -36,29 +37,65 @@ Coordinate coordinate_from_periodic_coordinate(const Coordinate &periodic_coordi
     return Coordinate(adjusted_longitude, periodic_coordinate.get_latitude_microdegrees());
 }
 
-std::vector<Polygon> make_polygons_periodic(const std::vector<Polygon> &polygons) {
+bool is_periodic_coordinate_within_margin(const Coordinate &periodic_coordinate, double periodic_replication_margin) {
+    const auto margin_microdegrees = periodic_replication_margin * 1e6;
+    const auto longitude = static_cast<double>(periodic_coordinate.get_longitude_microdegrees());
+
+    return (longitude <= MAX_LONGITUDE_MICRODEGREES + margin_microdegrees) &&
+           (longitude >= MIN_LONGITUDE_MICRODEGREES - margin_microdegrees);
+}
+
+std::vector<Polygon> make_polygons_periodic(const std::vector<Polygon> &polygons, double periodic_replication_margin) {
     if (polygons.empty()) {
         return polygons;
     }
 
+    const auto margin_microdegrees = periodic_replication_margin * 1e6;
+
     auto periodic_polygons = std::vector<Polygon>();
     periodic_polygons.reserve(NUM_PERIODIC_VERTICES * polygons.size());
 
     for (const auto &polygon : polygons) {
+        const auto &vertices = polygon.get_vertices();
+        if (vertices.empty()) {
+            periodic_polygons.push_back(polygon);
+            continue;
+        }
+
+        const auto longitude_bounds = std::minmax_element(
+            vertices.begin(), vertices.end(), [](const Coordinate &a, const Coordinate &b) {
+                return a.get_longitude_microdegrees() < b.get_longitude_microdegrees();
+            });
+        const auto min_longitude = static_cast<double>(longitude_bounds.first->get_longitude_microdegrees());
+        const auto max_longitude = static_cast<double>(longitude_bounds.second->get_longitude_microdegrees());
+
+        // Mirrors the ordering of periodic_coordinates_from_coordinate (original, shifted east, shifted west)
+        const bool replicate_copy[NUM_PERIODIC_VERTICES] = {
+            true,
+            min_longitude + LONGITUDE_PERIOD_MICRODEGREES <= MAX_LONGITUDE_MICRODEGREES + margin_microdegrees,
+            max_longitude - LONGITUDE_PERIOD_MICRODEGREES >= MIN_LONGITUDE_MICRODEGREES - margin_microdegrees,
+        };
+
         std::vector<std::vector<Coordinate>> periodic_polygon_coordinates(NUM_PERIODIC_VERTICES);
         for (size_t i = 0; i < NUM_PERIODIC_VERTICES; ++i) {
-            periodic_polygon_coordinates[i].reserve(polygon.get_vertices().size());
+            if (replicate_copy[i]) {
+                periodic_polygon_coordinates[i].reserve(vertices.size());
+            }
         }
 
-        for (const auto &vertex : polygon.get_vertices()) {
+        for (const auto &vertex : vertices) {
             const auto periodic_vertex_coordinates = periodic_coordinates_from_coordinate(vertex);
             for (size_t i = 0; i < NUM_PERIODIC_VERTICES; ++i) {
-                periodic_polygon_coordinates[i].push_back(periodic_vertex_coordinates[i]);
+                if (replicate_copy[i]) {
+                    periodic_polygon_coordinates[i].push_back(periodic_vertex_coordinates[i]);
+                }
             }
         }
 
-        for (const auto &polygon_vertices : periodic_polygon_coordinates) {
-            periodic_polygons.emplace_back(polygon_vertices);
+        for (size_t i = 0; i < NUM_PERIODIC_VERTICES; ++i) {
+            if (replicate_copy[i]) {
+                periodic_polygons.emplace_back(periodic_polygon_coordinates[i]);
+            }
         }
     }
 
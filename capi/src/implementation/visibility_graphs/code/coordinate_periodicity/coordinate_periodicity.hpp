@@ -5,6 +5,7 @@
 #ifndef CAPI_COORDINATE_PERIODICITY_HPP
 #define CAPI_COORDINATE_PERIODICITY_HPP
 
+#include <cmath>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -16,7 +17,12 @@
 std::vector<Coordinate> periodic_coordinates_from_coordinate(const Coordinate &coordinate);
 bool is_coordinate_over_meridian(const Coordinate &coordinate);
 Coordinate coordinate_from_periodic_coordinate(const Coordinate &periodic_coordinate);
-std::vector<Polygon> make_polygons_periodic(const std::vector<Polygon> &polygons);
+bool is_periodic_coordinate_within_margin(const Coordinate &periodic_coordinate, double periodic_replication_margin);
+
+// Only polygons whose periodic copies would land within periodic_replication_margin degrees of the meridian
+// are replicated, as nothing further away can be seen across it. An infinite margin replicates every polygon.
+std::vector<Polygon> make_polygons_periodic(const std::vector<Polygon> &polygons,
+                                            double periodic_replication_margin = INFINITY);
 std::vector<Coordinate> make_coordinates_periodic(const std::vector<Coordinate> &coordinates);
 std::vector<std::shared_ptr<LineSegment>> make_segments_periodic(const std::vector<LineSegment> &segments);
 
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <fmt/core.h>
+#include <stdexcept>
+#include <utility>
+
+#include "contraction_hierarchy.hpp"
+
+ContractionHierarchy::ContractionHierarchy(std::vector<Coordinate> coordinates, std::vector<uint32_t> ranks,
+                                           std::vector<uint64_t> edge_offsets, std::vector<UpwardEdge> edges) :
+    _coordinates(std::move(coordinates)), _ranks(std::move(ranks)), _edge_offsets(std::move(edge_offsets)),
+    _edges(std::move(edges)) {
+    if (_coordinates.size() >= UINT32_MAX) {
+        throw std::runtime_error(
+            fmt::format("Contraction hierarchy has too many vertices to index: {}", _coordinates.size()));
+    }
+    if (_ranks.size() != _coordinates.size() || _edge_offsets.size() != _coordinates.size() + 1 ||
+        _edge_offsets.back() != _edges.size()) {
+        throw std::runtime_error(fmt::format("Contraction hierarchy is inconsistent: {} vertices, {} ranks, {} edge "
+                                             "offsets and {} edges",
+                                             _coordinates.size(), _ranks.size(), _edge_offsets.size(), _edges.size()));
+    }
+    for (const auto &edge : _edges) {
+        if (edge.vertex >= _coordinates.size() ||
+            (edge.middle_vertex != NO_MIDDLE_VERTEX && edge.middle_vertex >= _coordinates.size())) {
+            throw std::runtime_error(fmt::format("Contraction hierarchy has an edge to vertex {} of {}",
+                                                 std::max(edge.vertex, edge.middle_vertex), _coordinates.size()));
+        }
+    }
+}
+
+uint32_t ContractionHierarchy::get_num_vertices() const { return _coordinates.size(); }
+
+const std::vector<Coordinate> &ContractionHierarchy::get_coordinates() const { return _coordinates; }
+
+const std::vector<uint32_t> &ContractionHierarchy::get_ranks() const { return _ranks; }
+
+const std::vector<uint64_t> &ContractionHierarchy::get_edge_offsets() const { return _edge_offsets; }
+
+const std::vector<ContractionHierarchy::UpwardEdge> &ContractionHierarchy::get_edges() const { return _edges; }
+
+ContractionHierarchy::EdgeRange ContractionHierarchy::get_upward_edges(uint32_t vertex) const {
+    return {_edges.data() + _edge_offsets[vertex], _edges.data() + _edge_offsets[vertex + 1]};
+}
+
+void ContractionHierarchy::unpack_edge(uint32_t from, uint32_t to, std::vector<uint32_t> &path) const {
+    // Shortcuts can nest as deep as the hierarchy, so they are unpacked with a stack rather than recursion
+    auto pending = std::vector<std::pair<uint32_t, uint32_t>>{{from, to}};
+    while (!pending.empty()) {
+        const auto [a, b] = pending.back();
+        pending.pop_back();
+
+        const auto middle_vertex = find_edge(a, b).middle_vertex;
+        if (middle_vertex == NO_MIDDLE_VERTEX) {
+            path.push_back(b);
+        } else {
+            pending.emplace_back(middle_vertex, b);
+            pending.emplace_back(a, middle_vertex);
+        }
+    }
+}
+
+const ContractionHierarchy::UpwardEdge &ContractionHierarchy::find_edge(uint32_t a, uint32_t b) const {
+    const auto [lower, higher] = _ranks[a] < _ranks[b] ? std::make_pair(a, b) : std::make_pair(b, a);
+    const auto edges = get_upward_edges(lower);
+    const auto iter = std::lower_bound(edges.begin(), edges.end(), higher,
+                                       [](const UpwardEdge &edge, uint32_t vertex) { return edge.vertex < vertex; });
+    if (iter == edges.end() || iter->vertex != higher) {
+        throw std::runtime_error(fmt::format("Contraction hierarchy has no edge between vertices {} and {}", a, b));
+    }
+
+    return *iter;
+}
@@ -0,0 +1,63 @@
+#ifndef CAPI_CONTRACTION_HIERARCHY_HPP
+#define CAPI_CONTRACTION_HIERARCHY_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "types/coordinate/coordinate.hpp"
+
+// A graph's vertices ranked by the order they were contracted in, over the dense vertex ids of the graph (see
+// IndexedGraph). Each vertex keeps its edges to higher ranked vertices: edges of the graph, and shortcuts standing for
+// the two edges through a lower ranked vertex they skip. Every shortest path of the graph then has a counterpart of
+// the same length which only rises in rank and then only falls, so searches from either end only look upward.
+class ContractionHierarchy {
+  public:
+    static constexpr uint32_t NO_MIDDLE_VERTEX = UINT32_MAX;
+
+    struct UpwardEdge {
+        uint32_t vertex;
+        // The vertex a shortcut skips, or NO_MIDDLE_VERTEX for an edge of the graph
+        uint32_t middle_vertex;
+        double length;
+    };
+
+    class EdgeRange {
+      public:
+        EdgeRange(const UpwardEdge *begin, const UpwardEdge *end) : _begin(begin), _end(end) {}
+
+        [[nodiscard]] const UpwardEdge *begin() const { return _begin; }
+        [[nodiscard]] const UpwardEdge *end() const { return _end; }
+        [[nodiscard]] size_t size() const { return _end - _begin; }
+
+      private:
+        const UpwardEdge *_begin;
+        const UpwardEdge *_end;
+    };
+
+    // The upward edges of each vertex are sorted by the vertex they lead to
+    ContractionHierarchy(std::vector<Coordinate> coordinates, std::vector<uint32_t> ranks,
+                         std::vector<uint64_t> edge_offsets, std::vector<UpwardEdge> edges);
+
+    [[nodiscard]] uint32_t get_num_vertices() const;
+    [[nodiscard]] const std::vector<Coordinate> &get_coordinates() const;
+    [[nodiscard]] const std::vector<uint32_t> &get_ranks() const;
+    [[nodiscard]] const std::vector<uint64_t> &get_edge_offsets() const;
+    [[nodiscard]] const std::vector<UpwardEdge> &get_edges() const;
+    [[nodiscard]] EdgeRange get_upward_edges(uint32_t vertex) const;
+
+    // Appends the vertices of the graph path an edge or shortcut between two vertices stands for, after from and
+    // ending with to
+    void unpack_edge(uint32_t from, uint32_t to, std::vector<uint32_t> &path) const;
+
+  private:
+    [[nodiscard]] const UpwardEdge &find_edge(uint32_t a, uint32_t b) const;
+
+    std::vector<Coordinate> _coordinates;
+    std::vector<uint32_t> _ranks;
+
+    // The upward edges of vertex i are _edges[_edge_offsets[i]] to _edges[_edge_offsets[i + 1] - 1]
+    std::vector<uint64_t> _edge_offsets;
+    std::vector<UpwardEdge> _edges;
+};
+
+#endif // CAPI_CONTRACTION_HIERARCHY_HPP
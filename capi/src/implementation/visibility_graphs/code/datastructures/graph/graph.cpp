@@ -235,14 +235,18 @@ inline unsigned int Graph::coordinate_to_index(Coordinate coordinate) const {
 inline Coordinate Graph::index_to_coordinate(unsigned int index) const { return _index_to_coordinate_mapping[index]; }
 
 std::shared_ptr<Graph> merge_graphs(const std::vector<std::shared_ptr<Graph>> &graphs) {
-    auto polygons = std::unordered_set<Polygon>();
+    // Polygons keep the order they are first seen in, so vertex indices (and the serialized graph) are reproducible
+    auto seen_polygons = std::unordered_set<Polygon>();
+    auto polygons = std::vector<Polygon>();
     for (const auto &graph : graphs) {
         for (const auto &poly : graph->get_polygons()) {
-            polygons.insert(poly);
+            if (seen_polygons.insert(poly).second) {
+                polygons.push_back(poly);
+            }
         }
     }
 
-    auto merged_graph = std::make_shared<Graph>(std::vector<Polygon>(polygons.begin(), polygons.end()));
+    auto merged_graph = std::make_shared<Graph>(polygons);
 
     #pragma omp parallel for shared(graphs, merged_graph) default(none) schedule(static)
     for (size_t i = 0; i < graphs.size(); ++i) { // NOLINT
@@ -0,0 +1,44 @@
+#include <fmt/core.h>
+#include <stdexcept>
+
+#include "indexed_graph.hpp"
+
+IndexedGraph::IndexedGraph(const IGraph &graph) : _coordinates(graph.get_vertices()) {
+    if (_coordinates.size() >= UINT32_MAX) {
+        throw std::runtime_error(fmt::format("Graph has too many vertices to index: {}", _coordinates.size()));
+    }
+
+    _coordinate_to_vertex.reserve(_coordinates.size());
+    for (uint32_t i = 0; i < _coordinates.size(); ++i) {
+        _coordinate_to_vertex[_coordinates[i]] = i;
+    }
+
+    _neighbor_offsets.reserve(_coordinates.size() + 1);
+    _neighbor_offsets.push_back(0);
+    for (const auto &vertex : _coordinates) {
+        for (const auto &neighbor : graph.get_neighbors(vertex)) {
+            _neighbors.push_back(Neighbor{
+                .vertex = _coordinate_to_vertex.at(neighbor),
+                .is_meridian_crossing = graph.is_edge_meridian_crossing(vertex, neighbor),
+            });
+        }
+        _neighbor_offsets.push_back(_neighbors.size());
+    }
+}
+
+uint32_t IndexedGraph::get_num_vertices() const { return _coordinates.size(); }
+
+const Coordinate &IndexedGraph::get_coordinate(uint32_t vertex) const { return _coordinates[vertex]; }
+
+std::optional<uint32_t> IndexedGraph::find_vertex(const Coordinate &coordinate) const {
+    const auto iter = _coordinate_to_vertex.find(coordinate);
+    if (iter == _coordinate_to_vertex.end()) {
+        return std::nullopt;
+    }
+
+    return iter->second;
+}
+
+IndexedGraph::NeighborRange IndexedGraph::get_neighbors(uint32_t vertex) const {
+    return {_neighbors.data() + _neighbor_offsets[vertex], _neighbors.data() + _neighbor_offsets[vertex + 1]};
+}
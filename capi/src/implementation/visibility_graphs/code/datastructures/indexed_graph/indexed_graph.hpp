@@ -0,0 +1,51 @@
+#ifndef CAPI_INDEXED_GRAPH_HPP
+#define CAPI_INDEXED_GRAPH_HPP
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "datastructures/i_graph/i_graph.hpp"
+#include "types/coordinate/coordinate.hpp"
+
+// Immutable snapshot of a graph's adjacency over dense vertex ids (in the order of get_vertices()), for searches
+// that keep their state in flat arrays rather than maps keyed by coordinate. Later changes to the snapshotted graph
+// are not seen.
+class IndexedGraph {
+  public:
+    struct Neighbor {
+        uint32_t vertex;
+        bool is_meridian_crossing;
+    };
+
+    class NeighborRange {
+      public:
+        NeighborRange(const Neighbor *begin, const Neighbor *end) : _begin(begin), _end(end) {}
+
+        [[nodiscard]] const Neighbor *begin() const { return _begin; }
+        [[nodiscard]] const Neighbor *end() const { return _end; }
+        [[nodiscard]] size_t size() const { return _end - _begin; }
+
+      private:
+        const Neighbor *_begin;
+        const Neighbor *_end;
+    };
+
+    explicit IndexedGraph(const IGraph &graph);
+
+    [[nodiscard]] uint32_t get_num_vertices() const;
+    [[nodiscard]] const Coordinate &get_coordinate(uint32_t vertex) const;
+    [[nodiscard]] std::optional<uint32_t> find_vertex(const Coordinate &coordinate) const;
+    [[nodiscard]] NeighborRange get_neighbors(uint32_t vertex) const;
+
+  private:
+    std::vector<Coordinate> _coordinates;
+    std::unordered_map<Coordinate, uint32_t> _coordinate_to_vertex;
+
+    // The neighbours of vertex i are _neighbors[_neighbor_offsets[i]] to _neighbors[_neighbor_offsets[i + 1] - 1]
+    std::vector<uint64_t> _neighbor_offsets;
+    std::vector<Neighbor> _neighbors;
+};
+
+#endif // CAPI_INDEXED_GRAPH_HPP
@@ -0,0 +1,34 @@
+#include <fmt/core.h>
+#include <stdexcept>
+#include <utility>
+
+#include "landmarks.hpp"
+
+Landmarks::Landmarks(std::vector<Coordinate> coordinates, std::vector<uint32_t> landmark_vertices,
+                     std::vector<double> distances) :
+    _coordinates(std::move(coordinates)), _landmark_vertices(std::move(landmark_vertices)),
+    _distances(std::move(distances)) {
+    if (_coordinates.size() >= UINT32_MAX) {
+        throw std::runtime_error(fmt::format("Landmarks have too many vertices to index: {}", _coordinates.size()));
+    }
+    if (_distances.size() != _coordinates.size() * _landmark_vertices.size()) {
+        throw std::runtime_error(fmt::format("Landmarks are inconsistent: {} vertices, {} landmarks and {} distances",
+                                             _coordinates.size(), _landmark_vertices.size(), _distances.size()));
+    }
+    for (const auto landmark : _landmark_vertices) {
+        if (landmark >= _coordinates.size()) {
+            throw std::runtime_error(
+                fmt::format("Landmark vertex {} is not one of the {} vertices", landmark, _coordinates.size()));
+        }
+    }
+}
+
+uint32_t Landmarks::get_num_vertices() const { return _coordinates.size(); }
+
+uint32_t Landmarks::get_num_landmarks() const { return _landmark_vertices.size(); }
+
+const std::vector<Coordinate> &Landmarks::get_coordinates() const { return _coordinates; }
+
+const std::vector<uint32_t> &Landmarks::get_landmark_vertices() const { return _landmark_vertices; }
+
+const std::vector<double> &Landmarks::get_distances() const { return _distances; }
@@ -0,0 +1,32 @@
+#ifndef CAPI_LANDMARKS_HPP
+#define CAPI_LANDMARKS_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "types/coordinate/coordinate.hpp"
+
+// The shortest distances between a few landmark vertices of a graph and every vertex, over the dense vertex ids of the
+// graph (see IndexedGraph). By the triangle inequality, the distance between two vertices is at least the difference
+// of their distances from any landmark, which bounds it far more tightly than the straight line where paths have to
+// go around land.
+class Landmarks {
+  public:
+    // distances holds the distance from each landmark to vertex i at distances[i * num_landmarks] onwards, infinite
+    // where the vertex cannot be reached from the landmark
+    Landmarks(std::vector<Coordinate> coordinates, std::vector<uint32_t> landmark_vertices,
+              std::vector<double> distances);
+
+    [[nodiscard]] uint32_t get_num_vertices() const;
+    [[nodiscard]] uint32_t get_num_landmarks() const;
+    [[nodiscard]] const std::vector<Coordinate> &get_coordinates() const;
+    [[nodiscard]] const std::vector<uint32_t> &get_landmark_vertices() const;
+    [[nodiscard]] const std::vector<double> &get_distances() const;
+
+  private:
+    std::vector<Coordinate> _coordinates;
+    std::vector<uint32_t> _landmark_vertices;
+    std::vector<double> _distances;
+};
+
+#endif // CAPI_LANDMARKS_HPP
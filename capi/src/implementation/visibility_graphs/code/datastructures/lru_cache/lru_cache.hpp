@@ -0,0 +1,97 @@
+#ifndef CAPI_LRU_CACHE_HPP
+#define CAPI_LRU_CACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+struct CacheStatsSnapshot {
+    size_t num_hits;
+    size_t num_misses;
+    size_t num_entries;
+    // The total size of the entries, in the units of the capacity
+    size_t size;
+    size_t capacity;
+};
+
+// A map holding entries up to a total size of capacity, which evicts the least recently used entries to make room for
+// another. Entries have a size of 1 unless given one, such as their size in bytes. Lookups and insertions may come
+// from many threads at once. Values are shared rather than copied out, so a value found stays valid after it is
+// evicted. A capacity of 0 holds nothing.
+template <typename Key, typename Value, typename Hash = std::hash<Key>> class LruCache {
+  public:
+    explicit LruCache(size_t capacity) : _capacity(capacity) {}
+
+    [[nodiscard]] size_t get_capacity() const { return _capacity; }
+
+    // The value for a key, or null if there is none
+    [[nodiscard]] std::shared_ptr<const Value> find(const Key &key) {
+        const auto lock = std::lock_guard<std::mutex>(_mutex);
+        const auto iter = _entries.find(key);
+        if (iter == _entries.end()) {
+            ++_num_misses;
+            return nullptr;
+        }
+
+        ++_num_hits;
+        _recency.splice(_recency.begin(), _recency, iter->second);
+        return iter->second->value;
+    }
+
+    // Replaces any value the key already has. An entry larger than the capacity is not held.
+    void insert(const Key &key, std::shared_ptr<const Value> value, size_t size = 1) {
+        if (size > _capacity) {
+            return;
+        }
+
+        const auto lock = std::lock_guard<std::mutex>(_mutex);
+        const auto iter = _entries.find(key);
+        if (iter != _entries.end()) {
+            _size -= iter->second->size;
+            _recency.erase(iter->second);
+            _entries.erase(iter);
+        }
+
+        _recency.push_front(Entry{.key = key, .value = std::move(value), .size = size});
+        _entries.emplace(key, _recency.begin());
+        _size += size;
+        while (_size > _capacity) {
+            _size -= _recency.back().size;
+            _entries.erase(_recency.back().key);
+            _recency.pop_back();
+        }
+    }
+
+    [[nodiscard]] CacheStatsSnapshot snapshot() const {
+        const auto lock = std::lock_guard<std::mutex>(_mutex);
+        return CacheStatsSnapshot{
+            .num_hits = _num_hits,
+            .num_misses = _num_misses,
+            .num_entries = _entries.size(),
+            .size = _size,
+            .capacity = _capacity,
+        };
+    }
+
+  private:
+    struct Entry {
+        Key key;
+        std::shared_ptr<const Value> value;
+        size_t size;
+    };
+
+    size_t _capacity;
+    mutable std::mutex _mutex;
+    // Most recently used first
+    std::list<Entry> _recency;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> _entries;
+    size_t _size = 0;
+    size_t _num_hits = 0;
+    size_t _num_misses = 0;
+};
+
+#endif // CAPI_LRU_CACHE_HPP
@@ -4,9 +4,14 @@
 
 #include "open_edges.hpp"
 
+OpenEdges::OpenEdges(std::pmr::memory_resource *resource)
+    : _edges_sorted_by_distance(resource), _edge_to_distance_mapping(resource) {}
+
 void OpenEdges::add_edge(int64_t distance, const LineSegment &segment) {
+    remove_edge(segment);
+
     _edges_sorted_by_distance.emplace(distance, segment);
-    _edge_to_distance_mapping[segment] = distance;
+    _edge_to_distance_mapping.emplace(segment, distance);
 }
 
 void OpenEdges::remove_edge(const LineSegment &segment) {
@@ -14,16 +19,8 @@ void OpenEdges::remove_edge(const LineSegment &segment) {
         return;
     }
 
-    const auto segment_distance = _edge_to_distance_mapping.at(segment);
+    _edges_sorted_by_distance.erase({_edge_to_distance_mapping.at(segment), segment});
     _edge_to_distance_mapping.erase(segment);
-
-    const auto equal_iter = _edges_sorted_by_distance.equal_range(segment_distance);
-    for (auto iter = equal_iter.first; iter != equal_iter.second; ++iter) {
-        if (iter->second == segment) {
-            _edges_sorted_by_distance.erase(iter);
-            return;
-        }
-    }
 }
 
 LineSegment OpenEdges::closest_edge() const { return _edges_sorted_by_distance.begin()->second; }
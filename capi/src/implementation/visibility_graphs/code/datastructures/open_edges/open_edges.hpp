@@ -5,14 +5,21 @@
 #ifndef CAPI_OPEN_EDGES_HPP
 #define CAPI_OPEN_EDGES_HPP
 
-#include <map>
 #include <memory>
+#include <memory_resource>
+#include <set>
 #include <unordered_map>
+#include <utility>
 
 #include "types/line_segment/line_segment.hpp"
 
+// Edges crossing the sweep ray, ordered by distance from the observer.
+// Edges at the same distance are ordered by their endpoints rather than when they were added, so the closest edge
+// does not depend on the order edges are swept in.
 class OpenEdges {
   public:
+    explicit OpenEdges(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
     void add_edge(int64_t distance, const LineSegment &segment);
     void remove_edge(const LineSegment &segment);
 
@@ -20,8 +27,8 @@ class OpenEdges {
     [[nodiscard]] bool empty() const;
 
   private:
-    std::map<int64_t, const LineSegment> _edges_sorted_by_distance;
-    std::unordered_map<LineSegment, int64_t> _edge_to_distance_mapping;
+    std::pmr::set<std::pair<int64_t, LineSegment>> _edges_sorted_by_distance;
+    std::pmr::unordered_map<LineSegment, int64_t> _edge_to_distance_mapping;
 };
 
 #endif // CAPI_OPEN_EDGES_HPP
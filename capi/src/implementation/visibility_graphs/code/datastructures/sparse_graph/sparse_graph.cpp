@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <fmt/core.h>
+#include <stdexcept>
+#include <utility>
+
+#include "sparse_graph.hpp"
+
+SparseGraph::SparseGraph(std::vector<Polygon> polygons, std::vector<uint64_t> neighbor_offsets,
+                         std::vector<uint32_t> neighbors, std::vector<uint8_t> edge_states)
+    : _polygons(std::move(polygons)), _neighbor_offsets(std::move(neighbor_offsets)),
+      _neighbors(std::move(neighbors)), _edge_states(std::move(edge_states)) {
+    for (const auto &polygon : _polygons) {
+        for (const auto &vertex : polygon.get_vertices()) {
+            _index_to_coordinate_mapping.push_back(vertex);
+        }
+    }
+
+    _coordinate_to_index_mapping.reserve(_index_to_coordinate_mapping.size());
+    for (uint32_t i = 0; i < _index_to_coordinate_mapping.size(); ++i) {
+        _coordinate_to_index_mapping[_index_to_coordinate_mapping[i]] = i;
+    }
+
+    if (_neighbor_offsets.size() != _index_to_coordinate_mapping.size() + 1 ||
+        _neighbor_offsets.back() != _neighbors.size() || _neighbors.size() != _edge_states.size()) {
+        throw std::runtime_error("Sparse graph adjacency does not match its vertices");
+    }
+}
+
+void SparseGraph::add_edge(const Coordinate &, const Coordinate &, bool) {
+    throw std::runtime_error("Sparse graphs are read only");
+}
+
+void SparseGraph::add_directed_edge(const Coordinate &, const Coordinate &, bool) {
+    throw std::runtime_error("Sparse graphs are read only");
+}
+
+void SparseGraph::remove_edge(const Coordinate &, const Coordinate &) {
+    throw std::runtime_error("Sparse graphs are read only");
+}
+
+void SparseGraph::remove_directed_edge(const Coordinate &, const Coordinate &) {
+    throw std::runtime_error("Sparse graphs are read only");
+}
+
+void SparseGraph::add_vertex(const Coordinate &) { throw std::runtime_error("Sparse graphs are read only"); }
+
+bool SparseGraph::has_vertex(const Coordinate &vertex) const {
+    return _coordinate_to_index_mapping.find(vertex) != _coordinate_to_index_mapping.end();
+}
+
+bool SparseGraph::has_edge(const Coordinate &a, const Coordinate &b) const { return edge_state(a, b) != 0; }
+
+bool SparseGraph::is_edge_meridian_crossing(const Coordinate &a, const Coordinate &b) const {
+    return edge_state(a, b) == EdgeState::CONNECTED_OVER_MERIDIAN;
+}
+
+std::vector<Coordinate> SparseGraph::get_neighbors(const Coordinate &vertex) const {
+    const auto index = coordinate_to_index(vertex);
+
+    std::vector<Coordinate> neighbors;
+    neighbors.reserve(_neighbor_offsets[index + 1] - _neighbor_offsets[index]);
+    for (auto i = _neighbor_offsets[index]; i < _neighbor_offsets[index + 1]; ++i) {
+        neighbors.push_back(_index_to_coordinate_mapping[_neighbors[i]]);
+    }
+
+    return neighbors;
+}
+
+std::vector<Coordinate> SparseGraph::get_vertices() const { return _index_to_coordinate_mapping; }
+
+std::vector<Polygon> SparseGraph::get_polygons() const { return _polygons; }
+
+size_t SparseGraph::num_directed_edges() const { return _neighbors.size(); }
+
+const std::vector<uint64_t> &SparseGraph::get_neighbor_offsets() const { return _neighbor_offsets; }
+
+const std::vector<uint32_t> &SparseGraph::get_neighbor_indices() const { return _neighbors; }
+
+const std::vector<uint8_t> &SparseGraph::get_edge_states() const { return _edge_states; }
+
+uint32_t SparseGraph::coordinate_to_index(const Coordinate &coordinate) const {
+    const auto iter = _coordinate_to_index_mapping.find(coordinate);
+    if (iter == _coordinate_to_index_mapping.end()) {
+        throw std::runtime_error(fmt::format("Coordinate {} not in graph vertices, so an index cannot be fetched",
+                                             coordinate.to_string_representation()));
+    }
+
+    return iter->second;
+}
+
+uint8_t SparseGraph::edge_state(const Coordinate &a, const Coordinate &b) const {
+    if (a == b) {
+        return 0;
+    }
+
+    const auto a_index = coordinate_to_index(a);
+    const auto b_index = coordinate_to_index(b);
+
+    const auto begin = _neighbors.begin() + static_cast<long>(_neighbor_offsets[a_index]);
+    const auto end = _neighbors.begin() + static_cast<long>(_neighbor_offsets[a_index + 1]);
+    const auto iter = std::lower_bound(begin, end, b_index);
+    if (iter == end || *iter != b_index) {
+        return 0;
+    }
+
+    return _edge_states[iter - _neighbors.begin()];
+}
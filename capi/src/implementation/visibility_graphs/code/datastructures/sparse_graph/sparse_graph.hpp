@@ -0,0 +1,62 @@
+#ifndef CAPI_SPARSE_GRAPH_HPP
+#define CAPI_SPARSE_GRAPH_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "datastructures/i_graph/i_graph.hpp"
+#include "types/coordinate/coordinate.hpp"
+#include "types/polygon/polygon.hpp"
+
+// Read-only graph storing each vertex's neighbours contiguously (compressed sparse rows), so memory grows with
+// the number of edges rather than the square of the number of vertices. Vertices are indexed in polygon order,
+// as in Graph. Wrap it in a ModifiedGraph to add vertices or edges.
+class SparseGraph : public IGraph {
+  public:
+    enum EdgeState : uint8_t {
+        CONNECTED = 0x1,
+        CONNECTED_OVER_MERIDIAN = 0x2,
+        CONNECTED_BOTH = 0x3,
+    };
+
+    // The neighbours of vertex i are neighbors[neighbor_offsets[i]] to neighbors[neighbor_offsets[i + 1] - 1],
+    // sorted by index, with edge_states holding the matching EdgeState of each
+    SparseGraph(std::vector<Polygon> polygons, std::vector<uint64_t> neighbor_offsets, std::vector<uint32_t> neighbors,
+                std::vector<uint8_t> edge_states);
+
+    void add_edge(const Coordinate &a, const Coordinate &b, bool meridian_crossing) override;
+    void add_directed_edge(const Coordinate &a, const Coordinate &b, bool meridian_crossing) override;
+    void remove_edge(const Coordinate &a, const Coordinate &b) override;
+    void remove_directed_edge(const Coordinate &a, const Coordinate &b) override;
+    void add_vertex(const Coordinate &vertex) override;
+
+    [[nodiscard]] bool has_vertex(const Coordinate &vertex) const override;
+    [[nodiscard]] bool has_edge(const Coordinate &a, const Coordinate &b) const override;
+    [[nodiscard]] bool is_edge_meridian_crossing(const Coordinate &a, const Coordinate &b) const override;
+
+    [[nodiscard]] std::vector<Coordinate> get_neighbors(const Coordinate &vertex) const override;
+    [[nodiscard]] std::vector<Coordinate> get_vertices() const override;
+    [[nodiscard]] std::vector<Polygon> get_polygons() const override;
+
+    [[nodiscard]] size_t num_directed_edges() const;
+    [[nodiscard]] const std::vector<uint64_t> &get_neighbor_offsets() const;
+    [[nodiscard]] const std::vector<uint32_t> &get_neighbor_indices() const;
+    [[nodiscard]] const std::vector<uint8_t> &get_edge_states() const;
+
+  private:
+    [[nodiscard]] uint32_t coordinate_to_index(const Coordinate &coordinate) const;
+    // Returns the EdgeState of the edge from a to b, or 0 if they are not connected
+    [[nodiscard]] uint8_t edge_state(const Coordinate &a, const Coordinate &b) const;
+
+    std::vector<Polygon> _polygons;
+    std::vector<Coordinate> _index_to_coordinate_mapping;
+    std::unordered_map<Coordinate, uint32_t> _coordinate_to_index_mapping;
+
+    std::vector<uint64_t> _neighbor_offsets;
+    std::vector<uint32_t> _neighbors;
+    std::vector<uint8_t> _edge_states;
+};
+
+#endif // CAPI_SPARSE_GRAPH_HPP
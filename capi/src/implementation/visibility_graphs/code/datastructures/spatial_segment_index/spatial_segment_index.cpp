@@ -9,7 +9,7 @@
 #include <s2/s2crossing_edge_query.h>
 #include <iostream>
 
-SpatialSegmentIndex::SpatialSegmentIndex(const std::vector<Polygon> &polygons) {
+SpatialSegmentIndex::SpatialSegmentIndex(const std::vector<Polygon> &polygons) : _polygons(polygons) {
     for (const auto &polygon : polygons) {
         auto loop = polygon.to_s2_polygon();
         _shape_index.Add(std::make_unique<S2Polygon::OwningShape>(std::move(loop)));
@@ -32,8 +32,8 @@ std::vector<LineSegment> SpatialSegmentIndex::segments_within_distance_of_point(
             continue;
         }
 
-        const auto edge = query.GetEdge(result);
-        segments.emplace_back(Coordinate(edge.v0), Coordinate(edge.v1));
+        // Segments are returned exactly as they appear in the polygons, rather than round-tripped through S2
+        segments.push_back(polygon_segment(result.shape_id(), result.edge_id()));
     }
 
     return segments;
@@ -84,6 +84,11 @@ LineSegment SpatialSegmentIndex::s2_to_capi_line_segment(const s2shapeutil::Shap
     return LineSegment(Coordinate(edge.v0()), Coordinate(edge.v1()));
 }
 
+LineSegment SpatialSegmentIndex::polygon_segment(int shape_id, int edge_id) const {
+    const auto &vertices = _polygons[shape_id].get_vertices();
+    return LineSegment(vertices[edge_id], vertices[(edge_id + 1) % vertices.size()]);
+}
+
 bool SpatialSegmentIndex::is_point_contained(const Coordinate &point) const {
     S2ContainsPointQueryOptions options(S2VertexModel::OPEN);
     auto query = MakeS2ContainsPointQuery(&_shape_index, options);
@@ -31,7 +31,10 @@ class SpatialSegmentIndex {
 
   private:
     MutableS2ShapeIndex _shape_index;
+    std::vector<Polygon> _polygons;
+
     static LineSegment s2_to_capi_line_segment(s2shapeutil::ShapeEdge edge);
+    [[nodiscard]] LineSegment polygon_segment(int shape_id, int edge_id) const;
 };
 
 #endif // CAPI_SPATIAL_INDEX_HPP
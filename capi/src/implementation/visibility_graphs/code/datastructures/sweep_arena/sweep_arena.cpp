@@ -0,0 +1,43 @@
+#include <algorithm>
+
+#include "sweep_arena.hpp"
+
+SweepArena::SweepArena(size_t initial_capacity_bytes) { allocate_buffer(std::max<size_t>(initial_capacity_bytes, 1)); }
+
+std::pmr::memory_resource *SweepArena::resource() { return &_resource.value(); }
+
+void SweepArena::reset() {
+    // Destroying the monotonic resource returns any overflow blocks to the heap
+    _resource.reset();
+
+    if (_overflow_resource.overflow_bytes == 0) {
+        _resource.emplace(_buffer.get(), _capacity_bytes, &_overflow_resource);
+        return;
+    }
+
+    // Everything fit in the buffer plus the overflow blocks, so their combined size is always enough
+    allocate_buffer(std::max(_capacity_bytes + _overflow_resource.overflow_bytes, 2 * _capacity_bytes));
+}
+
+size_t SweepArena::get_capacity_bytes() const { return _capacity_bytes; }
+
+void SweepArena::allocate_buffer(size_t capacity_bytes) {
+    _resource.reset();
+    _buffer = std::make_unique<std::byte[]>(capacity_bytes);
+    _capacity_bytes = capacity_bytes;
+    _overflow_resource.overflow_bytes = 0;
+    _resource.emplace(_buffer.get(), _capacity_bytes, &_overflow_resource);
+}
+
+void *SweepArena::OverflowResource::do_allocate(size_t bytes, size_t alignment) {
+    overflow_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void SweepArena::OverflowResource::do_deallocate(void *p, size_t bytes, size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool SweepArena::OverflowResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
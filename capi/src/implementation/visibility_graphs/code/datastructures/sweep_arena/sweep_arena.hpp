@@ -0,0 +1,46 @@
+#ifndef CAPI_SWEEP_ARENA_HPP
+#define CAPI_SWEEP_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+// Monotonic memory backing the containers local to a single rotational sweep.
+// Deallocation is a no-op and everything is released at once by reset, so a sweep makes no general-purpose
+// allocations once the arena has grown to fit it. Not thread safe; each thread should own its own arena.
+class SweepArena {
+  public:
+    static constexpr size_t DEFAULT_CAPACITY_BYTES = 64 * 1024;
+
+    explicit SweepArena(size_t initial_capacity_bytes = DEFAULT_CAPACITY_BYTES);
+    SweepArena(const SweepArena &) = delete;
+    SweepArena &operator=(const SweepArena &) = delete;
+
+    [[nodiscard]] std::pmr::memory_resource *resource();
+    // Invalidates everything allocated since the last reset. If those allocations overflowed the buffer,
+    // it is grown so that a sweep of the same size fits without touching the heap.
+    void reset();
+    [[nodiscard]] size_t get_capacity_bytes() const;
+
+  private:
+    // Counts the bytes the arena had to request beyond its buffer
+    class OverflowResource : public std::pmr::memory_resource {
+      public:
+        size_t overflow_bytes = 0;
+
+      private:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    };
+
+    void allocate_buffer(size_t capacity_bytes);
+
+    std::unique_ptr<std::byte[]> _buffer;
+    size_t _capacity_bytes = 0;
+    OverflowResource _overflow_resource;
+    std::optional<std::pmr::monotonic_buffer_resource> _resource;
+};
+
+#endif // CAPI_SWEEP_ARENA_HPP
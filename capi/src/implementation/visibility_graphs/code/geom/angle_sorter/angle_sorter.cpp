@@ -6,8 +6,8 @@
 
 #include "angle_sorter.hpp"
 
-void AngleSorter::sort_counter_clockwise_around_observer(const Coordinate &observer,
-                                                         std::vector<Coordinate> &vertices) {
+namespace {
+template <typename Vertices> void sort_vertices_counter_clockwise(const Coordinate &observer, Vertices &vertices) {
     if (vertices.empty()) {
         return;
     }
@@ -35,3 +35,14 @@ void AngleSorter::sort_counter_clockwise_around_observer(const Coordinate &obser
 
     std::sort(vertices.begin(), vertices.end(), cmp);
 }
+} // namespace
+
+void AngleSorter::sort_counter_clockwise_around_observer(const Coordinate &observer,
+                                                         std::vector<Coordinate> &vertices) {
+    sort_vertices_counter_clockwise(observer, vertices);
+}
+
+void AngleSorter::sort_counter_clockwise_around_observer(const Coordinate &observer,
+                                                         std::pmr::vector<Coordinate> &vertices) {
+    sort_vertices_counter_clockwise(observer, vertices);
+}
@@ -6,11 +6,14 @@
 #define CAPI_ANGLE_SORTER_HPP
 
 #include "types/coordinate/coordinate.hpp"
+#include <memory_resource>
 #include <vector>
 
 class AngleSorter {
   public:
     static void sort_counter_clockwise_around_observer(const Coordinate &observer, std::vector<Coordinate> &vertices);
+    static void sort_counter_clockwise_around_observer(const Coordinate &observer,
+                                                       std::pmr::vector<Coordinate> &vertices);
 };
 
 #endif // CAPI_ANGLE_SORTER_HPP
@@ -0,0 +1,105 @@
+#include <algorithm>
+
+#include "angular_cover.hpp"
+#include "geom/exact_predicates/exact_predicates.hpp"
+
+namespace {
+// Directions are ordered by their angle counter-clockwise from a reference direction, in [0, 2π). The end of the
+// circle is ordered after every direction.
+class DirectionOrder {
+  public:
+    explicit DirectionOrder(const Coordinate &reference) : _reference(reference) {}
+
+    [[nodiscard]] bool precedes(const Coordinate &a, const Coordinate &b) const {
+        const auto a_half = half(a);
+        const auto b_half = half(b);
+        if (a_half != b_half) {
+            return a_half < b_half;
+        }
+        return a.cross_product_magnitude_microdegrees(b) > 0;
+    }
+
+  private:
+    // 0 for angles in [0, π) from the reference and 1 for [π, 2π)
+    [[nodiscard]] int half(const Coordinate &direction) const {
+        const auto cross_product = _reference.cross_product_magnitude_microdegrees(direction);
+        return cross_product > 0 || (cross_product == 0 && _reference.dot_product_microdegrees(direction) > 0) ? 0
+                                                                                                                 : 1;
+    }
+
+    Coordinate _reference;
+};
+
+// A closed range of directions, running to the end of the circle if end is empty
+struct DirectionRange {
+    Coordinate start;
+    std::optional<Coordinate> end;
+};
+
+// Whether the segments' directions cover those from the reference counter-clockwise to the target, or the whole
+// circle if the target is empty. Ranges are swept in order of their starts, so the first gap is found as a start
+// beyond everything covered so far.
+bool covers(const Coordinate &observer, const std::vector<LineSegment> &segments, const Coordinate &reference,
+            const std::optional<Coordinate> &target) {
+    const auto order = DirectionOrder(reference);
+    const auto precedes = [&](const std::optional<Coordinate> &a, const std::optional<Coordinate> &b) {
+        return a.has_value() && (!b.has_value() || order.precedes(a.value(), b.value()));
+    };
+
+    auto ranges = std::vector<DirectionRange>();
+    ranges.reserve(segments.size() + 1);
+    for (const auto &segment : segments) {
+        auto start = segment.get_endpoint_1() - observer;
+        auto end = segment.get_endpoint_2() - observer;
+        const auto cross_product = start.cross_product_magnitude_microdegrees(end);
+        if (cross_product == 0) {
+            continue;
+        }
+        if (cross_product < 0) {
+            std::swap(start, end);
+        }
+
+        // Ranges span less than π, so one starting after it ends wraps past the reference
+        if (order.precedes(end, start)) {
+            ranges.push_back(DirectionRange{.start = start, .end = std::nullopt});
+            ranges.push_back(DirectionRange{.start = reference, .end = end});
+        } else {
+            ranges.push_back(DirectionRange{.start = start, .end = end});
+        }
+    }
+    std::sort(ranges.begin(), ranges.end(),
+              [&](const DirectionRange &a, const DirectionRange &b) { return order.precedes(a.start, b.start); });
+
+    if (ranges.empty() || order.precedes(reference, ranges.front().start)) {
+        return false;
+    }
+    auto covered_to = ranges.front().end;
+    for (const auto &range : ranges) {
+        if (!precedes(covered_to, target)) {
+            return true;
+        }
+        if (precedes(covered_to, range.start)) {
+            return false;
+        }
+        if (precedes(covered_to, range.end)) {
+            covered_to = range.end;
+        }
+    }
+    return !precedes(covered_to, target);
+}
+} // namespace
+
+bool AngularCover::hides_all_directions(const Coordinate &observer, const std::vector<LineSegment> &segments) {
+    return covers(observer, segments, Coordinate(1, 0), std::nullopt);
+}
+
+bool AngularCover::hides_directions_clockwise_of(const Coordinate &observer, const std::vector<LineSegment> &segments,
+                                                 const LineSegment &edge) {
+    if (edge.orientation_of_point_to_segment(observer) == Orientation::CLOCKWISE) {
+        return hides_all_directions(observer, segments);
+    }
+
+    // Directions clockwise of the edge's run counter-clockwise from its reverse to it
+    const auto direction = edge.get_endpoint_2() - edge.get_endpoint_1();
+    return covers(observer, segments, edge.get_endpoint_1() - edge.get_endpoint_2(), direction);
+}
@@ -0,0 +1,26 @@
+#ifndef CAPI_ANGULAR_COVER_HPP
+#define CAPI_ANGULAR_COVER_HPP
+
+#include <optional>
+#include <vector>
+
+#include "types/coordinate/coordinate.hpp"
+#include "types/line_segment/line_segment.hpp"
+
+// Whether segments around an observer hide it from everything beyond them, in exact integer arithmetic. A segment
+// hides the closed range of directions between its endpoints, as a segment meeting a ray at an endpoint still hides
+// what lies beyond (see ExactPredicates::crosses_ray_before_vertex). Segments collinear with the observer hide nothing.
+class AngularCover {
+  public:
+    // Whether every direction from the observer meets one of the segments
+    [[nodiscard]] static bool hides_all_directions(const Coordinate &observer,
+                                                   const std::vector<LineSegment> &segments);
+    // Whether every direction from the observer in which a point clockwise of the line through the edge, or on it,
+    // could lie meets one of the segments. Unless the observer is itself strictly clockwise of the line, those are
+    // the directions clockwise of the edge's or along it; otherwise they are every direction.
+    [[nodiscard]] static bool hides_directions_clockwise_of(const Coordinate &observer,
+                                                            const std::vector<LineSegment> &segments,
+                                                            const LineSegment &edge);
+};
+
+#endif // CAPI_ANGULAR_COVER_HPP
@@ -0,0 +1,146 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "exact_predicates.hpp"
+
+namespace {
+using int128 = __int128;
+
+// Coordinate differences are at most 2^33 in magnitude, so are exact as doubles. Each cross product of them then
+// carries at most three roundings, which this bound (relative to the sum of the magnitudes of its terms) covers.
+constexpr double CROSS_PRODUCT_RELATIVE_ERROR = 4.0 * 0x1p-53;
+
+struct Vector {
+    int64_t x;
+    int64_t y;
+};
+
+Vector difference(const Coordinate &to, const Coordinate &from) {
+    return {to.get_longitude_microdegrees_long() - from.get_longitude_microdegrees_long(),
+            to.get_latitude_microdegrees_long() - from.get_latitude_microdegrees_long()};
+}
+
+struct FilteredCrossProduct {
+    double value;
+    double error;
+};
+
+FilteredCrossProduct filtered_cross_product(const Vector &v1, const Vector &v2) {
+    const auto term_1 = static_cast<double>(v1.x) * static_cast<double>(v2.y);
+    const auto term_2 = static_cast<double>(v1.y) * static_cast<double>(v2.x);
+    return {term_1 - term_2, (std::abs(term_1) + std::abs(term_2)) * CROSS_PRODUCT_RELATIVE_ERROR};
+}
+
+int128 exact_cross_product(const Vector &v1, const Vector &v2) {
+    return static_cast<int128>(v1.x) * v2.y - static_cast<int128>(v1.y) * v2.x;
+}
+
+// numerator / denominator rounded half away from zero, as std::round does
+int128 rounded_quotient(int128 numerator, int128 denominator) {
+    if (denominator < 0) {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+
+    if (numerator >= 0) {
+        return (2 * numerator + denominator) / (2 * denominator);
+    }
+    return -((-2 * numerator + denominator) / (2 * denominator));
+}
+} // namespace
+
+Orientation ExactPredicates::orientation(const Coordinate &start, const Coordinate &end, const Coordinate &point) {
+    const auto direction = difference(end, start);
+    const auto offset = difference(point, start);
+
+    const auto filtered = filtered_cross_product(direction, offset);
+    if (filtered.value > filtered.error) {
+        return Orientation::COUNTER_CLOCKWISE;
+    } else if (filtered.value < -filtered.error) {
+        return Orientation::CLOCKWISE;
+    }
+
+    const auto exact = exact_cross_product(direction, offset);
+    if (exact > 0) {
+        return Orientation::COUNTER_CLOCKWISE;
+    } else if (exact < 0) {
+        return Orientation::CLOCKWISE;
+    }
+    return Orientation::COLLINEAR;
+}
+
+bool ExactPredicates::crosses_ray_before_vertex(const Coordinate &edge_start, const Coordinate &edge_end,
+                                                const Coordinate &observer, const Coordinate &vertex) {
+    /*
+     * Solving edge_start + n * t = observer + (vertex - observer) * u gives t = Qt / D and u = Qu / D.
+     * The edge hides the vertex when 0 <= t <= 1 and 0 <= u < 1.
+     */
+    const auto n = difference(edge_end, edge_start);
+    const auto m = difference(observer, vertex);
+    const auto p = difference(observer, edge_start);
+
+    const auto filtered_D = filtered_cross_product(n, m);
+    if (std::abs(filtered_D.value) > filtered_D.error) {
+        const auto sign = (filtered_D.value > 0) ? 1.0 : -1.0;
+        const auto filtered_Qt = filtered_cross_product(p, m);
+        const auto filtered_Qu = filtered_cross_product(n, p);
+        const auto D = std::abs(filtered_D.value);
+        const auto Qt = sign * filtered_Qt.value;
+        const auto Qu = sign * filtered_Qu.value;
+
+        // Each condition must hold with a margin exceeding the rounding error of both sides
+        const double margins[] = {Qt, D - Qt, Qu, D - Qu};
+        const double errors[] = {filtered_Qt.error, filtered_D.error + filtered_Qt.error, filtered_Qu.error,
+                                 filtered_D.error + filtered_Qu.error};
+
+        auto all_certain = true;
+        for (size_t i = 0; i < 4; ++i) {
+            if (margins[i] < -errors[i]) {
+                return false;
+            }
+            all_certain &= margins[i] > errors[i];
+        }
+        if (all_certain) {
+            return true;
+        }
+    }
+
+    auto D = exact_cross_product(n, m);
+    if (D == 0) {
+        // Parallel, so the edge can only meet the ray at a shared endpoint
+        if (edge_start == observer || edge_start == vertex) {
+            return edge_start == observer;
+        }
+        return edge_end == observer;
+    }
+
+    auto Qt = exact_cross_product(p, m);
+    auto Qu = exact_cross_product(n, p);
+    if (D < 0) {
+        D = -D;
+        Qt = -Qt;
+        Qu = -Qu;
+    }
+
+    return Qt >= 0 && Qt <= D && Qu >= 0 && Qu < D;
+}
+
+int64_t ExactPredicates::squared_distance_to_crossing(const Coordinate &edge_start, const Coordinate &edge_end,
+                                                      const Coordinate &ray_start, const Coordinate &ray_end) {
+    const auto n = difference(edge_end, edge_start);
+    const auto direction = difference(ray_end, ray_start);
+    const auto m = Vector{-direction.x, -direction.y};
+    const auto p = difference(ray_start, edge_start);
+
+    const auto D = exact_cross_product(n, m);
+    if (D == 0) {
+        throw std::runtime_error("Cannot find the crossing of parallel lines in squared_distance_to_crossing");
+    }
+
+    // The crossing is ray_start + direction * (Qu / D)
+    const auto Qu = exact_cross_product(n, p);
+    const auto offset_x = rounded_quotient(direction.x * Qu, D);
+    const auto offset_y = rounded_quotient(direction.y * Qu, D);
+
+    return static_cast<int64_t>(offset_x * offset_x + offset_y * offset_y);
+}
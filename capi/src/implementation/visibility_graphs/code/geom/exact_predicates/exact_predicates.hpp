@@ -0,0 +1,30 @@
+#ifndef CAPI_EXACT_PREDICATES_HPP
+#define CAPI_EXACT_PREDICATES_HPP
+
+#include <cstdint>
+
+#include "types/coordinate/coordinate.hpp"
+#include "types/orientation/orientation.hpp"
+
+// Predicates on microdegree coordinates which never construct intersection points, so are exact for any
+// 32-bit coordinates. Each is first evaluated in floating point, falling back to 128-bit integer arithmetic
+// only when the rounding error could change the result.
+class ExactPredicates {
+  public:
+    // Orientation of point relative to the directed line from start to end
+    [[nodiscard]] static Orientation orientation(const Coordinate &start, const Coordinate &end,
+                                                 const Coordinate &point);
+
+    // Whether the segment from edge_start to edge_end meets the segment from observer to vertex anywhere other
+    // than at vertex itself, i.e. whether the edge hides vertex from observer.
+    // A collinear edge only hides vertex if it ends at the observer, matching intersection_with_segment.
+    [[nodiscard]] static bool crosses_ray_before_vertex(const Coordinate &edge_start, const Coordinate &edge_end,
+                                                        const Coordinate &observer, const Coordinate &vertex);
+
+    // Squared distance in microdegrees from ray_start to where the edge crosses the line through ray_start and
+    // ray_end, with the offset to the crossing rounded to whole microdegrees. The lines must not be parallel.
+    [[nodiscard]] static int64_t squared_distance_to_crossing(const Coordinate &edge_start, const Coordinate &edge_end,
+                                                              const Coordinate &ray_start, const Coordinate &ray_end);
+};
+
+#endif // CAPI_EXACT_PREDICATES_HPP
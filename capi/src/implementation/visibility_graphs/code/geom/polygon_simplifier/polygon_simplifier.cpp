@@ -0,0 +1,390 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <queue>
+#include <stack>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "constants/constants.hpp"
+#include "polygon_simplifier.hpp"
+#include "types/line_segment/line_segment.hpp"
+
+namespace {
+constexpr double METRES_PER_DEGREE = EARTH_RADIUS_METRES * M_PI / 180.0;
+
+// Uniform grid over a polygon's edges, used to find edges a replacement chord might cross
+class EdgeGrid {
+  public:
+    explicit EdgeGrid(const std::vector<Coordinate> &vertices) : _vertices(vertices) {
+        _min_longitude = _min_latitude = INT64_MAX;
+        int64_t max_longitude = INT64_MIN;
+        int64_t max_latitude = INT64_MIN;
+        for (const auto &vertex : vertices) {
+            _min_longitude = std::min(_min_longitude, vertex.get_longitude_microdegrees_long());
+            _min_latitude = std::min(_min_latitude, vertex.get_latitude_microdegrees_long());
+            max_longitude = std::max(max_longitude, vertex.get_longitude_microdegrees_long());
+            max_latitude = std::max(max_latitude, vertex.get_latitude_microdegrees_long());
+        }
+
+        const auto cells_per_axis = std::max<int64_t>(1, static_cast<int64_t>(std::sqrt(vertices.size())));
+        _cell_size = std::max<int64_t>(
+            1, std::max(max_longitude - _min_longitude, max_latitude - _min_latitude) / cells_per_axis + 1);
+        _cells_per_row = (max_latitude - _min_latitude) / _cell_size + 1;
+    }
+
+    void insert(size_t start, size_t end) {
+        for_each_cell({_vertices[start], _vertices[end]}, [&](int64_t cell) { _cells[cell].emplace_back(start, end); });
+    }
+
+    // Visits edges sharing a cell with the bounding box of the given points until the visitor returns true.
+    // Edges may be visited more than once.
+    template <typename Visitor>
+    bool any_edge_near(std::initializer_list<Coordinate> points, const Visitor &visitor) const {
+        bool found = false;
+        for_each_cell(points, [&](int64_t cell) {
+            if (found) {
+                return;
+            }
+            const auto cell_iter = _cells.find(cell);
+            if (cell_iter == _cells.end()) {
+                return;
+            }
+            for (const auto &[start, end] : cell_iter->second) {
+                if (visitor(start, end)) {
+                    found = true;
+                    return;
+                }
+            }
+        });
+        return found;
+    }
+
+  private:
+    const std::vector<Coordinate> &_vertices;
+    std::unordered_map<int64_t, std::vector<std::pair<size_t, size_t>>> _cells;
+    int64_t _min_longitude;
+    int64_t _min_latitude;
+    int64_t _cell_size;
+    int64_t _cells_per_row;
+
+    template <typename CellVisitor>
+    void for_each_cell(std::initializer_list<Coordinate> points, const CellVisitor &visitor) const {
+        int64_t min_lon = INT64_MAX;
+        int64_t max_lon = INT64_MIN;
+        int64_t min_lat = INT64_MAX;
+        int64_t max_lat = INT64_MIN;
+        for (const auto &point : points) {
+            min_lon = std::min(min_lon, point.get_longitude_microdegrees_long());
+            max_lon = std::max(max_lon, point.get_longitude_microdegrees_long());
+            min_lat = std::min(min_lat, point.get_latitude_microdegrees_long());
+            max_lat = std::max(max_lat, point.get_latitude_microdegrees_long());
+        }
+
+        for (auto x = (min_lon - _min_longitude) / _cell_size; x <= (max_lon - _min_longitude) / _cell_size; ++x) {
+            for (auto y = (min_lat - _min_latitude) / _cell_size; y <= (max_lat - _min_latitude) / _cell_size; ++y) {
+                visitor(x * _cells_per_row + y);
+            }
+        }
+    }
+};
+
+double distance_to_chord_metres(const Coordinate &point, const Coordinate &chord_start, const Coordinate &chord_end) {
+    const auto longitude_scale =
+        METRES_PER_DEGREE * std::cos((chord_start.get_latitude() + chord_end.get_latitude()) / 2 * M_PI / 180.0);
+
+    const auto chord_x = (chord_end.get_longitude() - chord_start.get_longitude()) * longitude_scale;
+    const auto chord_y = (chord_end.get_latitude() - chord_start.get_latitude()) * METRES_PER_DEGREE;
+    const auto point_x = (point.get_longitude() - chord_start.get_longitude()) * longitude_scale;
+    const auto point_y = (point.get_latitude() - chord_start.get_latitude()) * METRES_PER_DEGREE;
+
+    const auto chord_length_squared = chord_x * chord_x + chord_y * chord_y;
+    if (chord_length_squared == 0) {
+        return std::hypot(point_x, point_y);
+    }
+
+    const auto t = std::clamp((point_x * chord_x + point_y * chord_y) / chord_length_squared, 0.0, 1.0);
+    return std::hypot(point_x - t * chord_x, point_y - t * chord_y);
+}
+
+double triangle_area_metres_squared(const Coordinate &a, const Coordinate &b, const Coordinate &c) {
+    const auto longitude_scale = METRES_PER_DEGREE * std::cos(b.get_latitude() * M_PI / 180.0);
+
+    const auto ab_x = (b.get_longitude() - a.get_longitude()) * longitude_scale;
+    const auto ab_y = (b.get_latitude() - a.get_latitude()) * METRES_PER_DEGREE;
+    const auto ac_x = (c.get_longitude() - a.get_longitude()) * longitude_scale;
+    const auto ac_y = (c.get_latitude() - a.get_latitude()) * METRES_PER_DEGREE;
+
+    return std::abs(ab_x * ac_y - ab_y * ac_x) / 2;
+}
+
+// Polygons are wound counter-clockwise, so land lies to the left of every edge. Replacing a chain of vertices with
+// a chord only removes land when the whole chain lies to the right of (or on) the chord.
+bool is_on_land_side_of_chord(const Coordinate &point, const Coordinate &chord_start, const Coordinate &chord_end) {
+    return LineSegment(chord_start, chord_end).orientation_of_point_to_segment(point) != Orientation::COUNTER_CLOCKWISE;
+}
+
+bool segments_touch(const Coordinate &p1, const Coordinate &p2, const Coordinate &q1, const Coordinate &q2) {
+    const auto p = LineSegment(p1, p2);
+    const auto q = LineSegment(q1, q2);
+
+    return p.properly_intersects(q) || p.on_segment(q1) || p.on_segment(q2) || q.on_segment(p1) || q.on_segment(p2);
+}
+
+// Whether an existing edge prevents the chord from replacing the vertices between its endpoints.
+// Edges sharing an endpoint with the chord may only meet it at that endpoint.
+bool edge_blocks_chord(const std::vector<Coordinate> &vertices, size_t chord_start, size_t chord_end,
+                       size_t edge_start, size_t edge_end) {
+    const auto &chord_start_vertex = vertices[chord_start];
+    const auto &chord_end_vertex = vertices[chord_end];
+    const auto chord = LineSegment(chord_start_vertex, chord_end_vertex);
+
+    const auto shares_start = edge_start == chord_start || edge_start == chord_end;
+    const auto shares_end = edge_end == chord_start || edge_end == chord_end;
+
+    if (shares_start && shares_end) {
+        return false;
+    }
+    if (shares_start || shares_end) {
+        const auto &shared_vertex = vertices[shares_start ? edge_start : edge_end];
+        const auto &other_edge_vertex = vertices[shares_start ? edge_end : edge_start];
+        const auto &other_chord_vertex = shared_vertex == chord_start_vertex ? chord_end_vertex : chord_start_vertex;
+
+        return chord.on_segment(other_edge_vertex) ||
+               LineSegment(shared_vertex, other_edge_vertex).on_segment(other_chord_vertex);
+    }
+
+    return segments_touch(chord_start_vertex, chord_end_vertex, vertices[edge_start], vertices[edge_end]);
+}
+
+bool is_strictly_inside_triangle(const Coordinate &point, const Coordinate &a, const Coordinate &b,
+                                 const Coordinate &c) {
+    const auto o1 = LineSegment(a, b).orientation_of_point_to_segment(point);
+    const auto o2 = LineSegment(b, c).orientation_of_point_to_segment(point);
+    const auto o3 = LineSegment(c, a).orientation_of_point_to_segment(point);
+
+    return o1 != Orientation::COLLINEAR && o1 == o2 && o2 == o3;
+}
+} // namespace
+
+std::vector<Polygon> PolygonSimplifier::simplify(const std::vector<Polygon> &polygons, SimplificationMethod method,
+                                                 double tolerance_metres) {
+    std::vector<Polygon> simplified_polygons(polygons.size());
+
+#pragma omp parallel for schedule(dynamic) default(none) shared(polygons, simplified_polygons, method, tolerance_metres)
+    for (size_t i = 0; i < polygons.size(); ++i) {
+        simplified_polygons[i] = Polygon(simplify_vertices(polygons[i].get_vertices(), method, tolerance_metres));
+    }
+
+    return simplified_polygons;
+}
+
+std::vector<Polygon> PolygonSimplifier::simplify_outwards(const std::vector<Polygon> &polygons,
+                                                          SimplificationMethod method, double tolerance_metres) {
+    std::vector<Polygon> simplified_polygons(polygons.size());
+
+    // Winding the vertices clockwise swaps the land and water sides of every chord
+#pragma omp parallel for schedule(dynamic) default(none) shared(polygons, simplified_polygons, method, tolerance_metres)
+    for (size_t i = 0; i < polygons.size(); ++i) {
+        const auto &vertices = polygons[i].get_vertices();
+        const auto clockwise_vertices = std::vector<Coordinate>(vertices.rbegin(), vertices.rend());
+        simplified_polygons[i] = Polygon(simplify_vertices(clockwise_vertices, method, tolerance_metres));
+    }
+
+    return simplified_polygons;
+}
+
+std::vector<Coordinate> PolygonSimplifier::simplify_vertices(const std::vector<Coordinate> &vertices,
+                                                             SimplificationMethod method, double tolerance_metres) {
+    if (vertices.size() <= 3 || tolerance_metres <= 0) {
+        return vertices;
+    }
+
+    switch (method) {
+    case SimplificationMethod::DOUGLAS_PEUCKER:
+        return douglas_peucker(vertices, tolerance_metres);
+    case SimplificationMethod::VISVALINGAM:
+        return visvalingam(vertices, tolerance_metres);
+    default:
+        throw std::runtime_error("Unknown simplification method");
+    }
+}
+
+std::vector<Coordinate> PolygonSimplifier::douglas_peucker(const std::vector<Coordinate> &vertices,
+                                                           double tolerance_metres) {
+    const auto num_vertices = vertices.size();
+
+    EdgeGrid grid(vertices);
+    for (size_t i = 0; i < num_vertices; ++i) {
+        grid.insert(i, (i + 1) % num_vertices);
+    }
+
+    // Split the ring into two chains between the first vertex and the vertex furthest from it
+    size_t furthest_vertex = 0;
+    for (size_t i = 1; i < num_vertices; ++i) {
+        if ((vertices[i] - vertices[0]).magnitude_squared() >
+            (vertices[furthest_vertex] - vertices[0]).magnitude_squared()) {
+            furthest_vertex = i;
+        }
+    }
+    if (furthest_vertex == 0) {
+        return vertices;
+    }
+
+    std::vector<bool> keep(num_vertices, false);
+    keep[0] = keep[furthest_vertex] = true;
+
+    // Chains are index ranges [start, end] into the ring, where num_vertices wraps around to the first vertex
+    std::stack<std::pair<size_t, size_t>> chains;
+    chains.emplace(0, furthest_vertex);
+    chains.emplace(furthest_vertex, num_vertices);
+
+    while (!chains.empty()) {
+        const auto chain_start = chains.top().first;
+        const auto chain_end = chains.top().second;
+        chains.pop();
+
+        if (chain_end - chain_start < 2) {
+            continue;
+        }
+
+        const auto &chord_start = vertices[chain_start];
+        const auto &chord_end = vertices[chain_end % num_vertices];
+
+        size_t furthest_chain_vertex = chain_start + 1;
+        double furthest_distance = -1;
+        bool chain_on_land_side = true;
+        for (auto i = chain_start + 1; i < chain_end; ++i) {
+            const auto distance = distance_to_chord_metres(vertices[i], chord_start, chord_end);
+            if (distance > furthest_distance) {
+                furthest_distance = distance;
+                furthest_chain_vertex = i;
+            }
+            chain_on_land_side = chain_on_land_side && is_on_land_side_of_chord(vertices[i], chord_start, chord_end);
+        }
+
+        const auto chord_is_clear = [&]() {
+            return !grid.any_edge_near({chord_start, chord_end}, [&](size_t edge_start, size_t edge_end) {
+                const auto is_chain_edge = chain_start <= edge_start && edge_start < chain_end;
+                return !is_chain_edge &&
+                       edge_blocks_chord(vertices, chain_start, chain_end % num_vertices, edge_start, edge_end);
+            });
+        };
+
+        if (furthest_distance <= tolerance_metres && chain_on_land_side && chord_is_clear()) {
+            continue;
+        }
+
+        keep[furthest_chain_vertex] = true;
+        chains.emplace(chain_start, furthest_chain_vertex);
+        chains.emplace(furthest_chain_vertex, chain_end);
+    }
+
+    std::vector<Coordinate> simplified_vertices;
+    for (size_t i = 0; i < num_vertices; ++i) {
+        if (keep[i]) {
+            simplified_vertices.push_back(vertices[i]);
+        }
+    }
+
+    // Polygons thinner than the tolerance may collapse to a line. Leave those be.
+    return simplified_vertices.size() < 3 ? vertices : simplified_vertices;
+}
+
+std::vector<Coordinate> PolygonSimplifier::visvalingam(const std::vector<Coordinate> &vertices,
+                                                       double tolerance_metres) {
+    const auto num_vertices = vertices.size();
+    const auto max_area = tolerance_metres * tolerance_metres;
+
+    std::vector<size_t> prev(num_vertices);
+    std::vector<size_t> next(num_vertices);
+    std::vector<bool> removed(num_vertices, false);
+    std::vector<size_t> version(num_vertices, 0);
+
+    EdgeGrid grid(vertices);
+    for (size_t i = 0; i < num_vertices; ++i) {
+        prev[i] = (i + num_vertices - 1) % num_vertices;
+        next[i] = (i + 1) % num_vertices;
+        grid.insert(i, next[i]);
+    }
+
+    // Min-heap of (area, vertex, version). Entries are stale once the vertex's neighbours change.
+    using Candidate = std::tuple<double, size_t, size_t>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> candidates;
+
+    const auto consider = [&](size_t vertex) {
+        const auto &a = vertices[prev[vertex]];
+        const auto &b = vertices[vertex];
+        const auto &c = vertices[next[vertex]];
+
+        if (!is_on_land_side_of_chord(b, a, c)) {
+            return;
+        }
+
+        const auto area = triangle_area_metres_squared(a, b, c);
+        if (area <= max_area) {
+            candidates.emplace(area, vertex, version[vertex]);
+        }
+    };
+
+    const auto removal_is_clear = [&](size_t vertex) {
+        const auto a = prev[vertex];
+        const auto c = next[vertex];
+
+        return !grid.any_edge_near({vertices[a], vertices[vertex], vertices[c]}, [&](size_t edge_start, size_t edge_end) {
+            if (removed[edge_start] || next[edge_start] != edge_end || edge_start == vertex || edge_end == vertex) {
+                return false;
+            }
+
+            for (const auto endpoint : {edge_start, edge_end}) {
+                if (endpoint != a && endpoint != c &&
+                    is_strictly_inside_triangle(vertices[endpoint], vertices[a], vertices[vertex], vertices[c])) {
+                    return true;
+                }
+            }
+
+            return edge_blocks_chord(vertices, a, c, edge_start, edge_end);
+        });
+    };
+
+    for (size_t i = 0; i < num_vertices; ++i) {
+        consider(i);
+    }
+
+    auto remaining_vertices = num_vertices;
+    while (!candidates.empty() && remaining_vertices > 3) {
+        const auto [area, vertex, candidate_version] = candidates.top();
+        candidates.pop();
+
+        if (removed[vertex] || candidate_version != version[vertex] || !removal_is_clear(vertex)) {
+            continue;
+        }
+
+        const auto a = prev[vertex];
+        const auto c = next[vertex];
+
+        removed[vertex] = true;
+        next[a] = c;
+        prev[c] = a;
+        grid.insert(a, c);
+        --remaining_vertices;
+
+        ++version[a];
+        ++version[c];
+        consider(a);
+        consider(c);
+    }
+
+    std::vector<Coordinate> simplified_vertices;
+    simplified_vertices.reserve(remaining_vertices);
+    for (size_t i = 0; i < num_vertices; ++i) {
+        if (!removed[i]) {
+            simplified_vertices.push_back(vertices[i]);
+        }
+    }
+
+    return simplified_vertices;
+}
@@ -0,0 +1,41 @@
+#ifndef CAPI_POLYGON_SIMPLIFIER_HPP
+#define CAPI_POLYGON_SIMPLIFIER_HPP
+
+#include <vector>
+
+#include "types/coordinate/coordinate.hpp"
+#include "types/polygon/polygon.hpp"
+
+enum SimplificationMethod {
+    DOUGLAS_PEUCKER = 0x0,
+    VISVALINGAM = 0x1,
+};
+
+class PolygonSimplifier {
+  public:
+    // Simplification only ever removes land (polygon boundaries never move seaward), so simplified polygons lie
+    // within the originals. Vertices are only removed when the new edge crosses no other edge of the polygon,
+    // so polygons stay simple, and being within the originals they cannot come to overlap one another.
+    //
+    // Douglas-Peucker drops vertices within tolerance_metres of the chord replacing them.
+    // Visvalingam drops vertices whose triangle with their neighbours is smaller than tolerance_metres squared.
+    [[nodiscard]] static std::vector<Polygon> simplify(const std::vector<Polygon> &polygons,
+                                                       SimplificationMethod method, double tolerance_metres);
+
+    // The reverse of simplify: only water is ever added, so the simplified polygons contain the originals and keep
+    // the convex vertices that paths around them bend at. As simplified polygons may cover water, and overlap one
+    // another, they serve to choose routing vertices and must not be used to decide visibility.
+    [[nodiscard]] static std::vector<Polygon> simplify_outwards(const std::vector<Polygon> &polygons,
+                                                                SimplificationMethod method, double tolerance_metres);
+
+    // Expects counter-clockwise wound vertices, as held by Polygon
+    [[nodiscard]] static std::vector<Coordinate> simplify_vertices(const std::vector<Coordinate> &vertices,
+                                                                   SimplificationMethod method,
+                                                                   double tolerance_metres);
+
+  private:
+    static std::vector<Coordinate> douglas_peucker(const std::vector<Coordinate> &vertices, double tolerance_metres);
+    static std::vector<Coordinate> visvalingam(const std::vector<Coordinate> &vertices, double tolerance_metres);
+};
+
+#endif // CAPI_POLYGON_SIMPLIFIER_HPP
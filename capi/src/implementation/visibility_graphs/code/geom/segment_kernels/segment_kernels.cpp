@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <fmt/core.h>
+#include <stdexcept>
+
+#include "segment_kernels.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CAPI_SEGMENT_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+// Relative and absolute slack (in squared microdegrees) covering the rounding of the vectorised distance
+constexpr double DISTANCE_SQUARED_RELATIVE_SLACK = 1e-6;
+constexpr double DISTANCE_SQUARED_ABSOLUTE_SLACK = 1.0;
+
+double distance_squared_threshold(double max_distance) {
+    const auto max_distance_microdegrees = max_distance * 1e6;
+    return max_distance_microdegrees * max_distance_microdegrees * (1 + DISTANCE_SQUARED_RELATIVE_SLACK) +
+           DISTANCE_SQUARED_ABSOLUTE_SLACK;
+}
+
+void segments_crossing_ray_scalar(const SegmentBlock &block, size_t begin, const Coordinate &ray_start,
+                                  const Coordinate &ray_end, uint8_t *hits) {
+    const auto ox = ray_start.get_longitude_microdegrees_long();
+    const auto oy = ray_start.get_latitude_microdegrees_long();
+    const auto dx = ray_end.get_longitude_microdegrees_long() - ox;
+    const auto dy = ray_end.get_latitude_microdegrees_long() - oy;
+
+    for (size_t i = begin; i < block.size(); ++i) {
+        const auto pax = block.endpoint_1_longitudes[i] - ox;
+        const auto pay = block.endpoint_1_latitudes[i] - oy;
+        const auto pbx = block.endpoint_2_longitudes[i] - ox;
+        const auto pby = block.endpoint_2_latitudes[i] - oy;
+
+        // Sides of the ray's line each endpoint lies on, and the crossing as a fraction num / den along the ray
+        const auto side_a = dx * pay - dy * pax;
+        const auto side_b = dx * pby - dy * pbx;
+        const auto num = pax * pby - pay * pbx;
+        const auto den = side_b - side_a;
+
+        const auto crosses_upwards = side_a < 0 && side_b > 0 && num >= 0 && num <= den;
+        const auto crosses_downwards = side_a > 0 && side_b < 0 && num <= 0 && num >= den;
+        hits[i] = (crosses_upwards || crosses_downwards) ? 1 : 0;
+    }
+}
+
+void segments_possibly_within_distance_scalar(const SegmentBlock &block, size_t begin, const Coordinate &point,
+                                              double max_distance, uint8_t *hits) {
+    const auto px = static_cast<double>(point.get_longitude_microdegrees());
+    const auto py = static_cast<double>(point.get_latitude_microdegrees());
+    const auto threshold = distance_squared_threshold(max_distance);
+
+    for (size_t i = begin; i < block.size(); ++i) {
+        const auto ax = static_cast<double>(block.endpoint_1_longitudes[i]);
+        const auto ay = static_cast<double>(block.endpoint_1_latitudes[i]);
+        const auto tx = static_cast<double>(block.endpoint_2_longitudes[i]) - ax;
+        const auto ty = static_cast<double>(block.endpoint_2_latitudes[i]) - ay;
+
+        const auto length_squared = tx * tx + ty * ty;
+        const auto t =
+            (length_squared == 0) ? 0.0 : std::clamp(((px - ax) * tx + (py - ay) * ty) / length_squared, 0.0, 1.0);
+        const auto ex = px - (ax + t * tx);
+        const auto ey = py - (ay + t * ty);
+
+        hits[i] = (ex * ex + ey * ey <= threshold) ? 1 : 0;
+    }
+}
+
+#ifdef CAPI_SEGMENT_KERNELS_X86
+// Loads consecutive 32-bit values from a block column, widened to one per lane
+__attribute__((target("avx2"))) inline __m256i load_epi64_avx2(const std::pmr::vector<int32_t> &values, size_t i) {
+    return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values.data() + i)));
+}
+
+__attribute__((target("avx2"))) inline __m256d load_pd_avx2(const std::pmr::vector<int32_t> &values, size_t i) {
+    return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values.data() + i)));
+}
+
+__attribute__((target("avx512f"))) inline __m512i load_epi64_avx512(const std::pmr::vector<int32_t> &values,
+                                                                     size_t i) {
+    return _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values.data() + i)));
+}
+
+__attribute__((target("avx512f"))) inline __m512d load_pd_avx512(const std::pmr::vector<int32_t> &values, size_t i) {
+    return _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values.data() + i)));
+}
+
+__attribute__((target("avx2"))) void segments_crossing_ray_avx2(const SegmentBlock &block,
+                                                                 const Coordinate &ray_start,
+                                                                 const Coordinate &ray_end, uint8_t *hits) {
+    const auto ox = ray_start.get_longitude_microdegrees_long();
+    const auto oy = ray_start.get_latitude_microdegrees_long();
+    const auto ox_v = _mm256_set1_epi64x(ox);
+    const auto oy_v = _mm256_set1_epi64x(oy);
+    const auto dx_v = _mm256_set1_epi64x(ray_end.get_longitude_microdegrees_long() - ox);
+    const auto dy_v = _mm256_set1_epi64x(ray_end.get_latitude_microdegrees_long() - oy);
+    const auto zero = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 4 <= block.size(); i += 4) {
+        // Differences fit in the low 32 bits of each lane, which is all _mm256_mul_epi32 reads
+        const auto pax = _mm256_sub_epi64(load_epi64_avx2(block.endpoint_1_longitudes, i), ox_v);
+        const auto pay = _mm256_sub_epi64(load_epi64_avx2(block.endpoint_1_latitudes, i), oy_v);
+        const auto pbx = _mm256_sub_epi64(load_epi64_avx2(block.endpoint_2_longitudes, i), ox_v);
+        const auto pby = _mm256_sub_epi64(load_epi64_avx2(block.endpoint_2_latitudes, i), oy_v);
+
+        const auto side_a = _mm256_sub_epi64(_mm256_mul_epi32(dx_v, pay), _mm256_mul_epi32(dy_v, pax));
+        const auto side_b = _mm256_sub_epi64(_mm256_mul_epi32(dx_v, pby), _mm256_mul_epi32(dy_v, pbx));
+        const auto num = _mm256_sub_epi64(_mm256_mul_epi32(pax, pby), _mm256_mul_epi32(pay, pbx));
+        const auto den = _mm256_sub_epi64(side_b, side_a);
+
+        const auto crosses_upwards = _mm256_andnot_si256(
+            _mm256_or_si256(_mm256_cmpgt_epi64(zero, num), _mm256_cmpgt_epi64(num, den)),
+            _mm256_and_si256(_mm256_cmpgt_epi64(zero, side_a), _mm256_cmpgt_epi64(side_b, zero)));
+        const auto crosses_downwards = _mm256_andnot_si256(
+            _mm256_or_si256(_mm256_cmpgt_epi64(num, zero), _mm256_cmpgt_epi64(den, num)),
+            _mm256_and_si256(_mm256_cmpgt_epi64(side_a, zero), _mm256_cmpgt_epi64(zero, side_b)));
+
+        const auto mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_or_si256(crosses_upwards, crosses_downwards)));
+        for (size_t lane = 0; lane < 4; ++lane) {
+            hits[i + lane] = (mask >> lane) & 1;
+        }
+    }
+
+    segments_crossing_ray_scalar(block, i, ray_start, ray_end, hits);
+}
+
+__attribute__((target("avx2"))) void segments_possibly_within_distance_avx2(const SegmentBlock &block,
+                                                                             const Coordinate &point,
+                                                                             double max_distance, uint8_t *hits) {
+    const auto px = _mm256_set1_pd(point.get_longitude_microdegrees());
+    const auto py = _mm256_set1_pd(point.get_latitude_microdegrees());
+    const auto threshold = _mm256_set1_pd(distance_squared_threshold(max_distance));
+    const auto zero = _mm256_setzero_pd();
+    const auto one = _mm256_set1_pd(1.0);
+
+    size_t i = 0;
+    for (; i + 4 <= block.size(); i += 4) {
+        const auto ax = load_pd_avx2(block.endpoint_1_longitudes, i);
+        const auto ay = load_pd_avx2(block.endpoint_1_latitudes, i);
+        const auto tx = _mm256_sub_pd(load_pd_avx2(block.endpoint_2_longitudes, i), ax);
+        const auto ty = _mm256_sub_pd(load_pd_avx2(block.endpoint_2_latitudes, i), ay);
+
+        const auto length_squared = _mm256_add_pd(_mm256_mul_pd(tx, tx), _mm256_mul_pd(ty, ty));
+        const auto projection = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(px, ax), tx),
+                                              _mm256_mul_pd(_mm256_sub_pd(py, ay), ty));
+        const auto degenerate = _mm256_cmp_pd(length_squared, zero, _CMP_EQ_OQ);
+        const auto t = _mm256_blendv_pd(
+            _mm256_max_pd(zero, _mm256_min_pd(one, _mm256_div_pd(projection, length_squared))), zero, degenerate);
+
+        const auto ex = _mm256_sub_pd(px, _mm256_add_pd(ax, _mm256_mul_pd(t, tx)));
+        const auto ey = _mm256_sub_pd(py, _mm256_add_pd(ay, _mm256_mul_pd(t, ty)));
+        const auto distance_squared = _mm256_add_pd(_mm256_mul_pd(ex, ex), _mm256_mul_pd(ey, ey));
+
+        const auto mask = _mm256_movemask_pd(_mm256_cmp_pd(distance_squared, threshold, _CMP_LE_OQ));
+        for (size_t lane = 0; lane < 4; ++lane) {
+            hits[i + lane] = (mask >> lane) & 1;
+        }
+    }
+
+    segments_possibly_within_distance_scalar(block, i, point, max_distance, hits);
+}
+
+__attribute__((target("avx512f"))) void segments_crossing_ray_avx512(const SegmentBlock &block,
+                                                                      const Coordinate &ray_start,
+                                                                      const Coordinate &ray_end, uint8_t *hits) {
+    const auto ox = ray_start.get_longitude_microdegrees_long();
+    const auto oy = ray_start.get_latitude_microdegrees_long();
+    const auto ox_v = _mm512_set1_epi64(ox);
+    const auto oy_v = _mm512_set1_epi64(oy);
+    const auto dx_v = _mm512_set1_epi64(ray_end.get_longitude_microdegrees_long() - ox);
+    const auto dy_v = _mm512_set1_epi64(ray_end.get_latitude_microdegrees_long() - oy);
+    const auto zero = _mm512_setzero_si512();
+
+    size_t i = 0;
+    for (; i + 8 <= block.size(); i += 8) {
+        const auto pax = _mm512_sub_epi64(load_epi64_avx512(block.endpoint_1_longitudes, i), ox_v);
+        const auto pay = _mm512_sub_epi64(load_epi64_avx512(block.endpoint_1_latitudes, i), oy_v);
+        const auto pbx = _mm512_sub_epi64(load_epi64_avx512(block.endpoint_2_longitudes, i), ox_v);
+        const auto pby = _mm512_sub_epi64(load_epi64_avx512(block.endpoint_2_latitudes, i), oy_v);
+
+        const auto side_a = _mm512_sub_epi64(_mm512_mul_epi32(dx_v, pay), _mm512_mul_epi32(dy_v, pax));
+        const auto side_b = _mm512_sub_epi64(_mm512_mul_epi32(dx_v, pby), _mm512_mul_epi32(dy_v, pbx));
+        const auto num = _mm512_sub_epi64(_mm512_mul_epi32(pax, pby), _mm512_mul_epi32(pay, pbx));
+        const auto den = _mm512_sub_epi64(side_b, side_a);
+
+        const __mmask8 crosses_upwards = _mm512_cmplt_epi64_mask(side_a, zero) &
+                                         _mm512_cmpgt_epi64_mask(side_b, zero) &
+                                         _mm512_cmpge_epi64_mask(num, zero) & _mm512_cmple_epi64_mask(num, den);
+        const __mmask8 crosses_downwards = _mm512_cmpgt_epi64_mask(side_a, zero) &
+                                           _mm512_cmplt_epi64_mask(side_b, zero) &
+                                           _mm512_cmple_epi64_mask(num, zero) & _mm512_cmpge_epi64_mask(num, den);
+
+        const auto mask = static_cast<unsigned>(crosses_upwards | crosses_downwards);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            hits[i + lane] = (mask >> lane) & 1;
+        }
+    }
+
+    segments_crossing_ray_scalar(block, i, ray_start, ray_end, hits);
+}
+
+__attribute__((target("avx512f"))) void segments_possibly_within_distance_avx512(const SegmentBlock &block,
+                                                                                  const Coordinate &point,
+                                                                                  double max_distance,
+                                                                                  uint8_t *hits) {
+    const auto px = _mm512_set1_pd(point.get_longitude_microdegrees());
+    const auto py = _mm512_set1_pd(point.get_latitude_microdegrees());
+    const auto threshold = _mm512_set1_pd(distance_squared_threshold(max_distance));
+    const auto zero = _mm512_setzero_pd();
+    const auto one = _mm512_set1_pd(1.0);
+
+    size_t i = 0;
+    for (; i + 8 <= block.size(); i += 8) {
+        const auto ax = load_pd_avx512(block.endpoint_1_longitudes, i);
+        const auto ay = load_pd_avx512(block.endpoint_1_latitudes, i);
+        const auto tx = _mm512_sub_pd(load_pd_avx512(block.endpoint_2_longitudes, i), ax);
+        const auto ty = _mm512_sub_pd(load_pd_avx512(block.endpoint_2_latitudes, i), ay);
+
+        const auto length_squared = _mm512_add_pd(_mm512_mul_pd(tx, tx), _mm512_mul_pd(ty, ty));
+        const auto projection = _mm512_add_pd(_mm512_mul_pd(_mm512_sub_pd(px, ax), tx),
+                                              _mm512_mul_pd(_mm512_sub_pd(py, ay), ty));
+        const auto degenerate = _mm512_cmp_pd_mask(length_squared, zero, _CMP_EQ_OQ);
+        const auto t = _mm512_mask_blend_pd(
+            degenerate, _mm512_max_pd(zero, _mm512_min_pd(one, _mm512_div_pd(projection, length_squared))), zero);
+
+        const auto ex = _mm512_sub_pd(px, _mm512_add_pd(ax, _mm512_mul_pd(t, tx)));
+        const auto ey = _mm512_sub_pd(py, _mm512_add_pd(ay, _mm512_mul_pd(t, ty)));
+        const auto distance_squared = _mm512_add_pd(_mm512_mul_pd(ex, ex), _mm512_mul_pd(ey, ey));
+
+        const auto mask = static_cast<unsigned>(_mm512_cmp_pd_mask(distance_squared, threshold, _CMP_LE_OQ));
+        for (size_t lane = 0; lane < 8; ++lane) {
+            hits[i + lane] = (mask >> lane) & 1;
+        }
+    }
+
+    segments_possibly_within_distance_scalar(block, i, point, max_distance, hits);
+}
+#endif
+} // namespace
+
+SegmentBlock::SegmentBlock(std::pmr::memory_resource *resource)
+    : endpoint_1_longitudes(resource), endpoint_1_latitudes(resource), endpoint_2_longitudes(resource),
+      endpoint_2_latitudes(resource) {}
+
+void SegmentBlock::push_back(const LineSegment &segment) {
+    const auto endpoint_1 = segment.get_endpoint_1();
+    const auto endpoint_2 = segment.get_endpoint_2();
+
+    endpoint_1_longitudes.push_back(endpoint_1.get_longitude_microdegrees());
+    endpoint_1_latitudes.push_back(endpoint_1.get_latitude_microdegrees());
+    endpoint_2_longitudes.push_back(endpoint_2.get_longitude_microdegrees());
+    endpoint_2_latitudes.push_back(endpoint_2.get_latitude_microdegrees());
+}
+
+void SegmentBlock::reserve(size_t num_segments) {
+    endpoint_1_longitudes.reserve(num_segments);
+    endpoint_1_latitudes.reserve(num_segments);
+    endpoint_2_longitudes.reserve(num_segments);
+    endpoint_2_latitudes.reserve(num_segments);
+}
+
+void SegmentBlock::clear() {
+    endpoint_1_longitudes.clear();
+    endpoint_1_latitudes.clear();
+    endpoint_2_longitudes.clear();
+    endpoint_2_latitudes.clear();
+}
+
+size_t SegmentBlock::size() const { return endpoint_1_longitudes.size(); }
+
+void SegmentKernels::segments_crossing_ray(const SegmentBlock &block, const Coordinate &ray_start,
+                                           const Coordinate &ray_end, uint8_t *hits) {
+    segments_crossing_ray(block, ray_start, ray_end, hits, best_instruction_set());
+}
+
+void SegmentKernels::segments_crossing_ray(const SegmentBlock &block, const Coordinate &ray_start,
+                                           const Coordinate &ray_end, uint8_t *hits,
+                                           InstructionSet instruction_set) {
+    if (!is_supported(instruction_set)) {
+        throw std::runtime_error(
+            fmt::format("Instruction set {} is not supported by this CPU", static_cast<int>(instruction_set)));
+    }
+
+#ifdef CAPI_SEGMENT_KERNELS_X86
+    if (instruction_set == InstructionSet::AVX512) {
+        return segments_crossing_ray_avx512(block, ray_start, ray_end, hits);
+    } else if (instruction_set == InstructionSet::AVX2) {
+        return segments_crossing_ray_avx2(block, ray_start, ray_end, hits);
+    }
+#endif
+
+    segments_crossing_ray_scalar(block, 0, ray_start, ray_end, hits);
+}
+
+void SegmentKernels::segments_possibly_within_distance(const SegmentBlock &block, const Coordinate &point,
+                                                       double max_distance, uint8_t *hits) {
+    segments_possibly_within_distance(block, point, max_distance, hits, best_instruction_set());
+}
+
+void SegmentKernels::segments_possibly_within_distance(const SegmentBlock &block, const Coordinate &point,
+                                                       double max_distance, uint8_t *hits,
+                                                       InstructionSet instruction_set) {
+    if (!is_supported(instruction_set)) {
+        throw std::runtime_error(
+            fmt::format("Instruction set {} is not supported by this CPU", static_cast<int>(instruction_set)));
+    }
+
+#ifdef CAPI_SEGMENT_KERNELS_X86
+    if (instruction_set == InstructionSet::AVX512) {
+        return segments_possibly_within_distance_avx512(block, point, max_distance, hits);
+    } else if (instruction_set == InstructionSet::AVX2) {
+        return segments_possibly_within_distance_avx2(block, point, max_distance, hits);
+    }
+#endif
+
+    segments_possibly_within_distance_scalar(block, 0, point, max_distance, hits);
+}
+
+InstructionSet SegmentKernels::best_instruction_set() {
+    static const auto best = []() {
+        if (is_supported(InstructionSet::AVX512)) {
+            return InstructionSet::AVX512;
+        } else if (is_supported(InstructionSet::AVX2)) {
+            return InstructionSet::AVX2;
+        }
+        return InstructionSet::SCALAR;
+    }();
+
+    return best;
+}
+
+bool SegmentKernels::is_supported(InstructionSet instruction_set) {
+    switch (instruction_set) {
+    case InstructionSet::SCALAR:
+        return true;
+#ifdef CAPI_SEGMENT_KERNELS_X86
+    case InstructionSet::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case InstructionSet::AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
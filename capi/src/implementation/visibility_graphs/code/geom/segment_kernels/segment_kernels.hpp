@@ -0,0 +1,59 @@
+#ifndef CAPI_SEGMENT_KERNELS_HPP
+#define CAPI_SEGMENT_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "types/coordinate/coordinate.hpp"
+#include "types/line_segment/line_segment.hpp"
+
+enum InstructionSet {
+    SCALAR = 0x0,
+    AVX2 = 0x1,
+    AVX512 = 0x2,
+};
+
+// Segment endpoints laid out as a structure of arrays, so that kernels can load several segments at once
+class SegmentBlock {
+  public:
+    explicit SegmentBlock(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    void push_back(const LineSegment &segment);
+    void reserve(size_t num_segments);
+    void clear();
+    [[nodiscard]] size_t size() const;
+
+    std::pmr::vector<int32_t> endpoint_1_longitudes;
+    std::pmr::vector<int32_t> endpoint_1_latitudes;
+    std::pmr::vector<int32_t> endpoint_2_longitudes;
+    std::pmr::vector<int32_t> endpoint_2_latitudes;
+};
+
+// Tests one ray against every segment of a block, using the widest instruction set the CPU supports.
+// The integer kernels are exact provided the differences between coordinates fit in 32 bits,
+// which holds for every periodic coordinate.
+class SegmentKernels {
+  public:
+    // Sets hits[i] to 1 if segment i has its endpoints strictly either side of the line through ray_start and
+    // ray_end, and crosses it between them (inclusive), otherwise 0. This is exactly when
+    // intersection_with_segment finds an intersection and neither endpoint of segment i lies on the ray.
+    static void segments_crossing_ray(const SegmentBlock &block, const Coordinate &ray_start,
+                                      const Coordinate &ray_end, uint8_t *hits);
+    static void segments_crossing_ray(const SegmentBlock &block, const Coordinate &ray_start,
+                                      const Coordinate &ray_end, uint8_t *hits, InstructionSet instruction_set);
+
+    // Sets hits[i] to 1 if segment i may be within max_distance degrees of point, otherwise 0.
+    // The test is conservative, so hits should be confirmed with LineSegment::distance_to_point.
+    static void segments_possibly_within_distance(const SegmentBlock &block, const Coordinate &point,
+                                                  double max_distance, uint8_t *hits);
+    static void segments_possibly_within_distance(const SegmentBlock &block, const Coordinate &point,
+                                                  double max_distance, uint8_t *hits,
+                                                  InstructionSet instruction_set);
+
+    [[nodiscard]] static InstructionSet best_instruction_set();
+    [[nodiscard]] static bool is_supported(InstructionSet instruction_set);
+};
+
+#endif // CAPI_SEGMENT_KERNELS_HPP
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <omp.h>
+#include <optional>
+#include <vector>
+
+#include "work_stealing_scheduler.hpp"
+
+namespace {
+struct TaskBatch {
+    size_t start;
+    size_t end;
+};
+
+struct WorkQueue {
+    std::deque<TaskBatch> batches;
+    std::mutex lock;
+
+    std::optional<TaskBatch> pop_front() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (batches.empty()) {
+            return std::nullopt;
+        }
+
+        const auto batch = batches.front();
+        batches.pop_front();
+        return batch;
+    }
+
+    std::optional<TaskBatch> steal_back() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (batches.empty()) {
+            return std::nullopt;
+        }
+
+        const auto batch = batches.back();
+        batches.pop_back();
+        return batch;
+    }
+};
+} // namespace
+
+WorkStealingScheduler::WorkStealingScheduler(size_t num_threads)
+    : _num_threads(num_threads == 0 ? static_cast<size_t>(omp_get_max_threads()) : num_threads) {}
+
+void WorkStealingScheduler::run(size_t num_tasks, size_t batch_size,
+                                const std::function<void(size_t, size_t)> &task) const {
+    if (num_tasks == 0) {
+        return;
+    }
+
+    batch_size = std::max<size_t>(batch_size, 1);
+    const auto num_batches = (num_tasks + batch_size - 1) / batch_size;
+    const auto num_threads = std::min(_num_threads, num_batches);
+
+    auto queues = std::vector<WorkQueue>(num_threads);
+    for (size_t i = 0; i < num_batches; ++i) {
+        queues[i * num_threads / num_batches].batches.push_back(
+            TaskBatch{.start = i * batch_size, .end = std::min((i + 1) * batch_size, num_tasks)});
+    }
+
+    std::atomic<bool> failed = false;
+    std::exception_ptr first_exception = nullptr;
+    std::mutex exception_lock;
+
+#pragma omp parallel num_threads(num_threads) shared(queues, task, failed, first_exception, exception_lock, num_threads) \
+    default(none)
+    {
+        const auto thread_num = static_cast<size_t>(omp_get_thread_num());
+
+        while (!failed) {
+            auto batch = queues[thread_num].pop_front();
+            for (size_t i = 1; !batch.has_value() && i < num_threads; ++i) {
+                batch = queues[(thread_num + i) % num_threads].steal_back();
+            }
+            if (!batch.has_value()) {
+                break;
+            }
+
+            for (auto task_num = batch->start; task_num < batch->end && !failed; ++task_num) {
+                try {
+                    task(task_num, thread_num);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(exception_lock);
+                    if (first_exception == nullptr) {
+                        first_exception = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+        }
+    }
+
+    if (first_exception != nullptr) {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+size_t WorkStealingScheduler::get_num_threads() const { return _num_threads; }
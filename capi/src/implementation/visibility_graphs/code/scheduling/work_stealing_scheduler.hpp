@@ -0,0 +1,25 @@
+#ifndef CAPI_WORK_STEALING_SCHEDULER_HPP
+#define CAPI_WORK_STEALING_SCHEDULER_HPP
+
+#include <cstddef>
+#include <functional>
+
+class WorkStealingScheduler {
+  public:
+    // num_threads of 0 uses OpenMP's default number of threads
+    explicit WorkStealingScheduler(size_t num_threads = 0);
+
+    // Runs task(task_num, thread_num) for every task_num in [0, num_tasks).
+    // Tasks are grouped into batches of batch_size consecutive task numbers, and each thread starts with a
+    // contiguous run of batches, so tasks ordered by locality are run together. Threads which run out of work
+    // steal batches from the back of other threads' queues.
+    // The first exception thrown by a task stops the remaining tasks and is rethrown.
+    void run(size_t num_tasks, size_t batch_size, const std::function<void(size_t, size_t)> &task) const;
+
+    [[nodiscard]] size_t get_num_threads() const;
+
+  private:
+    size_t _num_threads;
+};
+
+#endif // CAPI_WORK_STEALING_SCHEDULER_HPP
@@ -0,0 +1,110 @@
+#include <cstring>
+#include <fmt/core.h>
+#include <fstream>
+#include <stdexcept>
+
+#include "contraction_hierarchy_serializer.hpp"
+
+namespace {
+constexpr char CONTRACTION_HIERARCHY_MAGIC[] = {'C', 'A', 'P', 'I', 'C', 'H', 'R', 'C'};
+constexpr uint32_t CONTRACTION_HIERARCHY_VERSION = 1;
+
+template <typename T> void write_value(std::ostream &out, T val) {
+    out.write(reinterpret_cast<const char *>(&val), sizeof(T));
+}
+
+template <typename T> void write_values(std::ostream &out, const std::vector<T> &values) {
+    out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T> T read_value(std::istream &in, const std::string &path) {
+    T val;
+    if (!in.read(reinterpret_cast<char *>(&val), sizeof(T))) {
+        throw std::runtime_error(fmt::format("Contraction hierarchy file {} is truncated", path));
+    }
+    return val;
+}
+
+template <typename T> std::vector<T> read_values(std::istream &in, size_t num_values, const std::string &path) {
+    auto values = std::vector<T>(num_values);
+    if (!in.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(num_values * sizeof(T)))) {
+        throw std::runtime_error(fmt::format("Contraction hierarchy file {} is truncated", path));
+    }
+    return values;
+}
+} // namespace
+
+void ContractionHierarchySerializer::serialize_to_file(const std::shared_ptr<ContractionHierarchy> &hierarchy,
+                                                       const std::string &path) {
+    auto out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error(fmt::format("Could not open contraction hierarchy file {}", path));
+    }
+
+    out.write(CONTRACTION_HIERARCHY_MAGIC, sizeof(CONTRACTION_HIERARCHY_MAGIC));
+    write_value(out, CONTRACTION_HIERARCHY_VERSION);
+
+    write_value(out, static_cast<uint64_t>(hierarchy->get_num_vertices()));
+    for (const auto &coordinate : hierarchy->get_coordinates()) {
+        write_value(out, coordinate.get_longitude_microdegrees());
+        write_value(out, coordinate.get_latitude_microdegrees());
+    }
+    write_values(out, hierarchy->get_ranks());
+    write_values(out, hierarchy->get_edge_offsets());
+
+    // Field by field, so that the file does not depend on the struct's padding
+    for (const auto &edge : hierarchy->get_edges()) {
+        write_value(out, edge.vertex);
+        write_value(out, edge.middle_vertex);
+        write_value(out, edge.length);
+    }
+
+    if (!out.flush()) {
+        throw std::runtime_error(fmt::format("Could not write contraction hierarchy file {}", path));
+    }
+}
+
+std::shared_ptr<ContractionHierarchy> ContractionHierarchySerializer::deserialize_from_file(const std::string &path) {
+    auto in = std::ifstream(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error(fmt::format("Could not open contraction hierarchy file {}", path));
+    }
+
+    char magic[sizeof(CONTRACTION_HIERARCHY_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, CONTRACTION_HIERARCHY_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error(fmt::format("{} is not a contraction hierarchy file", path));
+    }
+    const auto version = read_value<uint32_t>(in, path);
+    if (version != CONTRACTION_HIERARCHY_VERSION) {
+        throw std::runtime_error(
+            fmt::format("Contraction hierarchy file {} has unsupported version {}", path, version));
+    }
+
+    const auto num_vertices = read_value<uint64_t>(in, path);
+    auto coordinates = std::vector<Coordinate>();
+    coordinates.reserve(num_vertices);
+    for (uint64_t i = 0; i < num_vertices; ++i) {
+        const auto longitude = read_value<int32_t>(in, path);
+        const auto latitude = read_value<int32_t>(in, path);
+        coordinates.emplace_back(longitude, latitude);
+    }
+    auto ranks = read_values<uint32_t>(in, num_vertices, path);
+    auto edge_offsets = read_values<uint64_t>(in, num_vertices + 1, path);
+
+    auto edges = std::vector<ContractionHierarchy::UpwardEdge>();
+    edges.reserve(edge_offsets.back());
+    for (uint64_t i = 0; i < edge_offsets.back(); ++i) {
+        const auto vertex = read_value<uint32_t>(in, path);
+        const auto middle_vertex = read_value<uint32_t>(in, path);
+        const auto length = read_value<double>(in, path);
+        edges.push_back(ContractionHierarchy::UpwardEdge{
+            .vertex = vertex,
+            .middle_vertex = middle_vertex,
+            .length = length,
+        });
+    }
+
+    return std::make_shared<ContractionHierarchy>(std::move(coordinates), std::move(ranks), std::move(edge_offsets),
+                                                  std::move(edges));
+}
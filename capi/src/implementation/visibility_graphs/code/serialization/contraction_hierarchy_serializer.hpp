@@ -0,0 +1,18 @@
+#ifndef CAPI_CONTRACTION_HIERARCHY_SERIALIZER_HPP
+#define CAPI_CONTRACTION_HIERARCHY_SERIALIZER_HPP
+
+#include <memory>
+#include <string>
+
+#include "datastructures/contraction_hierarchy/contraction_hierarchy.hpp"
+
+// Contraction hierarchy files hold, in order: a header, the vertex coordinates, their ranks, the upward edge offsets
+// of every vertex and the upward edges (see ContractionHierarchy). They are kept alongside the graph they were built
+// from, whose vertices are in the same order.
+class ContractionHierarchySerializer {
+  public:
+    static void serialize_to_file(const std::shared_ptr<ContractionHierarchy> &hierarchy, const std::string &path);
+    static std::shared_ptr<ContractionHierarchy> deserialize_from_file(const std::string &path);
+};
+
+#endif // CAPI_CONTRACTION_HIERARCHY_SERIALIZER_HPP
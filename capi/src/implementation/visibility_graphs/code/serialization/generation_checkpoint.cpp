@@ -0,0 +1,154 @@
+#include <cstring>
+#include <filesystem>
+#include <fmt/core.h>
+#include <iterator>
+#include <stdexcept>
+
+#include "generation_checkpoint.hpp"
+
+namespace {
+constexpr char CHECKPOINT_MAGIC[] = {'C', 'A', 'P', 'I', 'C', 'K', 'P', 'T'};
+constexpr uint32_t CHECKPOINT_VERSION = 1;
+constexpr size_t CHECKPOINT_HEADER_SIZE = sizeof(CHECKPOINT_MAGIC) + sizeof(uint32_t) + sizeof(uint64_t);
+constexpr size_t OBSERVER_RECORD_HEADER_SIZE = 2 * sizeof(int32_t) + sizeof(uint32_t);
+constexpr size_t VISIBLE_VERTEX_RECORD_SIZE = 2 * sizeof(int32_t) + sizeof(uint8_t);
+
+template <typename T> void append_bytes(std::string &buffer, T val) {
+    buffer.append(reinterpret_cast<const char *>(&val), sizeof(T));
+}
+
+template <typename T> T read_bytes(const std::string &contents, size_t offset) {
+    T val;
+    std::memcpy(&val, contents.data() + offset, sizeof(T));
+    return val;
+}
+} // namespace
+
+GenerationCheckpoint::GenerationCheckpoint(const std::string &path, uint64_t fingerprint, size_t flush_interval)
+    : _flush_interval(flush_interval) {
+    const auto exists = std::filesystem::exists(path);
+    if (exists) {
+        read_completed_observers(path, fingerprint);
+    }
+
+    _file.open(path, std::ios::binary | std::ios::app);
+    if (!_file) {
+        throw std::runtime_error(fmt::format("Could not open checkpoint file {}", path));
+    }
+
+    if (!exists) {
+        write_header(fingerprint);
+    }
+}
+
+GenerationCheckpoint::~GenerationCheckpoint() {
+    try {
+        flush();
+    } catch (const std::exception &) {
+        // Destructors must not throw. Observers left unflushed are recomputed on resume.
+    }
+}
+
+void GenerationCheckpoint::replay_into(const std::shared_ptr<Graph> &graph) const {
+    for (const auto &completed_observer : _completed_observers) {
+        for (const auto &visible_vertex : completed_observer.visible_vertices) {
+            graph->add_edge(completed_observer.observer, visible_vertex.coord,
+                            visible_vertex.is_visible_across_meridian);
+        }
+    }
+}
+
+bool GenerationCheckpoint::is_completed(const Coordinate &observer) const {
+    return _completed_observer_coordinates.find(observer) != _completed_observer_coordinates.end();
+}
+
+void GenerationCheckpoint::record(const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices) {
+    std::lock_guard<std::mutex> guard(_buffer_lock);
+
+    append_bytes(_buffer, observer.get_longitude_microdegrees());
+    append_bytes(_buffer, observer.get_latitude_microdegrees());
+    append_bytes(_buffer, static_cast<uint32_t>(visible_vertices.size()));
+    for (const auto &visible_vertex : visible_vertices) {
+        append_bytes(_buffer, visible_vertex.coord.get_longitude_microdegrees());
+        append_bytes(_buffer, visible_vertex.coord.get_latitude_microdegrees());
+        append_bytes(_buffer, static_cast<uint8_t>(visible_vertex.is_visible_across_meridian));
+    }
+
+    if (++_num_buffered_observers >= _flush_interval) {
+        flush_buffer();
+    }
+}
+
+void GenerationCheckpoint::flush() {
+    std::lock_guard<std::mutex> guard(_buffer_lock);
+    flush_buffer();
+}
+
+void GenerationCheckpoint::flush_buffer() {
+    _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+    _file.flush();
+    if (!_file) {
+        throw std::runtime_error("Failed to write to checkpoint file");
+    }
+
+    _buffer.clear();
+    _num_buffered_observers = 0;
+}
+
+void GenerationCheckpoint::write_header(uint64_t fingerprint) {
+    auto header = std::string(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    append_bytes(header, CHECKPOINT_VERSION);
+    append_bytes(header, fingerprint);
+
+    _file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    _file.flush();
+}
+
+void GenerationCheckpoint::read_completed_observers(const std::string &path, uint64_t fingerprint) {
+    std::ifstream file(path, std::ios::binary);
+    const auto contents = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if (contents.size() < CHECKPOINT_HEADER_SIZE ||
+        std::memcmp(contents.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        throw std::runtime_error(fmt::format("{} is not a visgraph generation checkpoint", path));
+    }
+    if (read_bytes<uint32_t>(contents, sizeof(CHECKPOINT_MAGIC)) != CHECKPOINT_VERSION) {
+        throw std::runtime_error(fmt::format("Checkpoint {} has an unsupported version", path));
+    }
+    if (read_bytes<uint64_t>(contents, sizeof(CHECKPOINT_MAGIC) + sizeof(uint32_t)) != fingerprint) {
+        throw std::runtime_error(
+            fmt::format("Checkpoint {} was written for different polygons or generation parameters", path));
+    }
+
+    size_t offset = CHECKPOINT_HEADER_SIZE;
+    while (offset + OBSERVER_RECORD_HEADER_SIZE <= contents.size()) {
+        const auto observer =
+            Coordinate(read_bytes<int32_t>(contents, offset), read_bytes<int32_t>(contents, offset + sizeof(int32_t)));
+        const auto num_visible_vertices = read_bytes<uint32_t>(contents, offset + 2 * sizeof(int32_t));
+
+        const auto record_end =
+            offset + OBSERVER_RECORD_HEADER_SIZE + num_visible_vertices * VISIBLE_VERTEX_RECORD_SIZE;
+        if (record_end > contents.size()) {
+            break;
+        }
+
+        auto completed_observer = CompletedObserver{.observer = observer, .visible_vertices = {}};
+        completed_observer.visible_vertices.reserve(num_visible_vertices);
+        for (auto record_offset = offset + OBSERVER_RECORD_HEADER_SIZE; record_offset < record_end;
+             record_offset += VISIBLE_VERTEX_RECORD_SIZE) {
+            completed_observer.visible_vertices.push_back(VisibleVertex{
+                .coord = Coordinate(read_bytes<int32_t>(contents, record_offset),
+                                    read_bytes<int32_t>(contents, record_offset + sizeof(int32_t))),
+                .is_visible_across_meridian = read_bytes<uint8_t>(contents, record_offset + 2 * sizeof(int32_t)) != 0,
+            });
+        }
+
+        _completed_observer_coordinates.insert(observer);
+        _completed_observers.push_back(std::move(completed_observer));
+        offset = record_end;
+    }
+
+    // Drop any partially written record so new records are appended after the last complete one
+    file.close();
+    std::filesystem::resize_file(path, offset);
+}
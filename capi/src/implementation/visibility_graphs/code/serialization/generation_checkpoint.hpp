@@ -0,0 +1,54 @@
+#ifndef CAPI_GENERATION_CHECKPOINT_HPP
+#define CAPI_GENERATION_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "datastructures/graph/graph.hpp"
+#include "types/coordinate/coordinate.hpp"
+#include "types/visible_vertex/visible_vertex.hpp"
+
+// Append-only log of the observers whose visible vertices have been computed during visgraph generation.
+// Observers are buffered in memory and written out every flush_interval observers, so a crash loses at most
+// that many. A partially written tail from a crash is discarded when the checkpoint is reopened.
+class GenerationCheckpoint {
+  public:
+    // Opens the checkpoint at path, creating it if it does not exist.
+    // fingerprint identifies the polygons and parameters of the generation, and must match the checkpoint's.
+    GenerationCheckpoint(const std::string &path, uint64_t fingerprint, size_t flush_interval);
+    ~GenerationCheckpoint();
+
+    // Adds the edges of every observer completed in the checkpoint to the graph
+    void replay_into(const std::shared_ptr<Graph> &graph) const;
+    [[nodiscard]] bool is_completed(const Coordinate &observer) const;
+
+    // Thread-safe
+    void record(const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices);
+    void flush();
+
+  private:
+    struct CompletedObserver {
+        Coordinate observer;
+        std::vector<VisibleVertex> visible_vertices;
+    };
+
+    void read_completed_observers(const std::string &path, uint64_t fingerprint);
+    void write_header(uint64_t fingerprint);
+    void flush_buffer();
+
+    std::vector<CompletedObserver> _completed_observers;
+    std::unordered_set<Coordinate> _completed_observer_coordinates;
+
+    std::ofstream _file;
+    std::string _buffer;
+    size_t _num_buffered_observers = 0;
+    size_t _flush_interval;
+    std::mutex _buffer_lock;
+};
+
+#endif // CAPI_GENERATION_CHECKPOINT_HPP
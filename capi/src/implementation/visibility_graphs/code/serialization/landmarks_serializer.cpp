@@ -0,0 +1,88 @@
+#include <cstring>
+#include <fmt/core.h>
+#include <fstream>
+#include <stdexcept>
+
+#include "landmarks_serializer.hpp"
+
+namespace {
+constexpr char LANDMARKS_MAGIC[] = {'C', 'A', 'P', 'I', 'L', 'M', 'K', 'S'};
+constexpr uint32_t LANDMARKS_VERSION = 1;
+
+template <typename T> void write_value(std::ostream &out, T val) {
+    out.write(reinterpret_cast<const char *>(&val), sizeof(T));
+}
+
+template <typename T> void write_values(std::ostream &out, const std::vector<T> &values) {
+    out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T> T read_value(std::istream &in, const std::string &path) {
+    T val;
+    if (!in.read(reinterpret_cast<char *>(&val), sizeof(T))) {
+        throw std::runtime_error(fmt::format("Landmarks file {} is truncated", path));
+    }
+    return val;
+}
+
+template <typename T> std::vector<T> read_values(std::istream &in, size_t num_values, const std::string &path) {
+    auto values = std::vector<T>(num_values);
+    if (!in.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(num_values * sizeof(T)))) {
+        throw std::runtime_error(fmt::format("Landmarks file {} is truncated", path));
+    }
+    return values;
+}
+} // namespace
+
+void LandmarksSerializer::serialize_to_file(const std::shared_ptr<Landmarks> &landmarks, const std::string &path) {
+    auto out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error(fmt::format("Could not open landmarks file {}", path));
+    }
+
+    out.write(LANDMARKS_MAGIC, sizeof(LANDMARKS_MAGIC));
+    write_value(out, LANDMARKS_VERSION);
+
+    write_value(out, static_cast<uint64_t>(landmarks->get_num_vertices()));
+    write_value(out, static_cast<uint64_t>(landmarks->get_num_landmarks()));
+    for (const auto &coordinate : landmarks->get_coordinates()) {
+        write_value(out, coordinate.get_longitude_microdegrees());
+        write_value(out, coordinate.get_latitude_microdegrees());
+    }
+    write_values(out, landmarks->get_landmark_vertices());
+    write_values(out, landmarks->get_distances());
+
+    if (!out.flush()) {
+        throw std::runtime_error(fmt::format("Could not write landmarks file {}", path));
+    }
+}
+
+std::shared_ptr<Landmarks> LandmarksSerializer::deserialize_from_file(const std::string &path) {
+    auto in = std::ifstream(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error(fmt::format("Could not open landmarks file {}", path));
+    }
+
+    char magic[sizeof(LANDMARKS_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, LANDMARKS_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error(fmt::format("{} is not a landmarks file", path));
+    }
+    const auto version = read_value<uint32_t>(in, path);
+    if (version != LANDMARKS_VERSION) {
+        throw std::runtime_error(fmt::format("Landmarks file {} has unsupported version {}", path, version));
+    }
+
+    const auto num_vertices = read_value<uint64_t>(in, path);
+    const auto num_landmarks = read_value<uint64_t>(in, path);
+    auto coordinates = std::vector<Coordinate>();
+    coordinates.reserve(num_vertices);
+    for (uint64_t i = 0; i < num_vertices; ++i) {
+        const auto longitude = read_value<int32_t>(in, path);
+        const auto latitude = read_value<int32_t>(in, path);
+        coordinates.emplace_back(longitude, latitude);
+    }
+    auto landmark_vertices = read_values<uint32_t>(in, num_landmarks, path);
+    auto distances = read_values<double>(in, num_vertices * num_landmarks, path);
+
+    return std::make_shared<Landmarks>(std::move(coordinates), std::move(landmark_vertices), std::move(distances));
+}
@@ -0,0 +1,18 @@
+#ifndef CAPI_LANDMARKS_SERIALIZER_HPP
+#define CAPI_LANDMARKS_SERIALIZER_HPP
+
+#include <memory>
+#include <string>
+
+#include "datastructures/landmarks/landmarks.hpp"
+
+// Landmark files hold, in order: a header, the vertex coordinates, the landmark vertices and the distances between
+// them and every vertex (see Landmarks). They are kept alongside the graph they were built from, whose vertices are in
+// the same order.
+class LandmarksSerializer {
+  public:
+    static void serialize_to_file(const std::shared_ptr<Landmarks> &landmarks, const std::string &path);
+    static std::shared_ptr<Landmarks> deserialize_from_file(const std::string &path);
+};
+
+#endif // CAPI_LANDMARKS_SERIALIZER_HPP
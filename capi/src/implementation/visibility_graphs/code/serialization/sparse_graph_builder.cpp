@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <filesystem>
+#include <fmt/core.h>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "sparse_graph_builder.hpp"
+#include "sparse_graph_serializer.hpp"
+
+namespace {
+// Runs merged at once. Each open run holds a file buffer, so this bounds the memory of the merge.
+constexpr size_t MAX_MERGE_FAN_IN = 64;
+constexpr size_t MIN_BUFFER_CAPACITY = 1024;
+
+template <typename T> void write_value(std::ostream &out, T val) {
+    out.write(reinterpret_cast<const char *>(&val), sizeof(T));
+}
+
+template <typename T> bool read_value(std::istream &in, T &val) {
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(&val), sizeof(T)));
+}
+} // namespace
+
+SparseGraphBuilder::SparseGraphBuilder(std::vector<Polygon> polygons, std::string run_directory,
+                                       size_t memory_limit_bytes)
+    : _polygons(std::move(polygons)), _run_directory(std::move(run_directory)),
+      _buffer_capacity(std::max(memory_limit_bytes / sizeof(DirectedEdge), MIN_BUFFER_CAPACITY)) {
+    for (const auto &polygon : _polygons) {
+        for (const auto &vertex : polygon.get_vertices()) {
+            _coordinate_to_index_mapping[vertex] = static_cast<uint32_t>(_num_vertices++);
+        }
+    }
+
+    std::filesystem::create_directories(_run_directory);
+}
+
+SparseGraphBuilder::~SparseGraphBuilder() {
+    // Only the runs this builder created are removed, and the directory only if nothing else is left in it
+    std::error_code error;
+    for (const auto &run_path : _run_paths) {
+        std::filesystem::remove(run_path, error);
+    }
+    std::filesystem::remove(_run_directory, error);
+}
+
+void SparseGraphBuilder::add_edges(const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices) {
+    const auto observer_index = coordinate_to_index(observer);
+
+    std::lock_guard<std::mutex> guard(_buffer_lock);
+    for (const auto &visible_vertex : visible_vertices) {
+        if (visible_vertex.coord == observer) {
+            continue;
+        }
+
+        const auto vertex_index = coordinate_to_index(visible_vertex.coord);
+        const uint8_t state = visible_vertex.is_visible_across_meridian ? 0x2 : 0x1;
+        add_directed_edge(observer_index, vertex_index, state);
+        add_directed_edge(vertex_index, observer_index, state);
+    }
+}
+
+void SparseGraphBuilder::finalize(const std::string &output_path) {
+    std::lock_guard<std::mutex> guard(_buffer_lock);
+    spill_buffer();
+    _buffer.shrink_to_fit();
+
+    while (_run_paths.size() > MAX_MERGE_FAN_IN) {
+        auto merged_run_paths = std::vector<std::string>();
+        for (size_t i = 0; i < _run_paths.size(); i += MAX_MERGE_FAN_IN) {
+            const auto group = std::vector<std::string>(
+                _run_paths.begin() + i, _run_paths.begin() + std::min(i + MAX_MERGE_FAN_IN, _run_paths.size()));
+
+            const auto merged_run_path = next_run_path();
+            auto out = std::ofstream(merged_run_path, std::ios::binary);
+            SparseGraphBuilder::merge_runs(group, [&out](const DirectedEdge &edge) {
+                write_value(out, edge.from);
+                write_value(out, edge.to);
+                write_value(out, edge.state);
+            });
+            if (!out.flush()) {
+                throw std::runtime_error(fmt::format("Could not write sparse graph run {}", merged_run_path));
+            }
+
+            for (const auto &run_path : group) {
+                std::filesystem::remove(run_path);
+            }
+            merged_run_paths.push_back(merged_run_path);
+        }
+
+        _run_paths = std::move(merged_run_paths);
+    }
+
+    // Neighbours and edge states follow the offsets in the graph file, but the offsets are only known once every edge
+    // has been merged, so both are staged in files of their own
+    const auto neighbors_path = next_run_path();
+    const auto edge_states_path = next_run_path();
+    _run_paths.push_back(neighbors_path);
+    _run_paths.push_back(edge_states_path);
+
+    auto neighbor_offsets = std::vector<uint64_t>(_num_vertices + 1, 0);
+    {
+        auto neighbors_out = std::ofstream(neighbors_path, std::ios::binary);
+        auto edge_states_out = std::ofstream(edge_states_path, std::ios::binary);
+        SparseGraphBuilder::merge_runs(
+            std::vector<std::string>(_run_paths.begin(), _run_paths.end() - 2), [&](const DirectedEdge &edge) {
+                ++neighbor_offsets[edge.from + 1];
+                write_value(neighbors_out, edge.to);
+                write_value(edge_states_out, edge.state);
+            });
+        if (!neighbors_out.flush() || !edge_states_out.flush()) {
+            throw std::runtime_error(fmt::format("Could not write sparse graph runs in {}", _run_directory));
+        }
+    }
+    for (size_t i = 0; i < _num_vertices; ++i) {
+        neighbor_offsets[i + 1] += neighbor_offsets[i];
+    }
+
+    auto out = std::ofstream(output_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error(fmt::format("Could not open sparse graph file {}", output_path));
+    }
+    SparseGraphSerializer::write_preamble(out, _polygons, neighbor_offsets);
+    for (const auto &staged_path : {neighbors_path, edge_states_path}) {
+        auto in = std::ifstream(staged_path, std::ios::binary);
+        if (neighbor_offsets.back() > 0) {
+            out << in.rdbuf();
+        }
+    }
+    if (!out.flush()) {
+        throw std::runtime_error(fmt::format("Could not write sparse graph file {}", output_path));
+    }
+
+    for (const auto &run_path : _run_paths) {
+        std::filesystem::remove(run_path);
+    }
+    _run_paths.clear();
+}
+
+size_t SparseGraphBuilder::get_num_runs() const { return _run_paths.size(); }
+
+uint32_t SparseGraphBuilder::coordinate_to_index(const Coordinate &coordinate) const {
+    const auto iter = _coordinate_to_index_mapping.find(coordinate);
+    if (iter == _coordinate_to_index_mapping.end()) {
+        throw std::runtime_error(fmt::format("Coordinate {} not in graph vertices, so an index cannot be fetched",
+                                             coordinate.to_string_representation()));
+    }
+
+    return iter->second;
+}
+
+void SparseGraphBuilder::add_directed_edge(uint32_t from, uint32_t to, uint8_t state) {
+    if (_buffer.size() >= _buffer_capacity) {
+        // Spilled while holding the buffer lock, so at most one buffer of edges is ever held
+        spill_buffer();
+    } else if (_buffer.size() == _buffer.capacity()) {
+        // Growing by hand keeps the buffer within its capacity rather than doubling past it
+        _buffer.reserve(std::min(std::max(2 * _buffer.size(), MIN_BUFFER_CAPACITY), _buffer_capacity));
+    }
+
+    _buffer.push_back(DirectedEdge{.from = from, .to = to, .state = state});
+}
+
+void SparseGraphBuilder::spill_buffer() {
+    if (_buffer.empty()) {
+        return;
+    }
+
+    std::sort(_buffer.begin(), _buffer.end(), [](const DirectedEdge &a, const DirectedEdge &b) {
+        return std::tie(a.from, a.to) < std::tie(b.from, b.to);
+    });
+
+    const auto run_path = next_run_path();
+    auto out = std::ofstream(run_path, std::ios::binary);
+    for (size_t i = 0; i < _buffer.size();) {
+        auto edge = _buffer[i];
+        for (++i; i < _buffer.size() && _buffer[i].from == edge.from && _buffer[i].to == edge.to; ++i) {
+            edge.state |= _buffer[i].state;
+        }
+
+        write_value(out, edge.from);
+        write_value(out, edge.to);
+        write_value(out, edge.state);
+    }
+    if (!out.flush()) {
+        throw std::runtime_error(fmt::format("Could not write sparse graph run {}", run_path));
+    }
+
+    _run_paths.push_back(run_path);
+    _buffer.clear();
+}
+
+std::string SparseGraphBuilder::next_run_path() {
+    return (std::filesystem::path(_run_directory) / fmt::format("run_{}", _num_created_runs++)).string();
+}
+
+template <typename OnEdge>
+void SparseGraphBuilder::merge_runs(const std::vector<std::string> &run_paths, OnEdge on_edge) {
+    auto runs = std::vector<std::ifstream>();
+    runs.reserve(run_paths.size());
+    for (const auto &run_path : run_paths) {
+        runs.emplace_back(run_path, std::ios::binary);
+        if (!runs.back()) {
+            throw std::runtime_error(fmt::format("Could not open sparse graph run {}", run_path));
+        }
+    }
+
+    const auto read_edge = [&runs](size_t run, DirectedEdge &edge) {
+        return read_value(runs[run], edge.from) && read_value(runs[run], edge.to) && read_value(runs[run], edge.state);
+    };
+
+    // Heads of each run, smallest edge first
+    using RunHead = std::pair<DirectedEdge, size_t>;
+    const auto compare_heads = [](const RunHead &a, const RunHead &b) {
+        return std::tie(a.first.from, a.first.to) > std::tie(b.first.from, b.first.to);
+    };
+    auto heads = std::priority_queue<RunHead, std::vector<RunHead>, decltype(compare_heads)>(compare_heads);
+    for (size_t run = 0; run < runs.size(); ++run) {
+        auto edge = DirectedEdge{};
+        if (read_edge(run, edge)) {
+            heads.emplace(edge, run);
+        }
+    }
+
+    while (!heads.empty()) {
+        auto [edge, run] = heads.top();
+        heads.pop();
+
+        auto next_edge = DirectedEdge{};
+        if (read_edge(run, next_edge)) {
+            heads.emplace(next_edge, run);
+        }
+
+        // Runs are merged duplicate free, but the same edge may be in several runs
+        while (!heads.empty() && heads.top().first.from == edge.from && heads.top().first.to == edge.to) {
+            const auto duplicate_run = heads.top().second;
+            edge.state |= heads.top().first.state;
+            heads.pop();
+
+            if (read_edge(duplicate_run, next_edge)) {
+                heads.emplace(next_edge, duplicate_run);
+            }
+        }
+
+        on_edge(edge);
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef CAPI_SPARSE_GRAPH_BUILDER_HPP
+#define CAPI_SPARSE_GRAPH_BUILDER_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "types/coordinate/coordinate.hpp"
+#include "types/polygon/polygon.hpp"
+#include "types/visible_vertex/visible_vertex.hpp"
+
+// Builds a sparse graph file (see SparseGraphSerializer) from the visible vertices of each observer without holding
+// every edge in memory. Edges are buffered up to memory_limit_bytes, then sorted and spilled to a run file in
+// run_directory. finalize merges the runs into the graph file.
+//
+// Only the vertex index and one offset per vertex are held in memory besides the buffer.
+class SparseGraphBuilder {
+  public:
+    SparseGraphBuilder(std::vector<Polygon> polygons, std::string run_directory, size_t memory_limit_bytes);
+    ~SparseGraphBuilder();
+
+    SparseGraphBuilder(const SparseGraphBuilder &) = delete;
+    SparseGraphBuilder &operator=(const SparseGraphBuilder &) = delete;
+
+    // Thread-safe. Adds the edges in both directions, as Graph::add_edge does.
+    void add_edges(const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices);
+    void finalize(const std::string &output_path);
+
+    [[nodiscard]] size_t get_num_runs() const;
+
+  private:
+    struct DirectedEdge {
+        uint32_t from;
+        uint32_t to;
+        uint8_t state;
+    };
+
+    [[nodiscard]] uint32_t coordinate_to_index(const Coordinate &coordinate) const;
+    void add_directed_edge(uint32_t from, uint32_t to, uint8_t state);
+    // Sorts the buffer, merging duplicate edges, and writes it to a new run
+    void spill_buffer();
+    [[nodiscard]] std::string next_run_path();
+    // Merges runs into one run, merging duplicate edges, with on_edge called for each merged edge in order
+    template <typename OnEdge> static void merge_runs(const std::vector<std::string> &run_paths, OnEdge on_edge);
+
+    std::vector<Polygon> _polygons;
+    std::unordered_map<Coordinate, uint32_t> _coordinate_to_index_mapping;
+    size_t _num_vertices = 0;
+
+    std::string _run_directory;
+    std::vector<std::string> _run_paths;
+    size_t _num_created_runs = 0;
+
+    std::vector<DirectedEdge> _buffer;
+    size_t _buffer_capacity;
+    std::mutex _buffer_lock;
+};
+
+#endif // CAPI_SPARSE_GRAPH_BUILDER_HPP
@@ -0,0 +1,109 @@
+#include <cstring>
+#include <fmt/core.h>
+#include <fstream>
+#include <stdexcept>
+
+#include "sparse_graph_serializer.hpp"
+
+namespace {
+constexpr char SPARSE_GRAPH_MAGIC[] = {'C', 'A', 'P', 'I', 'S', 'P', 'R', 'S'};
+constexpr uint32_t SPARSE_GRAPH_VERSION = 1;
+
+template <typename T> void write_value(std::ostream &out, T val) {
+    out.write(reinterpret_cast<const char *>(&val), sizeof(T));
+}
+
+template <typename T> void write_values(std::ostream &out, const std::vector<T> &values) {
+    out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T> T read_value(std::istream &in, const std::string &path) {
+    T val;
+    if (!in.read(reinterpret_cast<char *>(&val), sizeof(T))) {
+        throw std::runtime_error(fmt::format("Sparse graph file {} is truncated", path));
+    }
+    return val;
+}
+
+template <typename T> std::vector<T> read_values(std::istream &in, size_t num_values, const std::string &path) {
+    auto values = std::vector<T>(num_values);
+    if (!in.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(num_values * sizeof(T)))) {
+        throw std::runtime_error(fmt::format("Sparse graph file {} is truncated", path));
+    }
+    return values;
+}
+} // namespace
+
+void SparseGraphSerializer::serialize_to_file(const std::shared_ptr<SparseGraph> &graph, const std::string &path) {
+    auto out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error(fmt::format("Could not open sparse graph file {}", path));
+    }
+
+    write_preamble(out, graph->get_polygons(), graph->get_neighbor_offsets());
+    write_values(out, graph->get_neighbor_indices());
+    write_values(out, graph->get_edge_states());
+
+    if (!out.flush()) {
+        throw std::runtime_error(fmt::format("Could not write sparse graph file {}", path));
+    }
+}
+
+std::shared_ptr<SparseGraph> SparseGraphSerializer::deserialize_from_file(const std::string &path) {
+    auto in = std::ifstream(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error(fmt::format("Could not open sparse graph file {}", path));
+    }
+
+    char magic[sizeof(SPARSE_GRAPH_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, SPARSE_GRAPH_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error(fmt::format("{} is not a sparse graph file", path));
+    }
+    const auto version = read_value<uint32_t>(in, path);
+    if (version != SPARSE_GRAPH_VERSION) {
+        throw std::runtime_error(fmt::format("Sparse graph file {} has unsupported version {}", path, version));
+    }
+
+    const auto num_polygons = read_value<uint64_t>(in, path);
+    auto polygons = std::vector<Polygon>();
+    polygons.reserve(num_polygons);
+    size_t num_vertices = 0;
+    for (uint64_t i = 0; i < num_polygons; ++i) {
+        const auto num_polygon_vertices = read_value<uint64_t>(in, path);
+        auto vertices = std::vector<Coordinate>();
+        vertices.reserve(num_polygon_vertices);
+        for (uint64_t j = 0; j < num_polygon_vertices; ++j) {
+            const auto longitude = read_value<int32_t>(in, path);
+            const auto latitude = read_value<int32_t>(in, path);
+            vertices.emplace_back(longitude, latitude);
+        }
+
+        num_vertices += num_polygon_vertices;
+        polygons.emplace_back(vertices);
+    }
+
+    auto neighbor_offsets = read_values<uint64_t>(in, num_vertices + 1, path);
+    auto neighbors = read_values<uint32_t>(in, neighbor_offsets.back(), path);
+    auto edge_states = read_values<uint8_t>(in, neighbor_offsets.back(), path);
+
+    return std::make_shared<SparseGraph>(std::move(polygons), std::move(neighbor_offsets), std::move(neighbors),
+                                         std::move(edge_states));
+}
+
+void SparseGraphSerializer::write_preamble(std::ostream &out, const std::vector<Polygon> &polygons,
+                                           const std::vector<uint64_t> &neighbor_offsets) {
+    out.write(SPARSE_GRAPH_MAGIC, sizeof(SPARSE_GRAPH_MAGIC));
+    write_value(out, SPARSE_GRAPH_VERSION);
+
+    write_value(out, static_cast<uint64_t>(polygons.size()));
+    for (const auto &polygon : polygons) {
+        const auto &vertices = polygon.get_vertices();
+        write_value(out, static_cast<uint64_t>(vertices.size()));
+        for (const auto &vertex : vertices) {
+            write_value(out, vertex.get_longitude_microdegrees());
+            write_value(out, vertex.get_latitude_microdegrees());
+        }
+    }
+
+    write_values(out, neighbor_offsets);
+}
@@ -0,0 +1,26 @@
+#ifndef CAPI_SPARSE_GRAPH_SERIALIZER_HPP
+#define CAPI_SPARSE_GRAPH_SERIALIZER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "datastructures/sparse_graph/sparse_graph.hpp"
+#include "types/polygon/polygon.hpp"
+
+// Sparse graph files hold, in order: a header, the polygons, the neighbour offsets of every vertex,
+// the neighbour indices and the edge states (see SparseGraph).
+class SparseGraphSerializer {
+  public:
+    static void serialize_to_file(const std::shared_ptr<SparseGraph> &graph, const std::string &path);
+    static std::shared_ptr<SparseGraph> deserialize_from_file(const std::string &path);
+
+    // Writes everything before the neighbour indices, so that the indices and then the edge states can be
+    // streamed in after it without holding them in memory
+    static void write_preamble(std::ostream &out, const std::vector<Polygon> &polygons,
+                               const std::vector<uint64_t> &neighbor_offsets);
+};
+
+#endif // CAPI_SPARSE_GRAPH_SERIALIZER_HPP
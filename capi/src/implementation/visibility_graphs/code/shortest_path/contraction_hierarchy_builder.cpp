@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "contraction_hierarchy_builder.hpp"
+#include "datastructures/indexed_graph/indexed_graph.hpp"
+#include "shortest_path_computer.hpp"
+
+namespace {
+// Witness searches give up after settling this many vertices
+constexpr size_t MAX_WITNESS_SEARCH_SETTLED_VERTICES = 16;
+
+// An edge between two vertices not yet contracted, kept in both of their lists
+struct ContractionEdge {
+    uint32_t vertex;
+    uint32_t middle_vertex;
+    double length;
+};
+
+struct Shortcut {
+    uint32_t from;
+    uint32_t to;
+    double length;
+};
+
+using ContractionEdges = std::vector<std::vector<ContractionEdge>>;
+
+// Dijkstra from one neighbour of the vertex being contracted over the vertices not yet contracted, avoiding that
+// vertex. Every distance it reaches, settled or not, is the length of a path avoiding it.
+class WitnessSearch {
+  public:
+    explicit WitnessSearch(size_t num_vertices) : _distances(num_vertices), _generations(num_vertices, 0) {}
+
+    void run(const ContractionEdges &edges, uint32_t source, uint32_t avoided_vertex, double maximum_distance) {
+        if (++_generation == 0) {
+            std::fill(_generations.begin(), _generations.end(), 0);
+            _generation = 1;
+        }
+
+        auto heap = std::priority_queue<std::pair<double, uint32_t>, std::vector<std::pair<double, uint32_t>>,
+                                        std::greater<>>();
+        reach(source, 0);
+        heap.emplace(0, source);
+
+        size_t num_settled_vertices = 0;
+        while (!heap.empty() && num_settled_vertices < MAX_WITNESS_SEARCH_SETTLED_VERTICES) {
+            const auto [distance, vertex] = heap.top();
+            heap.pop();
+            if (distance > _distances[vertex]) {
+                continue;
+            }
+            ++num_settled_vertices;
+
+            for (const auto &edge : edges[vertex]) {
+                const auto neighbor_distance = distance + edge.length;
+                if (edge.vertex == avoided_vertex || neighbor_distance > maximum_distance ||
+                    neighbor_distance >= distance_to(edge.vertex)) {
+                    continue;
+                }
+
+                reach(edge.vertex, neighbor_distance);
+                heap.emplace(neighbor_distance, edge.vertex);
+            }
+        }
+    }
+
+    [[nodiscard]] double distance_to(uint32_t vertex) const {
+        return _generations[vertex] == _generation ? _distances[vertex] : INFINITY;
+    }
+
+  private:
+    void reach(uint32_t vertex, double distance) {
+        _distances[vertex] = distance;
+        _generations[vertex] = _generation;
+    }
+
+    std::vector<double> _distances;
+    std::vector<uint32_t> _generations;
+    uint32_t _generation = 0;
+};
+
+// The shortcuts contracting a vertex would add between its remaining neighbours
+void find_shortcuts(const ContractionEdges &edges, uint32_t vertex, WitnessSearch &witness_search,
+                    std::vector<Shortcut> &shortcuts) {
+    shortcuts.clear();
+
+    const auto &neighbors = edges[vertex];
+    for (size_t i = 0; i + 1 < neighbors.size(); ++i) {
+        auto longest_shortcut = 0.;
+        for (size_t j = i + 1; j < neighbors.size(); ++j) {
+            longest_shortcut = std::max(longest_shortcut, neighbors[i].length + neighbors[j].length);
+        }
+
+        witness_search.run(edges, neighbors[i].vertex, vertex, longest_shortcut);
+        for (size_t j = i + 1; j < neighbors.size(); ++j) {
+            const auto length = neighbors[i].length + neighbors[j].length;
+            if (witness_search.distance_to(neighbors[j].vertex) > length) {
+                shortcuts.push_back(Shortcut{
+                    .from = neighbors[i].vertex,
+                    .to = neighbors[j].vertex,
+                    .length = length,
+                });
+            }
+        }
+    }
+}
+
+// Adds a directed edge, or shortens the existing one if the new one is shorter
+void add_edge(ContractionEdges &edges, uint32_t from, uint32_t to, uint32_t middle_vertex, double length) {
+    for (auto &edge : edges[from]) {
+        if (edge.vertex == to) {
+            if (length < edge.length) {
+                edge.middle_vertex = middle_vertex;
+                edge.length = length;
+            }
+            return;
+        }
+    }
+
+    edges[from].push_back(ContractionEdge{
+        .vertex = to,
+        .middle_vertex = middle_vertex,
+        .length = length,
+    });
+}
+} // namespace
+
+std::shared_ptr<ContractionHierarchy> ContractionHierarchyBuilder::build(const IGraph &graph) {
+    const auto indexed_graph = IndexedGraph(graph);
+    const auto num_vertices = indexed_graph.get_num_vertices();
+
+    auto edges = ContractionEdges(num_vertices);
+    for (uint32_t vertex = 0; vertex < num_vertices; ++vertex) {
+        for (const auto &neighbor : indexed_graph.get_neighbors(vertex)) {
+            edges[vertex].push_back(ContractionEdge{
+                .vertex = neighbor.vertex,
+                .middle_vertex = ContractionHierarchy::NO_MIDDLE_VERTEX,
+                .length = ShortestPathComputer::distance_measurement(indexed_graph.get_coordinate(neighbor.vertex),
+                                                                     indexed_graph.get_coordinate(vertex),
+                                                                     neighbor.is_meridian_crossing),
+            });
+        }
+    }
+
+    auto witness_search = WitnessSearch(num_vertices);
+    auto shortcuts = std::vector<Shortcut>();
+    auto num_contracted_neighbors = std::vector<int64_t>(num_vertices, 0);
+    const auto priority = [&](uint32_t vertex) {
+        find_shortcuts(edges, vertex, witness_search, shortcuts);
+        return static_cast<int64_t>(shortcuts.size()) - static_cast<int64_t>(edges[vertex].size()) +
+               num_contracted_neighbors[vertex];
+    };
+
+    // Ties are broken by vertex id, so that the hierarchy only depends on the graph
+    auto queue = std::priority_queue<std::pair<int64_t, uint32_t>, std::vector<std::pair<int64_t, uint32_t>>,
+                                     std::greater<>>();
+    for (uint32_t vertex = 0; vertex < num_vertices; ++vertex) {
+        queue.emplace(priority(vertex), vertex);
+    }
+
+    auto ranks = std::vector<uint32_t>(num_vertices);
+    auto upward_edges = std::vector<std::vector<ContractionHierarchy::UpwardEdge>>(num_vertices);
+    uint32_t num_contracted_vertices = 0;
+    while (!queue.empty()) {
+        const auto vertex = queue.top().second;
+        queue.pop();
+
+        // Priorities go stale as neighbours are contracted, so they are only brought up to date once at the top. The
+        // shortcuts found doing so are the ones contracting the vertex adds.
+        const auto vertex_priority = priority(vertex);
+        if (!queue.empty() && vertex_priority > queue.top().first) {
+            queue.emplace(vertex_priority, vertex);
+            continue;
+        }
+
+        ranks[vertex] = num_contracted_vertices++;
+        for (const auto &edge : edges[vertex]) {
+            upward_edges[vertex].push_back(ContractionHierarchy::UpwardEdge{
+                .vertex = edge.vertex,
+                .middle_vertex = edge.middle_vertex,
+                .length = edge.length,
+            });
+
+            auto &neighbor_edges = edges[edge.vertex];
+            const auto iter = std::find_if(neighbor_edges.begin(), neighbor_edges.end(),
+                                           [&](const ContractionEdge &neighbor_edge) {
+                                               return neighbor_edge.vertex == vertex;
+                                           });
+            *iter = neighbor_edges.back();
+            neighbor_edges.pop_back();
+            ++num_contracted_neighbors[edge.vertex];
+        }
+        edges[vertex] = std::vector<ContractionEdge>();
+
+        for (const auto &shortcut : shortcuts) {
+            add_edge(edges, shortcut.from, shortcut.to, vertex, shortcut.length);
+            add_edge(edges, shortcut.to, shortcut.from, vertex, shortcut.length);
+        }
+
+        std::sort(upward_edges[vertex].begin(), upward_edges[vertex].end(),
+                  [](const ContractionHierarchy::UpwardEdge &a, const ContractionHierarchy::UpwardEdge &b) {
+                      return a.vertex < b.vertex;
+                  });
+    }
+
+    auto edge_offsets = std::vector<uint64_t>{0};
+    edge_offsets.reserve(num_vertices + 1);
+    auto flattened_edges = std::vector<ContractionHierarchy::UpwardEdge>();
+    for (const auto &vertex_edges : upward_edges) {
+        flattened_edges.insert(flattened_edges.end(), vertex_edges.begin(), vertex_edges.end());
+        edge_offsets.push_back(flattened_edges.size());
+    }
+
+    auto coordinates = std::vector<Coordinate>();
+    coordinates.reserve(num_vertices);
+    for (uint32_t vertex = 0; vertex < num_vertices; ++vertex) {
+        coordinates.push_back(indexed_graph.get_coordinate(vertex));
+    }
+
+    return std::make_shared<ContractionHierarchy>(std::move(coordinates), std::move(ranks), std::move(edge_offsets),
+                                                  std::move(flattened_edges));
+}
@@ -0,0 +1,21 @@
+#ifndef CAPI_CONTRACTION_HIERARCHY_BUILDER_HPP
+#define CAPI_CONTRACTION_HIERARCHY_BUILDER_HPP
+
+#include <memory>
+
+#include "datastructures/contraction_hierarchy/contraction_hierarchy.hpp"
+#include "datastructures/i_graph/i_graph.hpp"
+
+// Builds a contraction hierarchy of a graph, for graphs which are queried far more often than they change.
+//
+// Vertices are contracted one at a time, cheapest first: the fewer shortcuts contracting a vertex would add compared to
+// the edges it removes, and the fewer of its neighbours are already contracted, the sooner it goes. Contracting a
+// vertex adds a shortcut between each pair of its remaining neighbours unless a witness search finds a path between
+// them at least as short without it. Witness searches give up after a few vertices, which only adds shortcuts that
+// are not needed.
+class ContractionHierarchyBuilder {
+  public:
+    static std::shared_ptr<ContractionHierarchy> build(const IGraph &graph);
+};
+
+#endif // CAPI_CONTRACTION_HIERARCHY_BUILDER_HPP
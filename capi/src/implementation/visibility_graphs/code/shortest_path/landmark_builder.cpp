@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "datastructures/indexed_graph/indexed_graph.hpp"
+#include "landmark_builder.hpp"
+#include "shortest_path_computer.hpp"
+
+namespace {
+std::vector<double> distances_from(const IndexedGraph &graph, uint32_t root) {
+    auto distances = std::vector<double>(graph.get_num_vertices(), INFINITY);
+    auto heap =
+        std::priority_queue<std::pair<double, uint32_t>, std::vector<std::pair<double, uint32_t>>, std::greater<>>();
+    distances[root] = 0;
+    heap.emplace(0, root);
+
+    while (!heap.empty()) {
+        const auto [distance, vertex] = heap.top();
+        heap.pop();
+        if (distance > distances[vertex]) {
+            continue;
+        }
+
+        const auto &coordinate = graph.get_coordinate(vertex);
+        for (const auto &neighbor : graph.get_neighbors(vertex)) {
+            const auto neighbor_distance =
+                distance + ShortestPathComputer::distance_measurement(
+                               coordinate, graph.get_coordinate(neighbor.vertex), neighbor.is_meridian_crossing);
+            if (neighbor_distance < distances[neighbor.vertex]) {
+                distances[neighbor.vertex] = neighbor_distance;
+                heap.emplace(neighbor_distance, neighbor.vertex);
+            }
+        }
+    }
+
+    return distances;
+}
+
+// The reachable vertex furthest from the root, if any is further than the root itself
+std::optional<uint32_t> furthest_vertex(const std::vector<double> &distances) {
+    auto furthest = std::optional<uint32_t>();
+    auto furthest_distance = 0.0;
+    for (uint32_t vertex = 0; vertex < distances.size(); ++vertex) {
+        if (std::isfinite(distances[vertex]) && distances[vertex] > furthest_distance) {
+            furthest = vertex;
+            furthest_distance = distances[vertex];
+        }
+    }
+    return furthest;
+}
+} // namespace
+
+std::shared_ptr<Landmarks> LandmarkBuilder::build(const IGraph &graph, uint32_t num_landmarks) {
+    const auto indexed_graph = IndexedGraph(graph);
+    const auto num_vertices = indexed_graph.get_num_vertices();
+
+    auto landmark_vertices = std::vector<uint32_t>();
+    auto landmark_distances = std::vector<std::vector<double>>();
+    if (num_vertices > 0 && num_landmarks > 0) {
+        uint32_t best_connected_vertex = 0;
+        for (uint32_t vertex = 1; vertex < num_vertices; ++vertex) {
+            if (indexed_graph.get_neighbors(vertex).size() > indexed_graph.get_neighbors(best_connected_vertex).size()) {
+                best_connected_vertex = vertex;
+            }
+        }
+
+        // The distance from each vertex to the nearest landmark picked so far
+        auto nearest_landmark_distances = distances_from(indexed_graph, best_connected_vertex);
+        auto next_landmark = furthest_vertex(nearest_landmark_distances);
+        while (next_landmark.has_value() && landmark_vertices.size() < num_landmarks) {
+            landmark_vertices.push_back(next_landmark.value());
+            landmark_distances.push_back(distances_from(indexed_graph, next_landmark.value()));
+
+            if (landmark_vertices.size() == 1) {
+                nearest_landmark_distances = landmark_distances.back();
+            } else {
+                for (uint32_t vertex = 0; vertex < num_vertices; ++vertex) {
+                    nearest_landmark_distances[vertex] =
+                        std::min(nearest_landmark_distances[vertex], landmark_distances.back()[vertex]);
+                }
+            }
+            next_landmark = furthest_vertex(nearest_landmark_distances);
+        }
+    }
+
+    // Each vertex's distances are kept together, as a search looks up all of them at once
+    auto distances = std::vector<double>(static_cast<size_t>(num_vertices) * landmark_vertices.size());
+    for (size_t landmark = 0; landmark < landmark_vertices.size(); ++landmark) {
+        for (uint32_t vertex = 0; vertex < num_vertices; ++vertex) {
+            distances[vertex * landmark_vertices.size() + landmark] = landmark_distances[landmark][vertex];
+        }
+    }
+
+    auto coordinates = std::vector<Coordinate>();
+    coordinates.reserve(num_vertices);
+    for (uint32_t vertex = 0; vertex < num_vertices; ++vertex) {
+        coordinates.push_back(indexed_graph.get_coordinate(vertex));
+    }
+
+    return std::make_shared<Landmarks>(std::move(coordinates), std::move(landmark_vertices), std::move(distances));
+}
@@ -0,0 +1,21 @@
+#ifndef CAPI_LANDMARK_BUILDER_HPP
+#define CAPI_LANDMARK_BUILDER_HPP
+
+#include <memory>
+
+#include "constants/constants.hpp"
+#include "datastructures/i_graph/i_graph.hpp"
+#include "datastructures/landmarks/landmarks.hpp"
+
+// Picks landmarks spread across a graph and finds their distances to every vertex, with a Dijkstra search from each.
+//
+// Each landmark is the vertex furthest from the landmarks picked before it, starting from the vertex furthest from the
+// graph's best connected vertex, so that they lie around the edges of the graph where they bound distances best.
+// Vertices which none of the landmarks can reach are left out, so that small disconnected parts of the graph do not
+// take landmarks away from the rest.
+class LandmarkBuilder {
+  public:
+    static std::shared_ptr<Landmarks> build(const IGraph &graph, uint32_t num_landmarks = DEFAULT_NUM_LANDMARKS);
+};
+
+#endif // CAPI_LANDMARK_BUILDER_HPP
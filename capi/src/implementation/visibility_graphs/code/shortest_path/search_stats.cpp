@@ -0,0 +1,18 @@
+#include "search_stats.hpp"
+
+void SearchStats::record_search(size_t num_expanded_vertices, size_t num_skipped_heap_entries,
+                                size_t num_relaxed_edges) {
+    _num_searches.fetch_add(1, std::memory_order_relaxed);
+    _num_expanded_vertices.fetch_add(num_expanded_vertices, std::memory_order_relaxed);
+    _num_skipped_heap_entries.fetch_add(num_skipped_heap_entries, std::memory_order_relaxed);
+    _num_relaxed_edges.fetch_add(num_relaxed_edges, std::memory_order_relaxed);
+}
+
+SearchStatsSnapshot SearchStats::snapshot() const {
+    return SearchStatsSnapshot{
+        .num_searches = _num_searches.load(std::memory_order_relaxed),
+        .num_expanded_vertices = _num_expanded_vertices.load(std::memory_order_relaxed),
+        .num_skipped_heap_entries = _num_skipped_heap_entries.load(std::memory_order_relaxed),
+        .num_relaxed_edges = _num_relaxed_edges.load(std::memory_order_relaxed),
+    };
+}
@@ -0,0 +1,30 @@
+#ifndef CAPI_SEARCH_STATS_HPP
+#define CAPI_SEARCH_STATS_HPP
+
+#include <atomic>
+#include <cstddef>
+
+struct SearchStatsSnapshot {
+    size_t num_searches;
+    size_t num_expanded_vertices;
+    // Heap entries popped for vertices already expanded, which would otherwise have been expanded again
+    size_t num_skipped_heap_entries;
+    size_t num_relaxed_edges;
+};
+
+// Work done by shortest path searches, accumulated over every search recording into it. Searches may record from
+// many threads at once, and snapshots may be taken while they run.
+class SearchStats {
+  public:
+    void record_search(size_t num_expanded_vertices, size_t num_skipped_heap_entries, size_t num_relaxed_edges);
+
+    [[nodiscard]] SearchStatsSnapshot snapshot() const;
+
+  private:
+    std::atomic<size_t> _num_searches = 0;
+    std::atomic<size_t> _num_expanded_vertices = 0;
+    std::atomic<size_t> _num_skipped_heap_entries = 0;
+    std::atomic<size_t> _num_relaxed_edges = 0;
+};
+
+#endif // CAPI_SEARCH_STATS_HPP
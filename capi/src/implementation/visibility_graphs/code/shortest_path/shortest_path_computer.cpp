@@ -3,15 +3,22 @@
 //
 
 #include <algorithm>
+#include <cmath>
 #include <queue>
+#include <s2/s2cell_id.h>
+#include <tuple>
+#include <unordered_set>
 #include <iostream>
+#include <numeric>
 #include <fmt/format.h>
 #include <sstream>
 
 #include "coordinate_periodicity/coordinate_periodicity.hpp"
 #include "shortest_path_computer.hpp"
 #include "datastructures/modified_graph/modified_graph.hpp"
+#include "geom/angular_cover/angular_cover.hpp"
 #include "constants/constants.hpp"
+#include "scheduling/work_stealing_scheduler.hpp"
 
 struct AStarHeapElement {
     Coordinate node;
@@ -19,145 +26,1537 @@ struct AStarHeapElement {
     double heuristic_distance_to_destination;
 };
 
-ShortestPathComputer::ShortestPathComputer(const std::shared_ptr<IGraph> &graph) :
-    _graph(graph), _index(graph->get_polygons()), _vistree_gen(graph->get_polygons()) {}
+namespace {
+struct IndexedAStarHeapElement {
+    double priority;
+    double distance_to_source;
+    uint32_t vertex;
+};
+
+// The state of a search from one root over dense vertex ids. A vertex's distance and parent are only set when its
+// generation is the current one, so starting a search resets them in constant time.
+struct SearchFrontier {
+    std::vector<double> distances;
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> settled_generations;
+    uint32_t generation = 0;
+
+    std::vector<IndexedAStarHeapElement> heap;
+
+    void start(size_t num_vertices) {
+        if (generations.size() < num_vertices) {
+            distances.resize(num_vertices);
+            parents.resize(num_vertices);
+            generations.resize(num_vertices, 0);
+            settled_generations.resize(num_vertices, 0);
+        }
+
+        if (++generation == 0) {
+            std::fill(generations.begin(), generations.end(), 0);
+            std::fill(settled_generations.begin(), settled_generations.end(), 0);
+            generation = 1;
+        }
+
+        heap.clear();
+    }
+
+    [[nodiscard]] bool is_reached(uint32_t vertex) const { return generations[vertex] == generation; }
+    [[nodiscard]] bool is_settled(uint32_t vertex) const { return settled_generations[vertex] == generation; }
+
+    // The root is its own parent
+    void reach(uint32_t vertex, double distance, uint32_t parent) {
+        distances[vertex] = distance;
+        parents[vertex] = parent;
+        generations[vertex] = generation;
+    }
+
+    void settle(uint32_t vertex) { settled_generations[vertex] = generation; }
+
+    static bool heap_comparison(const IndexedAStarHeapElement &a, const IndexedAStarHeapElement &b) {
+        return a.priority > b.priority;
+    }
+
+    void push(uint32_t vertex, double distance, double priority) {
+        heap.push_back(IndexedAStarHeapElement{
+            .priority = priority,
+            .distance_to_source = distance,
+            .vertex = vertex,
+        });
+        std::push_heap(heap.begin(), heap.end(), heap_comparison);
+    }
+
+    IndexedAStarHeapElement pop() {
+        std::pop_heap(heap.begin(), heap.end(), heap_comparison);
+        const auto top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+
+    // Drops entries from the top of the heap for settled vertices, and those pushed before their vertex's distance
+    // last shortened, returning how many were dropped
+    size_t discard_stale_entries() {
+        size_t num_discarded = 0;
+        while (!heap.empty() &&
+               (is_settled(heap.front().vertex) || heap.front().distance_to_source > distances[heap.front().vertex])) {
+            pop();
+            ++num_discarded;
+        }
+        return num_discarded;
+    }
+
+    // The vertices from a reached vertex back to the root
+    [[nodiscard]] std::vector<uint32_t> path_to_root(uint32_t vertex) const {
+        auto path = std::vector<uint32_t>{vertex};
+        for (; parents[vertex] != vertex; vertex = parents[vertex]) {
+            path.push_back(parents[vertex]);
+        }
+        return path;
+    }
+};
+
+// The edges of a query endpoint which is not a graph vertex. They are listed for searches leaving the endpoint, and
+// marked on the vertices they lead to for searches entering it.
+struct EndpointLinks {
+    std::vector<IndexedGraph::Neighbor> neighbors;
+    std::vector<uint32_t> link_generations;
+    std::vector<uint8_t> link_meridian_crossings;
+    uint32_t generation = 0;
+
+    void start(size_t num_vertices) {
+        if (link_generations.size() < num_vertices) {
+            link_generations.resize(num_vertices, 0);
+            link_meridian_crossings.resize(num_vertices);
+        }
+
+        if (++generation == 0) {
+            std::fill(link_generations.begin(), link_generations.end(), 0);
+            generation = 1;
+        }
+
+        neighbors.clear();
+    }
+
+    void link(uint32_t vertex, bool is_meridian_crossing) {
+        neighbors.push_back(IndexedGraph::Neighbor{
+            .vertex = vertex,
+            .is_meridian_crossing = is_meridian_crossing,
+        });
+
+        // A vertex visible both directly and across the meridian is reached directly
+        if (link_generations[vertex] == generation) {
+            link_meridian_crossings[vertex] &= is_meridian_crossing;
+        } else {
+            link_generations[vertex] = generation;
+            link_meridian_crossings[vertex] = is_meridian_crossing;
+        }
+    }
+
+    [[nodiscard]] bool is_linked(uint32_t vertex) const { return link_generations[vertex] == generation; }
+};
+
+// For each landmark, its shortest distance to a query endpoint (nearest), and the furthest it is from any of the
+// endpoint's links less that link's length (furthest). Both are its distance to an endpoint which is a graph vertex.
+// Any path from a vertex to the endpoint is at least nearest less the vertex's distance from the landmark, and at least
+// that distance less furthest, as it reaches the endpoint through one of its links.
+struct EndpointLandmarkDistances {
+    std::vector<double> nearest;
+    std::vector<double> furthest;
+};
+
+// Search state reused by every search on a thread
+struct AStarSearchContext {
+    SearchFrontier forward;
+    SearchFrontier backward;
+    EndpointLinks source_links;
+    EndpointLinks destination_links;
+    EndpointLandmarkDistances source_landmark_distances;
+    EndpointLandmarkDistances destination_landmark_distances;
+};
+
+thread_local AStarSearchContext a_star_search_context;
+
+// An edge from a graph vertex to a distance matrix target, which has an edge of no length to itself if it is a vertex
+struct TargetLink {
+    uint32_t target;
+    double length;
+};
+
+// Marks a distance matrix target reached directly from the source rather than through the graph
+constexpr uint32_t NO_VERTEX = UINT32_MAX;
+
+// A fingerprint of the graph vertices visible from an endpoint, whatever order they were found in
+uint64_t visibility_fingerprint(const std::vector<IndexedGraph::Neighbor> &visible_vertices) {
+    auto neighbor_keys = std::vector<uint64_t>();
+    neighbor_keys.reserve(visible_vertices.size());
+    for (const auto &neighbor : visible_vertices) {
+        neighbor_keys.push_back((static_cast<uint64_t>(neighbor.vertex) << 1) | neighbor.is_meridian_crossing);
+    }
+    std::sort(neighbor_keys.begin(), neighbor_keys.end());
+
+    uint64_t fingerprint = neighbor_keys.size();
+    for (const auto key : neighbor_keys) {
+        fingerprint ^= std::hash<uint64_t>()(key) + 0x9e3779b9 + (fingerprint << 6) + (fingerprint >> 2);
+    }
+    return fingerprint;
+}
+} // namespace
+
+struct ShortestPathComputer::IndexedQuery {
+    const IndexedGraph &graph;
+    const AStarSearchContext &context;
+    uint32_t source;
+    uint32_t destination;
+    Coordinate source_coordinate;
+    Coordinate destination_coordinate;
+    // Landmarks bounding distances to and from the endpoints as well as the straight line, or null for the straight
+    // line alone
+    const Landmarks *landmarks;
+
+    [[nodiscard]] bool is_graph_vertex(uint32_t vertex) const { return vertex < graph.get_num_vertices(); }
+
+    [[nodiscard]] const Coordinate &coordinate_of(uint32_t vertex) const {
+        if (is_graph_vertex(vertex)) {
+            return graph.get_coordinate(vertex);
+        }
+        return vertex == source ? source_coordinate : destination_coordinate;
+    }
+
+    // Calls on_neighbor(neighbor, is_meridian_crossing) for each edge of a vertex, including those to and from
+    // endpoints which are not graph vertices. The graph is undirected, so this serves searches in either direction.
+    template <typename OnNeighbor> void for_each_neighbor(uint32_t vertex, const OnNeighbor &on_neighbor) const {
+        if (!is_graph_vertex(vertex)) {
+            const auto &links = vertex == source ? context.source_links : context.destination_links;
+            for (const auto &neighbor : links.neighbors) {
+                on_neighbor(neighbor.vertex, neighbor.is_meridian_crossing);
+            }
+            return;
+        }
+
+        for (const auto &neighbor : graph.get_neighbors(vertex)) {
+            on_neighbor(neighbor.vertex, neighbor.is_meridian_crossing);
+        }
+        if (!is_graph_vertex(source) && context.source_links.is_linked(vertex)) {
+            on_neighbor(source, context.source_links.link_meridian_crossings[vertex]);
+        }
+        if (!is_graph_vertex(destination) && context.destination_links.is_linked(vertex)) {
+            on_neighbor(destination, context.destination_links.link_meridian_crossings[vertex]);
+        }
+    }
+
+    // Lower bounds on the length of any path from a vertex to the destination, and from the source to a vertex. Both
+    // are consistent: they fall by at most the length of any edge, so A* settles vertices at their shortest distances.
+    [[nodiscard]] double distance_to_destination_bound(uint32_t vertex) const {
+        return distance_bound(vertex, destination_coordinate, context.destination_landmark_distances);
+    }
+    [[nodiscard]] double distance_from_source_bound(uint32_t vertex) const {
+        return distance_bound(vertex, source_coordinate, context.source_landmark_distances);
+    }
+
+    [[nodiscard]] std::vector<Coordinate> to_coordinates(const std::vector<uint32_t> &vertices) const {
+        auto coordinates = std::vector<Coordinate>();
+        coordinates.reserve(vertices.size());
+        for (const auto vertex : vertices) {
+            coordinates.push_back(coordinate_of(vertex));
+        }
+        return coordinates;
+    }
+
+  private:
+    // Landmark bounds are skipped where either end cannot be reached from the landmark. Endpoints which are not graph
+    // vertices have no landmark distances of their own, so only the straight line bounds the distance from them.
+    [[nodiscard]] double distance_bound(uint32_t vertex, const Coordinate &endpoint_coordinate,
+                                        const EndpointLandmarkDistances &endpoint_distances) const {
+        auto bound = ShortestPathComputer::heuristic_distance_measurement(coordinate_of(vertex), endpoint_coordinate);
+        if (landmarks == nullptr || !is_graph_vertex(vertex)) {
+            return bound;
+        }
+
+        const auto num_landmarks = landmarks->get_num_landmarks();
+        const auto *vertex_distances = landmarks->get_distances().data() + static_cast<size_t>(vertex) * num_landmarks;
+        for (uint32_t landmark = 0; landmark < num_landmarks; ++landmark) {
+            const auto distance = vertex_distances[landmark];
+            if (std::isfinite(distance) && std::isfinite(endpoint_distances.nearest[landmark])) {
+                bound = std::max({bound, endpoint_distances.nearest[landmark] - distance,
+                                  distance - endpoint_distances.furthest[landmark]});
+            }
+        }
+        return bound;
+    }
+};
+
+ShortestPathComputer::ShortestPathComputer(const std::shared_ptr<IGraph> &graph,
+                                           const std::shared_ptr<IGraph> &coarse_graph, double refinement_radius,
+                                           const std::shared_ptr<ContractionHierarchy> &contraction_hierarchy,
+                                           const std::shared_ptr<Landmarks> &landmarks,
+                                           size_t endpoint_cache_capacity, size_t path_cache_capacity,
+                                           double path_cache_cell_size) :
+    _graph(graph), _indexed_graph(*graph), _coarse_graph(coarse_graph), _refinement_radius(refinement_radius),
+    _contraction_hierarchy(contraction_hierarchy), _landmarks(landmarks), _index(graph->get_polygons()),
+    _vistree_gen(graph->get_polygons()),
+    _endpoint_cache(std::make_unique<LruCache<Coordinate, CachedEndpoint>>(endpoint_cache_capacity)),
+    _path_cache_cell_size(path_cache_cell_size),
+    _path_cache(std::make_unique<LruCache<PathCacheKey, CachedPath, PathCacheKeyHash>>(path_cache_capacity)) {
+    if (path_cache_cell_size <= 0) {
+        throw std::runtime_error(
+            fmt::format("The path cache cell size must be positive, not {}", path_cache_cell_size));
+    }
+    if (_contraction_hierarchy != nullptr) {
+        check_prebuilt_vertices("Contraction hierarchy", _contraction_hierarchy->get_coordinates());
+    }
+    if (_landmarks != nullptr) {
+        check_prebuilt_vertices("Landmark table", _landmarks->get_coordinates());
+    }
+}
+
+void ShortestPathComputer::check_prebuilt_vertices(const std::string &description,
+                                                   const std::vector<Coordinate> &coordinates) const {
+    if (coordinates.size() != _indexed_graph.get_num_vertices()) {
+        throw std::runtime_error(fmt::format("{} has {} vertices but the graph has {}", description,
+                                             coordinates.size(), _indexed_graph.get_num_vertices()));
+    }
+    for (uint32_t vertex = 0; vertex < coordinates.size(); ++vertex) {
+        if (coordinates[vertex] != _indexed_graph.get_coordinate(vertex)) {
+            throw std::runtime_error(fmt::format("{} vertex {} is {} but the graph's is {}", description, vertex,
+                                                 coordinates[vertex].to_string_representation(),
+                                                 _indexed_graph.get_coordinate(vertex).to_string_representation()));
+        }
+    }
+}
 
 std::vector<Coordinate> ShortestPathComputer::shortest_path(const Coordinate &source, const Coordinate &destination,
                                                             double maximum_distance_to_search_from_source,
                                                             bool correct_vertices_on_land,
-                                                            double a_star_greediness_weighting) const {
+                                                            double a_star_greediness_weighting,
+                                                            SearchAlgorithm search_algorithm,
+                                                            SearchHeuristic heuristic,
+                                                            const std::shared_ptr<SearchStats> &stats) const {
     const auto normalized_source = coordinate_from_periodic_coordinate(source);
     const auto normalized_destination = coordinate_from_periodic_coordinate(destination);
 
-    const auto land_corrections =
-        handle_land_collisions(normalized_source, normalized_destination, correct_vertices_on_land);
+    return corrected_shortest_path(
+        handle_land_collisions(normalized_source, normalized_destination, correct_vertices_on_land),
+        maximum_distance_to_search_from_source, a_star_greediness_weighting, search_algorithm, heuristic, stats,
+        EndpointAttachments{});
+}
+
+std::vector<Coordinate> ShortestPathComputer::corrected_shortest_path(const LandCollisionCorrection &land_corrections,
+                                                                     double maximum_distance_to_search_from_source,
+                                                                     double a_star_greediness_weighting,
+                                                                     SearchAlgorithm search_algorithm,
+                                                                     SearchHeuristic heuristic,
+                                                                     const std::shared_ptr<SearchStats> &stats,
+                                                                     const EndpointAttachments &attachments) const {
     const auto &corrected_source = land_corrections.corrected_source;
     const auto &corrected_dest = land_corrections.corrected_dest;
 
-    auto intersections = _index.intersect_with_segments(LineSegment(corrected_source, corrected_dest));
-    size_t num_intersections_excluding_corrections = 0;
-    for (const auto &intersection : intersections) {
-        if ((!land_corrections.corrected_source_edge.has_value() || intersection != land_corrections.corrected_source_edge.value()) &&
-        (!land_corrections.corrected_dest_edge.has_value() || intersection != land_corrections.corrected_dest_edge.value())) {
-            ++num_intersections_excluding_corrections;
+    if (are_endpoints_visible(land_corrections)) {
+        return std::vector<Coordinate>{corrected_source, corrected_dest};
+    }
+
+    if (_path_cache->get_capacity() > 0 && !_indexed_graph.find_vertex(corrected_source).has_value() &&
+        !_indexed_graph.find_vertex(corrected_dest).has_value()) {
+        return cached_shortest_path(land_corrections, maximum_distance_to_search_from_source,
+                                    a_star_greediness_weighting, search_algorithm, heuristic, stats, attachments);
+    }
+
+    return uncached_shortest_path(land_corrections, maximum_distance_to_search_from_source, a_star_greediness_weighting,
+                                  search_algorithm, heuristic, stats, attachments);
+}
+
+std::vector<Coordinate> ShortestPathComputer::cached_shortest_path(const LandCollisionCorrection &land_corrections,
+                                                                  double maximum_distance_to_search_from_source,
+                                                                  double a_star_greediness_weighting,
+                                                                  SearchAlgorithm search_algorithm,
+                                                                  SearchHeuristic heuristic,
+                                                                  const std::shared_ptr<SearchStats> &stats,
+                                                                  const EndpointAttachments &attachments) const {
+    // Remembered paths are checked against and joined through the graph vertices the endpoints see, so those are
+    // found ahead of the search, which then reuses them
+    auto found_source_vertices = std::vector<IndexedGraph::Neighbor>();
+    auto found_destination_vertices = std::vector<IndexedGraph::Neighbor>();
+    if (attachments.source == nullptr) {
+        found_source_vertices =
+            find_visible_graph_vertices(land_corrections.corrected_source, land_corrections.corrected_source_edge);
+    }
+    if (attachments.destination == nullptr) {
+        found_destination_vertices =
+            find_visible_graph_vertices(land_corrections.corrected_dest, land_corrections.corrected_dest_edge);
+    }
+    const auto &source_visible_vertices = attachments.source != nullptr ? *attachments.source : found_source_vertices;
+    const auto &destination_visible_vertices =
+        attachments.destination != nullptr ? *attachments.destination : found_destination_vertices;
+
+    const auto key = path_cache_key(land_corrections, maximum_distance_to_search_from_source,
+                                    a_star_greediness_weighting, search_algorithm, heuristic);
+    const auto source_fingerprint = visibility_fingerprint(source_visible_vertices);
+    const auto destination_fingerprint = visibility_fingerprint(destination_visible_vertices);
+    const auto cached_path = _path_cache->find(key);
+    if (cached_path != nullptr && cached_path->source_visibility_fingerprint == source_fingerprint &&
+        cached_path->destination_visibility_fingerprint == destination_fingerprint) {
+        auto path = join_cached_path(*cached_path, land_corrections.corrected_source, source_visible_vertices,
+                                     land_corrections.corrected_dest, destination_visible_vertices,
+                                     maximum_distance_to_search_from_source);
+        if (path.has_value()) {
+            return std::move(path.value());
         }
     }
 
-    if (num_intersections_excluding_corrections == 0) {
-        return std::vector<Coordinate>{corrected_source, corrected_dest};
+    auto path = uncached_shortest_path(land_corrections, maximum_distance_to_search_from_source,
+                                       a_star_greediness_weighting, search_algorithm, heuristic, stats,
+                                       EndpointAttachments{
+                                           .source = &source_visible_vertices,
+                                           .destination = &destination_visible_vertices,
+                                       });
+
+    auto new_cached_path = CachedPath{
+        .source_visibility_fingerprint = source_fingerprint,
+        .destination_visibility_fingerprint = destination_fingerprint,
+    };
+    for (size_t i = 1; i + 1 < path.size(); ++i) {
+        const auto vertex = _indexed_graph.find_vertex(path[i]);
+        if (!vertex.has_value()) {
+            return path;
+        }
+        new_cached_path.vertices.push_back(vertex.value());
+        new_cached_path.distances_along.push_back(
+            new_cached_path.distances_along.empty()
+                ? 0.0
+                : new_cached_path.distances_along.back() + heuristic_distance_measurement(path[i - 1], path[i]));
+    }
+    if (!new_cached_path.vertices.empty()) {
+        // The key is held by both the cache's map and its recency list
+        const auto size_in_bytes = 2 * sizeof(PathCacheKey) + sizeof(CachedPath) +
+                                   new_cached_path.vertices.size() * (sizeof(uint32_t) + sizeof(double));
+        _path_cache->insert(key, std::make_shared<const CachedPath>(std::move(new_cached_path)), size_in_bytes);
+    }
+    return path;
+}
+
+std::optional<std::vector<Coordinate>> ShortestPathComputer::join_cached_path(
+    const CachedPath &cached_path, const Coordinate &source,
+    const std::vector<IndexedGraph::Neighbor> &source_visible_vertices, const Coordinate &destination,
+    const std::vector<IndexedGraph::Neighbor> &destination_visible_vertices,
+    double maximum_distance_to_search_from_source) const {
+    if (heuristic_distance_measurement(source, destination) > maximum_distance_to_search_from_source) {
+        return std::nullopt;
+    }
+
+    const auto sorted_vertices = [](const std::vector<IndexedGraph::Neighbor> &visible_vertices) {
+        auto vertices = std::vector<uint32_t>();
+        vertices.reserve(visible_vertices.size());
+        for (const auto &neighbor : visible_vertices) {
+            vertices.push_back(neighbor.vertex);
+        }
+        std::sort(vertices.begin(), vertices.end());
+        return vertices;
+    };
+    const auto source_vertices = sorted_vertices(source_visible_vertices);
+    const auto destination_vertices = sorted_vertices(destination_visible_vertices);
+
+    // Joins the path at the ith and leaves it at the jth vertex for the i <= j giving the shortest path. For each j,
+    // the best i so far is the one with the shortest leg from the source less the distance along the path to it.
+    auto best_length = INFINITY;
+    size_t best_entry = 0;
+    size_t best_exit = 0;
+    auto best_entry_cost = INFINITY;
+    size_t entry = 0;
+    for (size_t j = 0; j < cached_path.vertices.size(); ++j) {
+        const auto vertex = cached_path.vertices[j];
+        const auto &coordinate = _indexed_graph.get_coordinate(vertex);
+        const auto distance_from_source = heuristic_distance_measurement(source, coordinate);
+        if (distance_from_source > maximum_distance_to_search_from_source) {
+            best_entry_cost = INFINITY;
+            continue;
+        }
+
+        if (std::binary_search(source_vertices.begin(), source_vertices.end(), vertex) &&
+            distance_from_source - cached_path.distances_along[j] < best_entry_cost) {
+            best_entry_cost = distance_from_source - cached_path.distances_along[j];
+            entry = j;
+        }
+        if (std::isfinite(best_entry_cost) &&
+            std::binary_search(destination_vertices.begin(), destination_vertices.end(), vertex)) {
+            const auto length = best_entry_cost + cached_path.distances_along[j] +
+                                heuristic_distance_measurement(coordinate, destination);
+            if (length < best_length) {
+                best_length = length;
+                best_entry = entry;
+                best_exit = j;
+            }
+        }
+    }
+
+    if (!std::isfinite(best_length)) {
+        return std::nullopt;
+    }
+
+    auto path = std::vector<Coordinate>{source};
+    for (auto j = best_entry; j <= best_exit; ++j) {
+        path.push_back(_indexed_graph.get_coordinate(cached_path.vertices[j]));
+    }
+    path.push_back(destination);
+    return path;
+}
+
+ShortestPathComputer::PathCacheKey
+ShortestPathComputer::path_cache_key(const LandCollisionCorrection &land_corrections,
+                                     double maximum_distance_to_search_from_source, double a_star_greediness_weighting,
+                                     SearchAlgorithm search_algorithm, SearchHeuristic heuristic) const {
+    const auto cell = [this](double degrees) {
+        return static_cast<int64_t>(std::floor(degrees / _path_cache_cell_size));
+    };
+    return PathCacheKey{
+        .source_cell_x = cell(land_corrections.corrected_source.get_longitude()),
+        .source_cell_y = cell(land_corrections.corrected_source.get_latitude()),
+        .destination_cell_x = cell(land_corrections.corrected_dest.get_longitude()),
+        .destination_cell_y = cell(land_corrections.corrected_dest.get_latitude()),
+        .maximum_distance_to_search_from_source = maximum_distance_to_search_from_source,
+        .a_star_greediness_weighting = a_star_greediness_weighting,
+        .search_algorithm = search_algorithm,
+        .heuristic = heuristic,
+    };
+}
+
+bool ShortestPathComputer::PathCacheKey::operator==(const PathCacheKey &other) const {
+    return std::tie(source_cell_x, source_cell_y, destination_cell_x, destination_cell_y,
+                    maximum_distance_to_search_from_source, a_star_greediness_weighting, search_algorithm,
+                    heuristic) == std::tie(other.source_cell_x, other.source_cell_y, other.destination_cell_x,
+                                           other.destination_cell_y, other.maximum_distance_to_search_from_source,
+                                           other.a_star_greediness_weighting, other.search_algorithm, other.heuristic);
+}
+
+size_t ShortestPathComputer::PathCacheKeyHash::operator()(const PathCacheKey &key) const {
+    size_t seed = 0;
+    const auto combine = [&seed](size_t val) { seed ^= val + 0x9e3779b9 + (seed << 6) + (seed >> 2); };
+    combine(std::hash<int64_t>()(key.source_cell_x));
+    combine(std::hash<int64_t>()(key.source_cell_y));
+    combine(std::hash<int64_t>()(key.destination_cell_x));
+    combine(std::hash<int64_t>()(key.destination_cell_y));
+    combine(std::hash<double>()(key.maximum_distance_to_search_from_source));
+    combine(std::hash<double>()(key.a_star_greediness_weighting));
+    combine(std::hash<int>()(key.search_algorithm));
+    combine(std::hash<int>()(key.heuristic));
+    return seed;
+}
+
+std::vector<Coordinate> ShortestPathComputer::uncached_shortest_path(const LandCollisionCorrection &land_corrections,
+                                                                    double maximum_distance_to_search_from_source,
+                                                                    double a_star_greediness_weighting,
+                                                                    SearchAlgorithm search_algorithm,
+                                                                    SearchHeuristic heuristic,
+                                                                    const std::shared_ptr<SearchStats> &stats,
+                                                                    const EndpointAttachments &attachments) const {
+    const auto &corrected_source = land_corrections.corrected_source;
+    const auto &corrected_dest = land_corrections.corrected_dest;
+
+    if (_coarse_graph != nullptr && search_algorithm != SearchAlgorithm::CONTRACTION_HIERARCHY &&
+        heuristic_distance_measurement(corrected_source, corrected_dest) > 2 * _refinement_radius) {
+        const auto modified_graph = create_modified_graph(land_corrections);
+        auto path = hierarchical_shortest_path(*modified_graph, corrected_source, corrected_dest,
+                                               maximum_distance_to_search_from_source, a_star_greediness_weighting,
+                                               stats);
+        if (path.has_value()) {
+            return std::move(path.value());
+        }
+    }
+
+    return detailed_shortest_path(land_corrections, maximum_distance_to_search_from_source,
+                                  a_star_greediness_weighting, search_algorithm, heuristic, stats, attachments);
+}
+
+std::vector<BatchInterpolateResult>
+ShortestPathComputer::shortest_paths(const std::vector<std::pair<Coordinate, Coordinate>> &source_dest_pairs,
+                                     double maximum_distance_to_search_from_source, bool correct_vertices_on_land,
+                                     double a_star_greediness_weighting, SearchAlgorithm search_algorithm,
+                                     SearchHeuristic heuristic, const std::shared_ptr<SearchStats> &stats) const {
+    auto endpoint_ids = std::unordered_map<Coordinate, uint32_t>();
+    auto endpoints = std::vector<Coordinate>();
+    const auto find_endpoint_id = [&](const Coordinate &endpoint) {
+        const auto [iter, is_new] =
+            endpoint_ids.emplace(coordinate_from_periodic_coordinate(endpoint), endpoints.size());
+        if (is_new) {
+            endpoints.push_back(iter->first);
+        }
+        return iter->second;
+    };
+    auto pair_endpoint_ids = std::vector<std::pair<uint32_t, uint32_t>>();
+    pair_endpoint_ids.reserve(source_dest_pairs.size());
+    for (const auto &[source, destination] : source_dest_pairs) {
+        const auto source_id = find_endpoint_id(source);
+        pair_endpoint_ids.emplace_back(source_id, find_endpoint_id(destination));
+    }
+
+    // Why an endpoint could not be moved off land or linked to the graph, for every pair using it
+    auto endpoint_error_msgs = std::vector<std::optional<std::string>>(endpoints.size());
+    auto corrected_endpoints = std::vector<LandCorrectedEndpoint>(endpoints.size());
+    WorkStealingScheduler().run(endpoints.size(), 64, [&](size_t i, size_t) {
+        try {
+            corrected_endpoints[i] = correct_endpoint(endpoints[i], correct_vertices_on_land);
+        } catch (const std::exception &e) {
+            endpoint_error_msgs[i] = std::string(e.what());
+        }
+    });
+
+    // Endpoints moved onto the same point of the same coastline edge are the same endpoint
+    auto representative_ids = std::vector<uint32_t>(endpoints.size());
+    auto ids_by_corrected_coordinate = std::unordered_map<Coordinate, std::vector<uint32_t>>();
+    for (uint32_t i = 0; i < endpoints.size(); ++i) {
+        if (endpoint_error_msgs[i].has_value()) {
+            representative_ids[i] = i;
+            continue;
+        }
+
+        auto &candidates = ids_by_corrected_coordinate[corrected_endpoints[i].coordinate];
+        const auto iter = std::find_if(candidates.begin(), candidates.end(), [&](uint32_t candidate) {
+            return corrected_endpoints[candidate].blocking_edge == corrected_endpoints[i].blocking_edge;
+        });
+        if (iter == candidates.end()) {
+            candidates.push_back(i);
+            representative_ids[i] = i;
+        } else {
+            representative_ids[i] = *iter;
+        }
+    }
+
+    auto query_ids = std::unordered_map<uint64_t, size_t>();
+    auto queries = std::vector<std::pair<uint32_t, uint32_t>>();
+    auto pair_query_ids = std::vector<size_t>();
+    pair_query_ids.reserve(source_dest_pairs.size());
+    for (const auto &[source_id, destination_id] : pair_endpoint_ids) {
+        const auto query = std::make_pair(representative_ids[source_id], representative_ids[destination_id]);
+        const auto [iter, is_new] =
+            query_ids.emplace((static_cast<uint64_t>(query.first) << 32) | query.second, queries.size());
+        if (is_new) {
+            queries.push_back(query);
+        }
+        pair_query_ids.push_back(iter->second);
+    }
+
+    // Only endpoints of several queries are linked ahead of time, as the rest would be linked once either way and
+    // holding their links for the whole batch would take a lot of memory
+    auto num_endpoint_queries = std::vector<uint32_t>(endpoints.size(), 0);
+    for (const auto &[source_id, destination_id] : queries) {
+        ++num_endpoint_queries[source_id];
+        ++num_endpoint_queries[destination_id];
+    }
+    auto attached_endpoint_ids = std::vector<uint32_t>();
+    for (uint32_t i = 0; i < endpoints.size(); ++i) {
+        const auto &endpoint = corrected_endpoints[i];
+        if (num_endpoint_queries[i] > 1 && !endpoint_error_msgs[i].has_value() &&
+            (correct_vertices_on_land || !endpoint.is_on_land) &&
+            !_indexed_graph.find_vertex(endpoint.coordinate).has_value()) {
+            attached_endpoint_ids.push_back(i);
+        }
+    }
+    auto attachments = std::vector<std::optional<std::vector<IndexedGraph::Neighbor>>>(endpoints.size());
+    WorkStealingScheduler().run(attached_endpoint_ids.size(), 1, [&](size_t i, size_t) {
+        const auto endpoint_id = attached_endpoint_ids[i];
+        const auto &endpoint = corrected_endpoints[endpoint_id];
+        try {
+            attachments[endpoint_id] = find_visible_graph_vertices(endpoint.coordinate, endpoint.blocking_edge);
+        } catch (const std::exception &e) {
+            endpoint_error_msgs[endpoint_id] = std::string(e.what());
+        }
+    });
+
+    // S2 cell ids follow a Hilbert curve, so running queries in order of their sources' cells runs queries from the
+    // same source together and nearby sources after one another, which keeps the graph regions searched in cache
+    auto cell_ids = std::vector<uint64_t>(endpoints.size());
+    for (uint32_t i = 0; i < endpoints.size(); ++i) {
+        cell_ids[i] = S2CellId(corrected_endpoints[i].coordinate.to_s2_point()).id();
+    }
+    auto query_order = std::vector<size_t>(queries.size());
+    std::iota(query_order.begin(), query_order.end(), 0);
+    std::sort(query_order.begin(), query_order.end(), [&](size_t a, size_t b) {
+        const auto &[a_source, a_destination] = queries[a];
+        const auto &[b_source, b_destination] = queries[b];
+        return std::make_tuple(cell_ids[a_source], a_source, cell_ids[a_destination], a_destination) <
+               std::make_tuple(cell_ids[b_source], b_source, cell_ids[b_destination], b_destination);
+    });
+
+    auto query_paths = std::vector<BatchInterpolateResult>(queries.size());
+
+    // Path queries vary wildly in cost, so they are scheduled one at a time
+    WorkStealingScheduler().run(queries.size(), 1, [&](size_t i, size_t) {
+        const auto query_id = query_order[i];
+        const auto &[source_id, destination_id] = queries[query_id];
+        const auto endpoint_attachment = [&](uint32_t endpoint_id) {
+            return attachments[endpoint_id].has_value() ? &attachments[endpoint_id].value() : nullptr;
+        };
+
+        const auto &endpoint_error_msg = endpoint_error_msgs[source_id].has_value()
+                                             ? endpoint_error_msgs[source_id]
+                                             : endpoint_error_msgs[destination_id];
+        if (endpoint_error_msg.has_value()) {
+            query_paths[query_id] = BatchInterpolateResult{
+                .path = std::nullopt,
+                .error_msg = endpoint_error_msg,
+            };
+            return;
+        }
+
+        try {
+            query_paths[query_id] = BatchInterpolateResult{
+                .path = std::make_optional(corrected_shortest_path(
+                    combine_land_corrections(corrected_endpoints[source_id], corrected_endpoints[destination_id],
+                                             correct_vertices_on_land),
+                    maximum_distance_to_search_from_source, a_star_greediness_weighting, search_algorithm,
+                    heuristic, stats,
+                    EndpointAttachments{
+                        .source = endpoint_attachment(source_id),
+                        .destination = endpoint_attachment(destination_id),
+                    })),
+                .error_msg = std::nullopt,
+            };
+        } catch (const std::exception &e) {
+            query_paths[query_id] = BatchInterpolateResult{
+                .path = std::nullopt,
+                .error_msg = std::string(e.what()),
+            };
+        }
+    });
+
+    auto paths = std::vector<BatchInterpolateResult>();
+    paths.reserve(source_dest_pairs.size());
+    for (const auto query_id : pair_query_ids) {
+        paths.push_back(query_paths[query_id]);
+    }
+    return paths;
+}
+
+DistanceMatrix ShortestPathComputer::distance_matrix(const std::vector<Coordinate> &sources,
+                                                     const std::vector<Coordinate> &targets,
+                                                     double maximum_distance_to_search_from_source,
+                                                     bool correct_vertices_on_land, bool include_paths,
+                                                     const std::shared_ptr<SearchStats> &stats) const {
+    auto matrix = DistanceMatrix{
+        .distances = std::vector<std::vector<double>>(sources.size(), std::vector<double>(targets.size(), INFINITY)),
+        .paths = std::vector<std::vector<std::optional<std::vector<Coordinate>>>>(
+            include_paths ? sources.size() : 0, std::vector<std::optional<std::vector<Coordinate>>>(targets.size())),
+        .source_error_msgs = std::vector<std::optional<std::string>>(sources.size()),
+        .target_error_msgs = std::vector<std::optional<std::string>>(targets.size()),
+    };
+
+    // Endpoints are moved off land as they would be for a single path
+    const auto correct_endpoints = [&](const std::vector<Coordinate> &endpoints,
+                                       std::vector<std::optional<std::string>> &error_msgs) {
+        auto corrected_endpoints = std::vector<std::pair<Coordinate, std::optional<LineSegment>>>();
+        corrected_endpoints.reserve(endpoints.size());
+        for (size_t i = 0; i < endpoints.size(); ++i) {
+            const auto endpoint = coordinate_from_periodic_coordinate(endpoints[i]);
+            const auto corrected_endpoint = correct_endpoint(endpoint, true);
+            if (corrected_endpoint.is_on_land && !correct_vertices_on_land) {
+                error_msgs[i] = fmt::format("Endpoint is on land: {}", endpoint.to_string_representation());
+            }
+            corrected_endpoints.emplace_back(corrected_endpoint.coordinate, corrected_endpoint.blocking_edge);
+        }
+        return corrected_endpoints;
+    };
+    const auto corrected_sources = correct_endpoints(sources, matrix.source_error_msgs);
+    const auto corrected_targets = correct_endpoints(targets, matrix.target_error_msgs);
+
+    // The links of every target, listed by the graph vertex they lead from, with the links of vertex i at
+    // target_links[target_link_offsets[i]] to target_links[target_link_offsets[i + 1] - 1]
+    const auto num_graph_vertices = _indexed_graph.get_num_vertices();
+    auto links_of_targets = std::vector<std::vector<IndexedGraph::Neighbor>>(targets.size());
+    WorkStealingScheduler().run(targets.size(), 1, [&](size_t j, size_t) {
+        if (matrix.target_error_msgs[j].has_value()) {
+            return;
+        }
+
+        const auto &[target, blocking_edge] = corrected_targets[j];
+        const auto vertex = _indexed_graph.find_vertex(target);
+        links_of_targets[j] = vertex.has_value() ? std::vector<IndexedGraph::Neighbor>{IndexedGraph::Neighbor{
+                                                       .vertex = vertex.value(),
+                                                       .is_meridian_crossing = false,
+                                                   }}
+                                                 : find_visible_graph_vertices(target, blocking_edge);
+    });
+    auto target_link_offsets = std::vector<size_t>(num_graph_vertices + 1, 0);
+    for (const auto &links : links_of_targets) {
+        for (const auto &link : links) {
+            ++target_link_offsets[link.vertex + 1];
+        }
+    }
+    std::partial_sum(target_link_offsets.begin(), target_link_offsets.end(), target_link_offsets.begin());
+    auto target_links = std::vector<TargetLink>(target_link_offsets.back());
+    auto next_target_links = std::vector<size_t>(target_link_offsets.begin(), target_link_offsets.end() - 1);
+    for (uint32_t j = 0; j < targets.size(); ++j) {
+        for (const auto &link : links_of_targets[j]) {
+            target_links[next_target_links[link.vertex]++] = TargetLink{
+                .target = j,
+                .length = distance_measurement(corrected_targets[j].first,
+                                               _indexed_graph.get_coordinate(link.vertex), link.is_meridian_crossing),
+            };
+        }
+    }
+
+    WorkStealingScheduler().run(sources.size(), 1, [&](size_t i, size_t) {
+        if (matrix.source_error_msgs[i].has_value()) {
+            return;
+        }
+
+        const auto &[source, source_edge] = corrected_sources[i];
+        auto &distances = matrix.distances[i];
+        auto target_vertices = std::vector<uint32_t>(targets.size(), NO_VERTEX);
+
+        // Targets the source can see are reached directly, as they would be for a single path, and those further than
+        // the maximum distance are not reached at all. The search goes on until the rest are settled.
+        auto pending_targets = std::vector<uint32_t>();
+        auto is_searched_for = std::vector<uint8_t>(targets.size(), false);
+        for (uint32_t j = 0; j < targets.size(); ++j) {
+            if (matrix.target_error_msgs[j].has_value()) {
+                continue;
+            }
+
+            const auto &[target, target_edge] = corrected_targets[j];
+            if (are_endpoints_visible(LandCollisionCorrection{
+                    .corrected_source = source,
+                    .corrected_dest = target,
+                    .corrected_source_edge = source_edge,
+                    .corrected_dest_edge = target_edge,
+                })) {
+                distances[j] = distance_measurement(source, target, false);
+            } else if (heuristic_distance_measurement(source, target) <= maximum_distance_to_search_from_source) {
+                pending_targets.push_back(j);
+                is_searched_for[j] = true;
+            }
+        }
+
+        // The search has no destination of its own, so the destination is left unlinked
+        auto &context = a_star_search_context;
+        const auto query = IndexedQuery{
+            .graph = _indexed_graph,
+            .context = context,
+            .source = _indexed_graph.find_vertex(source).value_or(num_graph_vertices),
+            .destination = num_graph_vertices + 1,
+            .source_coordinate = source,
+            .destination_coordinate = source,
+            .landmarks = nullptr,
+        };
+        if (!query.is_graph_vertex(query.source)) {
+            context.source_links.start(num_graph_vertices);
+            for (const auto &neighbor : find_visible_graph_vertices(source, source_edge)) {
+                context.source_links.link(neighbor.vertex, neighbor.is_meridian_crossing);
+            }
+        }
+        context.destination_links.start(num_graph_vertices);
+
+        auto &frontier = context.forward;
+        frontier.start(num_graph_vertices + 2);
+        frontier.reach(query.source, 0, query.source);
+        frontier.push(query.source, 0, 0);
+
+        size_t num_expanded_vertices = 0;
+        size_t num_skipped_heap_entries = 0;
+        size_t num_relaxed_edges = 0;
+        while (!pending_targets.empty()) {
+            num_skipped_heap_entries += frontier.discard_stale_entries();
+            if (frontier.heap.empty()) {
+                break;
+            }
+
+            // Targets reached no further than the vertex about to be settled cannot be reached any shorter
+            const auto top = frontier.pop();
+            pending_targets.erase(std::remove_if(pending_targets.begin(), pending_targets.end(),
+                                                 [&](uint32_t j) { return distances[j] <= top.distance_to_source; }),
+                                  pending_targets.end());
+            if (pending_targets.empty()) {
+                break;
+            }
+            frontier.settle(top.vertex);
+            ++num_expanded_vertices;
+
+            if (query.is_graph_vertex(top.vertex)) {
+                for (size_t k = target_link_offsets[top.vertex]; k < target_link_offsets[top.vertex + 1]; ++k) {
+                    const auto &link = target_links[k];
+                    const auto target_distance = top.distance_to_source + link.length;
+                    if (is_searched_for[link.target] && target_distance < distances[link.target]) {
+                        distances[link.target] = target_distance;
+                        target_vertices[link.target] = top.vertex;
+                    }
+                }
+            }
+
+            const auto &top_coordinate = query.coordinate_of(top.vertex);
+            query.for_each_neighbor(top.vertex, [&](uint32_t neighbor, bool is_meridian_crossing) {
+                ++num_relaxed_edges;
+                if (frontier.is_settled(neighbor)) {
+                    return;
+                }
+
+                const auto &neighbor_coordinate = query.coordinate_of(neighbor);
+                const auto neighbor_dist_to_source =
+                    top.distance_to_source +
+                    distance_measurement(neighbor_coordinate, top_coordinate, is_meridian_crossing);
+                if (heuristic_distance_measurement(source, neighbor_coordinate) >
+                        maximum_distance_to_search_from_source ||
+                    (frontier.is_reached(neighbor) && frontier.distances[neighbor] <= neighbor_dist_to_source)) {
+                    return;
+                }
+
+                frontier.reach(neighbor, neighbor_dist_to_source, top.vertex);
+                frontier.push(neighbor, neighbor_dist_to_source, neighbor_dist_to_source);
+            });
+        }
+
+        if (stats != nullptr) {
+            stats->record_search(num_expanded_vertices, num_skipped_heap_entries, num_relaxed_edges);
+        }
+
+        if (!include_paths) {
+            return;
+        }
+        for (uint32_t j = 0; j < targets.size(); ++j) {
+            if (!std::isfinite(distances[j])) {
+                continue;
+            }
+
+            const auto &target = corrected_targets[j].first;
+            if (target_vertices[j] == NO_VERTEX) {
+                matrix.paths[i][j] = std::vector<Coordinate>{source, target};
+                continue;
+            }
+
+            auto path = query.to_coordinates(frontier.path_to_root(target_vertices[j]));
+            std::reverse(path.begin(), path.end());
+            if (path.back() != target) {
+                path.push_back(target);
+            }
+            matrix.paths[i][j] = std::move(path);
+        }
+    });
+
+    return matrix;
+}
+
+std::vector<Coordinate> ShortestPathComputer::detailed_shortest_path(const LandCollisionCorrection &land_corrections,
+                                                                    double maximum_distance_to_search_from_source,
+                                                                    double a_star_greediness_weighting,
+                                                                    SearchAlgorithm search_algorithm,
+                                                                    SearchHeuristic heuristic,
+                                                                    const std::shared_ptr<SearchStats> &stats,
+                                                                    const EndpointAttachments &attachments) const {
+    if (search_algorithm == SearchAlgorithm::CONTRACTION_HIERARCHY && _contraction_hierarchy == nullptr) {
+        throw std::runtime_error("A contraction hierarchy search needs the computer to be given a contraction "
+                                 "hierarchy");
+    }
+    if (heuristic == SearchHeuristic::LANDMARKS && _landmarks == nullptr) {
+        throw std::runtime_error("The landmark heuristic needs the computer to be given landmarks");
+    }
+
+    const auto query = index_query(land_corrections, heuristic, attachments);
+    auto path = std::optional<std::vector<Coordinate>>();
+    switch (search_algorithm) {
+    case SearchAlgorithm::A_STAR:
+        path = a_star_search(query, maximum_distance_to_search_from_source, a_star_greediness_weighting, stats);
+        break;
+    case SearchAlgorithm::BIDIRECTIONAL_A_STAR:
+        path = bidirectional_a_star_search(query, maximum_distance_to_search_from_source, a_star_greediness_weighting,
+                                           stats);
+        break;
+    case SearchAlgorithm::CONTRACTION_HIERARCHY:
+        path = contraction_hierarchy_search(query, stats);
+
+        // The hierarchy's shortcuts skip over vertices, so the search cannot keep within a maximum distance itself.
+        // The shortest path is also the shortest within the distance if it keeps within it.
+        if (path.has_value() &&
+            std::any_of(path.value().begin(), path.value().end(), [&](const Coordinate &vertex) {
+                return heuristic_distance_measurement(query.source_coordinate, vertex) >
+                       maximum_distance_to_search_from_source;
+            })) {
+            path = a_star_search(query, maximum_distance_to_search_from_source, a_star_greediness_weighting, stats);
+        }
+        break;
+    }
+
+    if (!path.has_value()) {
+        throw std::runtime_error(fmt::format("Could not find a shortest path. "
+                                             "Source: {}. "
+                                             "Destination: {}. ",
+                                             land_corrections.corrected_source.to_string_representation(),
+                                             land_corrections.corrected_dest.to_string_representation()));
+    }
+
+    return std::move(path.value());
+}
+
+ShortestPathComputer::IndexedQuery
+ShortestPathComputer::index_query(const LandCollisionCorrection &land_corrections, SearchHeuristic heuristic,
+                                  const EndpointAttachments &attachments) const {
+    const auto num_graph_vertices = _indexed_graph.get_num_vertices();
+    auto &context = a_star_search_context;
+    const auto query = IndexedQuery{
+        .graph = _indexed_graph,
+        .context = context,
+        .source = _indexed_graph.find_vertex(land_corrections.corrected_source).value_or(num_graph_vertices),
+        .destination = _indexed_graph.find_vertex(land_corrections.corrected_dest).value_or(num_graph_vertices + 1),
+        .source_coordinate = land_corrections.corrected_source,
+        .destination_coordinate = land_corrections.corrected_dest,
+        .landmarks = heuristic == SearchHeuristic::LANDMARKS ? _landmarks.get() : nullptr,
+    };
+
+    const auto link_visible_graph_vertices = [&](const Coordinate &endpoint,
+                                                 const std::optional<LineSegment> &blocking_edge,
+                                                 const std::vector<IndexedGraph::Neighbor> *attachment,
+                                                 EndpointLinks &links) {
+        links.start(num_graph_vertices);
+        auto visible_vertices = std::vector<IndexedGraph::Neighbor>();
+        if (attachment == nullptr) {
+            visible_vertices = find_visible_graph_vertices(endpoint, blocking_edge);
+            attachment = &visible_vertices;
+        }
+        for (const auto &neighbor : *attachment) {
+            links.link(neighbor.vertex, neighbor.is_meridian_crossing);
+        }
+    };
+    if (!query.is_graph_vertex(query.source)) {
+        link_visible_graph_vertices(query.source_coordinate, land_corrections.corrected_source_edge,
+                                    attachments.source, context.source_links);
+    }
+    if (!query.is_graph_vertex(query.destination)) {
+        link_visible_graph_vertices(query.destination_coordinate, land_corrections.corrected_dest_edge,
+                                    attachments.destination, context.destination_links);
+    }
+
+    if (query.landmarks == nullptr) {
+        return query;
+    }
+
+    const auto num_landmarks = query.landmarks->get_num_landmarks();
+    const auto &landmark_distances = query.landmarks->get_distances();
+    const auto find_landmark_distances = [&](uint32_t endpoint, const Coordinate &endpoint_coordinate,
+                                             const EndpointLinks &links, EndpointLandmarkDistances &distances) {
+        if (query.is_graph_vertex(endpoint)) {
+            const auto *endpoint_distances = landmark_distances.data() + static_cast<size_t>(endpoint) * num_landmarks;
+            distances.nearest.assign(endpoint_distances, endpoint_distances + num_landmarks);
+            distances.furthest.assign(endpoint_distances, endpoint_distances + num_landmarks);
+            return;
+        }
+
+        distances.nearest.assign(num_landmarks, INFINITY);
+        distances.furthest.assign(num_landmarks, -INFINITY);
+        for (const auto &link : links.neighbors) {
+            const auto link_length = distance_measurement(endpoint_coordinate,
+                                                          _indexed_graph.get_coordinate(link.vertex),
+                                                          link.is_meridian_crossing);
+            const auto *link_distances = landmark_distances.data() + static_cast<size_t>(link.vertex) * num_landmarks;
+            for (uint32_t landmark = 0; landmark < num_landmarks; ++landmark) {
+                if (std::isfinite(link_distances[landmark])) {
+                    distances.nearest[landmark] =
+                        std::min(distances.nearest[landmark], link_distances[landmark] + link_length);
+                    distances.furthest[landmark] =
+                        std::max(distances.furthest[landmark], link_distances[landmark] - link_length);
+                }
+            }
+        }
+    };
+    find_landmark_distances(query.source, query.source_coordinate, context.source_links,
+                            context.source_landmark_distances);
+    find_landmark_distances(query.destination, query.destination_coordinate, context.destination_links,
+                            context.destination_landmark_distances);
+
+    return query;
+}
+
+std::vector<IndexedGraph::Neighbor>
+ShortestPathComputer::find_visible_graph_vertices(const Coordinate &endpoint,
+                                                  const std::optional<LineSegment> &blocking_edge) const {
+    const auto cached = _endpoint_cache->find(endpoint);
+    if (cached != nullptr && cached->visible_graph_vertices.has_value() && cached->blocking_edge == blocking_edge) {
+        return cached->visible_graph_vertices.value();
+    }
+
+    auto visible_vertices = std::vector<IndexedGraph::Neighbor>();
+    for (const auto &point : find_visible_vertices(endpoint, blocking_edge)) {
+        const auto vertex = _indexed_graph.find_vertex(point.coord);
+        if (vertex.has_value()) {
+            visible_vertices.push_back(IndexedGraph::Neighbor{
+                .vertex = vertex.value(),
+                .is_meridian_crossing = point.is_visible_across_meridian,
+            });
+        }
+    }
+
+    auto updated = cached != nullptr ? *cached : CachedEndpoint{};
+    updated.blocking_edge = blocking_edge;
+    updated.visible_graph_vertices = visible_vertices;
+    _endpoint_cache->insert(endpoint, std::make_shared<const CachedEndpoint>(std::move(updated)));
+    return visible_vertices;
+}
+
+std::vector<VisibleVertex>
+ShortestPathComputer::find_visible_vertices(const Coordinate &endpoint,
+                                            const std::optional<LineSegment> &blocking_edge) const {
+    // Only segments within a radius of the endpoint can hide vertices within it, so those are swept alone. Once the
+    // segments wholly within the radius hide every direction a wanted vertex could be in, nothing further is visible.
+    // Endpoints out at sea are rarely enclosed, so past the largest radius every vertex is swept.
+    auto visible_vertices = std::optional<std::vector<VisibleVertex>>();
+    for (auto radius = MIN_ENDPOINT_ENCLOSURE_RADIUS; radius <= MAX_ENDPOINT_ENCLOSURE_RADIUS; radius *= 2) {
+        // Spherical distances never exceed planar distances in degrees, so every segment within the radius is found.
+        // Segments enclosing the endpoint must end a microdegree short of the radius, as the sweep measures distances
+        // in floating point.
+        auto enclosing_segments = std::vector<LineSegment>();
+        for (const auto &segment : _index.segments_within_distance_of_point(endpoint, radius * M_PI / 180.0)) {
+            if ((segment.get_endpoint_1() - endpoint).magnitude() <= radius - EPSILON_TOLERANCE &&
+                (segment.get_endpoint_2() - endpoint).magnitude() <= radius - EPSILON_TOLERANCE) {
+                enclosing_segments.push_back(segment);
+            }
+        }
+
+        if (blocking_edge.has_value()
+                ? AngularCover::hides_directions_clockwise_of(endpoint, enclosing_segments, blocking_edge.value())
+                : AngularCover::hides_all_directions(endpoint, enclosing_segments)) {
+            visible_vertices = _vistree_gen.get_visible_vertices_within_distance(endpoint, _index, radius);
+            break;
+        }
+    }
+    if (!visible_vertices.has_value()) {
+        visible_vertices = _vistree_gen.get_visible_vertices(endpoint);
+    }
+
+    // An endpoint corrected off land does not link to vertices on the land side of the edge it was moved to
+    if (blocking_edge.has_value()) {
+        auto &vertices = visible_vertices.value();
+        vertices.erase(std::remove_if(vertices.begin(), vertices.end(),
+                                      [&](const VisibleVertex &point) {
+                                          return blocking_edge.value().orientation_of_point_to_segment(point.coord) ==
+                                                 Orientation::COUNTER_CLOCKWISE;
+                                      }),
+                       vertices.end());
+    }
+    return std::move(visible_vertices.value());
+}
+
+std::optional<std::vector<Coordinate>>
+ShortestPathComputer::a_star_search(const IndexedQuery &query, double maximum_distance_to_search_from_source,
+                                    double a_star_greediness_weighting,
+                                    const std::shared_ptr<SearchStats> &stats) const {
+    auto &frontier = a_star_search_context.forward;
+    frontier.start(_indexed_graph.get_num_vertices() + 2);
+
+    const auto push = [&](uint32_t vertex, double distance_to_source) {
+        frontier.push(vertex, distance_to_source,
+                      distance_to_source + query.distance_to_destination_bound(vertex) * a_star_greediness_weighting);
+    };
+
+    frontier.reach(query.source, 0, query.source);
+    push(query.source, 0);
+
+    // Each vertex is expanded at most once, with the shortest distance it had when first popped. Entries pushed for
+    // it before its distance last shortened are skipped. That distance is the shortest for a consistent heuristic,
+    // i.e. with a greediness weighting of at most one, and within the weighting of the shortest otherwise.
+    size_t num_expanded_vertices = 0;
+    size_t num_skipped_heap_entries = 0;
+    size_t num_relaxed_edges = 0;
+    while (true) {
+        num_skipped_heap_entries += frontier.discard_stale_entries();
+        if (frontier.heap.empty()) {
+            break;
+        }
+
+        const auto top = frontier.pop();
+        if (top.vertex == query.destination) {
+            break;
+        }
+        frontier.settle(top.vertex);
+        ++num_expanded_vertices;
+
+        const auto &top_coordinate = query.coordinate_of(top.vertex);
+        query.for_each_neighbor(top.vertex, [&](uint32_t neighbor, bool is_meridian_crossing) {
+            ++num_relaxed_edges;
+            if (frontier.is_settled(neighbor)) {
+                return;
+            }
+
+            const auto &neighbor_coordinate = query.coordinate_of(neighbor);
+            const auto neighbor_dist_to_source =
+                top.distance_to_source +
+                distance_measurement(neighbor_coordinate, top_coordinate, is_meridian_crossing);
+            if (heuristic_distance_measurement(query.source_coordinate, neighbor_coordinate) >
+                    maximum_distance_to_search_from_source ||
+                (frontier.is_reached(neighbor) && frontier.distances[neighbor] <= neighbor_dist_to_source)) {
+                return;
+            }
+
+            frontier.reach(neighbor, neighbor_dist_to_source, top.vertex);
+            push(neighbor, neighbor_dist_to_source);
+        });
+    }
+
+    if (stats != nullptr) {
+        stats->record_search(num_expanded_vertices, num_skipped_heap_entries, num_relaxed_edges);
+    }
+
+    if (!frontier.is_reached(query.destination)) {
+        return std::nullopt;
+    }
+
+    auto path = query.to_coordinates(frontier.path_to_root(query.destination));
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+std::optional<std::vector<Coordinate>>
+ShortestPathComputer::bidirectional_a_star_search(const IndexedQuery &query,
+                                                  double maximum_distance_to_search_from_source,
+                                                  double a_star_greediness_weighting,
+                                                  const std::shared_ptr<SearchStats> &stats) const {
+    auto &forward = a_star_search_context.forward;
+    auto &backward = a_star_search_context.backward;
+    forward.start(_indexed_graph.get_num_vertices() + 2);
+    backward.start(_indexed_graph.get_num_vertices() + 2);
+
+    // The forward search is guided by half the difference of the heuristic distances to the destination and from
+    // the source, and the backward search by its negation. Unlike the heuristics themselves these agree on every
+    // edge's reduced length, so both searches settle vertices at their shortest distances. With a greediness weighting
+    // above one, the potentials are scaled by it and the path found may be longer than the shortest.
+    const auto forward_potential = [&](uint32_t vertex) {
+        return (query.distance_to_destination_bound(vertex) - query.distance_from_source_bound(vertex)) *
+               a_star_greediness_weighting / 2;
+    };
+
+    // The shortest path found so far, through the meeting vertex
+    auto shortest_distance = INFINITY;
+    uint32_t meeting_vertex = query.source;
+    const auto reach = [&](SearchFrontier &frontier, const SearchFrontier &opposite, double potential_sign,
+                           uint32_t vertex, double distance, uint32_t parent) {
+        frontier.reach(vertex, distance, parent);
+        frontier.push(vertex, distance, distance + potential_sign * forward_potential(vertex));
+
+        if (opposite.is_reached(vertex) && distance + opposite.distances[vertex] < shortest_distance) {
+            shortest_distance = distance + opposite.distances[vertex];
+            meeting_vertex = vertex;
+        }
+    };
+
+    reach(forward, backward, 1, query.source, 0, query.source);
+    // As for the one-directional search, a destination too far from the source is never reached
+    if (heuristic_distance_measurement(query.source_coordinate, query.destination_coordinate) <=
+        maximum_distance_to_search_from_source) {
+        reach(backward, forward, -1, query.destination, 0, query.destination);
+    }
+
+    // The two priorities sum to the same length for any path through a vertex, so once the smallest priorities left
+    // sum to at least the shortest path found, no path through an unexpanded vertex is shorter. Whichever direction
+    // has expanded fewer vertices goes next, which keeps the two searches balanced.
+    size_t num_expanded_vertices = 0;
+    size_t num_skipped_heap_entries = 0;
+    size_t num_relaxed_edges = 0;
+    size_t num_forward_expanded_vertices = 0;
+    while (true) {
+        num_skipped_heap_entries += forward.discard_stale_entries() + backward.discard_stale_entries();
+        if (forward.heap.empty() || backward.heap.empty() ||
+            forward.heap.front().priority + backward.heap.front().priority >= shortest_distance) {
+            break;
+        }
+
+        const auto is_forward = 2 * num_forward_expanded_vertices <= num_expanded_vertices;
+        auto &frontier = is_forward ? forward : backward;
+        const auto &opposite = is_forward ? backward : forward;
+        const auto potential_sign = is_forward ? 1. : -1.;
+
+        const auto top = frontier.pop();
+        frontier.settle(top.vertex);
+        ++num_expanded_vertices;
+        num_forward_expanded_vertices += is_forward;
+
+        const auto &top_coordinate = query.coordinate_of(top.vertex);
+        query.for_each_neighbor(top.vertex, [&](uint32_t neighbor, bool is_meridian_crossing) {
+            ++num_relaxed_edges;
+            if (frontier.is_settled(neighbor)) {
+                return;
+            }
+
+            const auto &neighbor_coordinate = query.coordinate_of(neighbor);
+            const auto neighbor_distance =
+                top.distance_to_source +
+                distance_measurement(neighbor_coordinate, top_coordinate, is_meridian_crossing);
+            if (heuristic_distance_measurement(query.source_coordinate, neighbor_coordinate) >
+                    maximum_distance_to_search_from_source ||
+                (frontier.is_reached(neighbor) && frontier.distances[neighbor] <= neighbor_distance)) {
+                return;
+            }
+
+            reach(frontier, opposite, potential_sign, neighbor, neighbor_distance, top.vertex);
+        });
+    }
+
+    if (stats != nullptr) {
+        stats->record_search(num_expanded_vertices, num_skipped_heap_entries, num_relaxed_edges);
     }
 
-    const auto modified_graph = create_modified_graph(land_corrections);
-    const auto source_destination_distance = heuristic_distance_measurement(corrected_source, corrected_dest);
+    if (shortest_distance == INFINITY) {
+        return std::nullopt;
+    }
+
+    auto path = query.to_coordinates(forward.path_to_root(meeting_vertex));
+    std::reverse(path.begin(), path.end());
+    const auto destination_half = query.to_coordinates(backward.path_to_root(meeting_vertex));
+    path.insert(path.end(), destination_half.begin() + 1, destination_half.end());
+
+    return path;
+}
+
+std::optional<std::vector<Coordinate>>
+ShortestPathComputer::contraction_hierarchy_search(const IndexedQuery &query,
+                                                   const std::shared_ptr<SearchStats> &stats) const {
+    const auto &hierarchy = *_contraction_hierarchy;
+    auto &forward = a_star_search_context.forward;
+    auto &backward = a_star_search_context.backward;
+    forward.start(_indexed_graph.get_num_vertices() + 2);
+    backward.start(_indexed_graph.get_num_vertices() + 2);
+
+    // The shortest path found so far, through the meeting vertex
+    auto shortest_distance = INFINITY;
+    uint32_t meeting_vertex = query.source;
+    const auto reach = [&](SearchFrontier &frontier, const SearchFrontier &opposite, uint32_t vertex, double distance,
+                           uint32_t parent) {
+        if (frontier.is_settled(vertex) || (frontier.is_reached(vertex) && frontier.distances[vertex] <= distance)) {
+            return;
+        }
+
+        frontier.reach(vertex, distance, parent);
+        frontier.push(vertex, distance, distance);
+
+        if (opposite.is_reached(vertex) && distance + opposite.distances[vertex] < shortest_distance) {
+            shortest_distance = distance + opposite.distances[vertex];
+            meeting_vertex = vertex;
+        }
+    };
+
+    reach(forward, backward, query.source, 0, query.source);
+    reach(backward, forward, query.destination, 0, query.destination);
+
+    // Endpoints which are not graph vertices rank below every vertex, so both searches leave them along all their
+    // links and never return to them. Each search stops once it can only find paths longer than the shortest found.
+    size_t num_expanded_vertices = 0;
+    size_t num_skipped_heap_entries = 0;
+    size_t num_relaxed_edges = 0;
+    while (true) {
+        num_skipped_heap_entries += forward.discard_stale_entries() + backward.discard_stale_entries();
+        const auto is_forward_done = forward.heap.empty() || forward.heap.front().priority >= shortest_distance;
+        const auto is_backward_done = backward.heap.empty() || backward.heap.front().priority >= shortest_distance;
+        if (is_forward_done && is_backward_done) {
+            break;
+        }
+
+        const auto is_forward =
+            !is_forward_done && (is_backward_done || forward.heap.front().priority <= backward.heap.front().priority);
+        auto &frontier = is_forward ? forward : backward;
+        const auto &opposite = is_forward ? backward : forward;
+
+        const auto top = frontier.pop();
+        frontier.settle(top.vertex);
+        ++num_expanded_vertices;
+
+        if (!query.is_graph_vertex(top.vertex)) {
+            const auto &links = top.vertex == query.source ? a_star_search_context.source_links
+                                                           : a_star_search_context.destination_links;
+            const auto &top_coordinate = query.coordinate_of(top.vertex);
+            for (const auto &neighbor : links.neighbors) {
+                ++num_relaxed_edges;
+                reach(frontier, opposite, neighbor.vertex,
+                      top.distance_to_source + distance_measurement(query.coordinate_of(neighbor.vertex),
+                                                                    top_coordinate, neighbor.is_meridian_crossing),
+                      top.vertex);
+            }
+            continue;
+        }
+
+        for (const auto &edge : hierarchy.get_upward_edges(top.vertex)) {
+            ++num_relaxed_edges;
+            reach(frontier, opposite, edge.vertex, top.distance_to_source + edge.length, top.vertex);
+        }
+    }
+
+    if (stats != nullptr) {
+        stats->record_search(num_expanded_vertices, num_skipped_heap_entries, num_relaxed_edges);
+    }
+
+    if (shortest_distance == INFINITY) {
+        return std::nullopt;
+    }
+
+    // The path over the hierarchy, with each of its shortcuts unpacked into the graph edges it stands for
+    auto hierarchy_path = forward.path_to_root(meeting_vertex);
+    std::reverse(hierarchy_path.begin(), hierarchy_path.end());
+    const auto destination_half = backward.path_to_root(meeting_vertex);
+    hierarchy_path.insert(hierarchy_path.end(), destination_half.begin() + 1, destination_half.end());
+
+    auto path = std::vector<uint32_t>{hierarchy_path.front()};
+    for (size_t i = 1; i < hierarchy_path.size(); ++i) {
+        if (query.is_graph_vertex(hierarchy_path[i - 1]) && query.is_graph_vertex(hierarchy_path[i])) {
+            hierarchy.unpack_edge(hierarchy_path[i - 1], hierarchy_path[i], path);
+        } else {
+            path.push_back(hierarchy_path[i]);
+        }
+    }
+
+    return query.to_coordinates(path);
+}
+
+ShortestPathComputer::SearchTree ShortestPathComputer::search_within_radius(const IGraph &graph, const Coordinate &root,
+                                                                          double radius) {
+    auto tree = SearchTree();
+    tree.distances[root] = 0;
+
+    const auto comparison_func = [](const std::pair<double, Coordinate> &a, const std::pair<double, Coordinate> &b) {
+        return a.first > b.first;
+    };
+    auto pq = std::priority_queue<std::pair<double, Coordinate>, std::vector<std::pair<double, Coordinate>>,
+                                  decltype(comparison_func)>(comparison_func);
+    pq.emplace(0, root);
+
+    while (!pq.empty()) {
+        const auto [distance, vertex] = pq.top();
+        pq.pop();
+
+        if (distance > tree.distances.at(vertex)) {
+            continue;
+        }
+
+        for (const auto &neighbor : graph.get_neighbors(vertex)) {
+            const auto neighbor_distance =
+                distance + distance_measurement(neighbor, vertex, graph.is_edge_meridian_crossing(vertex, neighbor));
+            const auto neighbor_iter = tree.distances.find(neighbor);
+            if (neighbor_iter != tree.distances.end() && neighbor_iter->second <= neighbor_distance) {
+                continue;
+            }
+
+            tree.distances[neighbor] = neighbor_distance;
+            tree.previous.insert_or_assign(neighbor, vertex);
+            if (heuristic_distance_measurement(root, neighbor) <= radius) {
+                pq.emplace(neighbor_distance, neighbor);
+            }
+        }
+    }
+
+    return tree;
+}
+
+std::optional<std::vector<Coordinate>>
+ShortestPathComputer::hierarchical_shortest_path(const IGraph &graph, const Coordinate &source,
+                                                 const Coordinate &destination,
+                                                 double maximum_distance_to_search_from_source,
+                                                 double a_star_greediness_weighting,
+                                                 const std::shared_ptr<SearchStats> &stats) const {
+    const auto source_tree = search_within_radius(graph, source, _refinement_radius);
+    const auto destination_tree = search_within_radius(graph, destination, _refinement_radius);
 
     const auto comparison_func = [&](const AStarHeapElement &a, const AStarHeapElement &b) {
         return (a.distance_to_source + a.heuristic_distance_to_destination * a_star_greediness_weighting) >
                (b.distance_to_source + b.heuristic_distance_to_destination * a_star_greediness_weighting);
     };
-
     auto pq = std::priority_queue<AStarHeapElement, std::vector<AStarHeapElement>, decltype(comparison_func)>(
         comparison_func);
-    pq.push(AStarHeapElement{
-        .node = corrected_source,
-        .distance_to_source = 0,
-        .heuristic_distance_to_destination = source_destination_distance,
-    });
 
-    auto prev_coord = std::unordered_map<Coordinate, Coordinate>();
+    // The search runs over the coarse vertices, which are entered from the source's tree (and so have no previous
+    // vertex) and left for the destination through the destination's tree
+    auto previous = std::unordered_map<Coordinate, Coordinate>();
     auto distances_to_source = std::unordered_map<Coordinate, double>();
+    const auto push = [&](const Coordinate &node, double distance_to_source, std::optional<Coordinate> prev) {
+        const auto distance_iter = distances_to_source.find(node);
+        if (distance_iter != distances_to_source.end() && distance_iter->second <= distance_to_source) {
+            return;
+        }
+
+        distances_to_source[node] = distance_to_source;
+        if (prev.has_value()) {
+            previous.insert_or_assign(node, prev.value());
+        } else {
+            previous.erase(node);
+        }
+        pq.push(AStarHeapElement{
+            .node = node,
+            .distance_to_source = distance_to_source,
+            .heuristic_distance_to_destination = heuristic_distance_measurement(node, destination),
+        });
+    };
+
+    for (const auto &[vertex, distance] : source_tree.distances) {
+        if (vertex == destination || _coarse_graph->has_vertex(vertex)) {
+            push(vertex, distance, std::nullopt);
+        }
+    }
+
+    bool found_destination = false;
+    auto settled = std::unordered_set<Coordinate>();
+    size_t num_skipped_heap_entries = 0;
+    size_t num_relaxed_edges = 0;
     while (!pq.empty()) {
         const auto top = pq.top();
         pq.pop();
 
-        if (top.node == corrected_dest) {
+        if (settled.find(top.node) != settled.end() || top.distance_to_source > distances_to_source.at(top.node)) {
+            ++num_skipped_heap_entries;
+            continue;
+        }
+        if (top.node == destination) {
+            found_destination = true;
             break;
         }
+        settled.insert(top.node);
 
-        for (const auto &neighbor : modified_graph->get_neighbors(top.node)) {
-            const auto meridian_spanning = modified_graph->is_edge_meridian_crossing(top.node, neighbor);
+        const auto exit_iter = destination_tree.distances.find(top.node);
+        if (exit_iter != destination_tree.distances.end()) {
+            push(destination, top.distance_to_source + exit_iter->second, top.node);
+        }
 
-            const auto edge_dist = distance_measurement(neighbor, top.node, meridian_spanning);
-            const auto neighbor_dist_to_source = top.distance_to_source + edge_dist;
-            const auto neighbor_direct_distance_to_source = heuristic_distance_measurement(corrected_source, neighbor);
-            if (neighbor_direct_distance_to_source > maximum_distance_to_search_from_source ||
-                (distances_to_source.find(neighbor) != distances_to_source.end() &&
-                 distances_to_source.at(neighbor) <= neighbor_dist_to_source)) {
+        for (const auto &neighbor : _coarse_graph->get_neighbors(top.node)) {
+            ++num_relaxed_edges;
+            if (neighbor == destination || settled.find(neighbor) != settled.end() ||
+                heuristic_distance_measurement(source, neighbor) > maximum_distance_to_search_from_source) {
                 continue;
             }
 
-            const auto heap_elem = AStarHeapElement{
-                .node = neighbor,
-                .distance_to_source = neighbor_dist_to_source,
-                .heuristic_distance_to_destination = heuristic_distance_measurement(neighbor, corrected_dest),
-            };
-            pq.push(heap_elem);
-            prev_coord[neighbor] = top.node;
-            distances_to_source[neighbor] = neighbor_dist_to_source;
+            const auto meridian_spanning = _coarse_graph->is_edge_meridian_crossing(top.node, neighbor);
+            push(neighbor, top.distance_to_source + distance_measurement(neighbor, top.node, meridian_spanning),
+                 top.node);
         }
     }
 
-    auto path = std::vector<Coordinate>();
-    auto curr_node = corrected_dest;
+    if (stats != nullptr) {
+        stats->record_search(settled.size(), num_skipped_heap_entries, num_relaxed_edges);
+    }
+
+    if (!found_destination) {
+        return std::nullopt;
+    }
 
-    while (curr_node != corrected_source) {
-        path.push_back(curr_node);
+    auto path = std::vector<Coordinate>{destination};
+    auto entry = destination;
+    const auto exit_iter = previous.find(destination);
+    if (exit_iter != previous.end()) {
+        // Through the destination's tree, from the destination back to where the coarse graph was left
+        auto exit_path = std::vector<Coordinate>();
+        for (auto vertex = exit_iter->second; vertex != destination; vertex = destination_tree.previous.at(vertex)) {
+            exit_path.push_back(vertex);
+        }
+        path.insert(path.end(), exit_path.rbegin(), exit_path.rend());
 
-        if (prev_coord.find(curr_node) == prev_coord.end()) {
-            throw std::runtime_error(
-                    fmt::format("Could not find a shortest path. "
-                                "Got stuck on {}. "
-                                "Source: {}. "
-                                "Destination: {}. "
-                                "Corrected Source: {}. "
-                                "Corrected Destination: {}. ",
-                                curr_node.to_string_representation(),
-                                source.to_string_representation(),
-                                destination.to_string_representation(),
-                                corrected_source.to_string_representation(),
-                                corrected_dest.to_string_representation()));
+        // Over the coarse graph
+        entry = exit_iter->second;
+        for (auto previous_iter = previous.find(entry); previous_iter != previous.end();
+             previous_iter = previous.find(entry)) {
+            entry = previous_iter->second;
+            path.push_back(entry);
         }
-        curr_node = prev_coord.at(curr_node);
     }
-    path.push_back(corrected_source);
+
+    // Through the source's tree, from where the coarse graph was entered back to the source
+    for (auto vertex = entry; vertex != source;) {
+        vertex = source_tree.previous.at(vertex);
+        path.push_back(vertex);
+    }
 
     std::reverse(path.begin(), path.end());
 
     return path;
 }
 
-std::vector<BatchInterpolateResult>
-ShortestPathComputer::shortest_paths(const std::vector<std::pair<Coordinate, Coordinate>> &source_dest_pairs,
-                                     double maximum_distance_to_search_from_source, bool correct_vertices_on_land,
-                                     double a_star_greediness_weighting) const {
-    auto paths = std::vector<BatchInterpolateResult>(source_dest_pairs.size());
-
-#pragma omp parallel for shared(source_dest_pairs, paths, maximum_distance_to_search_from_source, \
-                                correct_vertices_on_land, a_star_greediness_weighting) default(none) schedule(dynamic)
-    for (size_t i = 0; i < source_dest_pairs.size(); ++i) {
-        try {
-            paths[i] = BatchInterpolateResult{
-                .path = std::make_optional(
-                    shortest_path(
-                        source_dest_pairs[i].first,
-                        source_dest_pairs[i].second,
-                        maximum_distance_to_search_from_source,
-                        correct_vertices_on_land,
-                        a_star_greediness_weighting
-                    )
-                ),
-                .error_msg = std::nullopt
-            };
-        } catch (const std::exception &e) {
-            paths[i] = BatchInterpolateResult{
-                .path = std::nullopt,
-                .error_msg = std::string(e.what())
-            };
-        }
-    }
-
-    return paths;
-}
-
 double ShortestPathComputer::distance_measurement(const Coordinate &a, const Coordinate &b, bool is_meridian_spanning) {
     if (!is_meridian_spanning) {
         return (a - b).magnitude();
@@ -174,40 +1573,82 @@ double ShortestPathComputer::heuristic_distance_measurement(const Coordinate &a,
 LandCollisionCorrection ShortestPathComputer::handle_land_collisions(const Coordinate &source,
                                                                      const Coordinate &destination,
                                                                      bool correct_vertices_on_land) const {
-    const auto source_is_on_land = _index.is_point_contained(source);
-    const auto destination_is_on_land = _index.is_point_contained(destination);
+    return combine_land_corrections(correct_endpoint(source, correct_vertices_on_land),
+                                    correct_endpoint(destination, correct_vertices_on_land), correct_vertices_on_land);
+}
 
-    if (!correct_vertices_on_land && (source_is_on_land || destination_is_on_land)) {
+LandCorrectedEndpoint ShortestPathComputer::correct_endpoint(const Coordinate &point,
+                                                             bool correct_vertices_on_land) const {
+    if (point.get_latitude() < MIN_LATITUDE || point.get_latitude() > MAX_LATITUDE) {
         throw std::runtime_error(
-                fmt::format("Either the source or the destination are on land. "
-                            "Source: {}. Destination: {}.",
-                            source.to_string_representation(),
-                            destination.to_string_representation()));
+            fmt::format("The latitude of {} is not between -90 and 90", point.to_string_representation()));
+    }
+
+    const auto cached = _endpoint_cache->find(point);
+    auto land_correction = std::optional<LandCorrectedEndpoint>();
+    if (cached != nullptr) {
+        land_correction = cached->land_correction;
+    }
+    if (!land_correction.has_value()) {
+        if (_index.is_point_contained(point)) {
+            const auto [corrected_point, blocking_edge] = move_off_land(point);
+            land_correction = LandCorrectedEndpoint{
+                .coordinate = corrected_point, .is_on_land = true, .blocking_edge = blocking_edge};
+        } else {
+            land_correction =
+                LandCorrectedEndpoint{.coordinate = point, .is_on_land = false, .blocking_edge = std::nullopt};
+        }
+
+        auto updated = cached != nullptr ? *cached : CachedEndpoint{};
+        updated.land_correction = land_correction;
+        _endpoint_cache->insert(point, std::make_shared<const CachedEndpoint>(std::move(updated)));
     }
 
-    auto corrected_source = source;
-    auto corrected_destination = destination;
-    std::optional<LineSegment> corrected_source_edge = std::nullopt;
-    std::optional<LineSegment> corrected_dest_edge = std::nullopt;
-    if (source_is_on_land) {
-        const auto closest_seg = _index.closest_segment_to_point(source);
-        corrected_source = closest_seg.project(source);
-        corrected_source_edge = std::make_optional(closest_seg);
+    if (land_correction.value().is_on_land && !correct_vertices_on_land) {
+        return LandCorrectedEndpoint{.coordinate = point, .is_on_land = true, .blocking_edge = std::nullopt};
     }
-    if (destination_is_on_land) {
-        const auto closest_seg = _index.closest_segment_to_point(destination);
-        corrected_destination = closest_seg.project(destination);
-        corrected_dest_edge = std::make_optional(closest_seg);
+    return land_correction.value();
+}
+
+CacheStatsSnapshot ShortestPathComputer::endpoint_cache_stats() const { return _endpoint_cache->snapshot(); }
+
+CacheStatsSnapshot ShortestPathComputer::path_cache_stats() const { return _path_cache->snapshot(); }
+
+LandCollisionCorrection ShortestPathComputer::combine_land_corrections(const LandCorrectedEndpoint &source,
+                                                                       const LandCorrectedEndpoint &destination,
+                                                                       bool correct_vertices_on_land) {
+    if (!correct_vertices_on_land && (source.is_on_land || destination.is_on_land)) {
+        throw std::runtime_error(
+                fmt::format("Either the source or the destination are on land. "
+                            "Source: {}. Destination: {}.",
+                            source.coordinate.to_string_representation(),
+                            destination.coordinate.to_string_representation()));
     }
 
     return LandCollisionCorrection{
-        .corrected_source = corrected_source,
-        .corrected_dest = corrected_destination,
-        .corrected_source_edge = corrected_source_edge,
-        .corrected_dest_edge = corrected_dest_edge,
+        .corrected_source = source.coordinate,
+        .corrected_dest = destination.coordinate,
+        .corrected_source_edge = source.blocking_edge,
+        .corrected_dest_edge = destination.blocking_edge,
     };
 }
 
+std::pair<Coordinate, std::optional<LineSegment>> ShortestPathComputer::move_off_land(const Coordinate &point) const {
+    const auto closest_seg = _index.closest_segment_to_point(point);
+    return {closest_seg.project(point), std::make_optional(closest_seg)};
+}
+
+bool ShortestPathComputer::are_endpoints_visible(const LandCollisionCorrection &land_corrections) const {
+    const auto intersections = _index.intersect_with_segments(
+        LineSegment(land_corrections.corrected_source, land_corrections.corrected_dest));
+    return std::all_of(intersections.begin(), intersections.end(), [&](const LineSegment &intersection) {
+        return (land_corrections.corrected_source_edge.has_value() &&
+                intersection == land_corrections.corrected_source_edge.value()) ||
+               (land_corrections.corrected_dest_edge.has_value() &&
+                intersection == land_corrections.corrected_dest_edge.value());
+    });
+}
+
 std::shared_ptr<IGraph> ShortestPathComputer::create_modified_graph(const LandCollisionCorrection &correction) const {
     if (_graph->has_vertex(correction.corrected_source) && _graph->has_vertex(correction.corrected_dest)) {
         return _graph;
@@ -221,13 +1662,8 @@ std::shared_ptr<IGraph> ShortestPathComputer::create_modified_graph(const LandCo
         if (!_graph->has_vertex(vertices_to_process[i])) {
             modified_graph->add_vertex(vertices_to_process[i]);
 
-            const auto reachable_vertices = _vistree_gen.get_visible_vertices(vertices_to_process[i]);
-
-            for (const auto &point : reachable_vertices) {
-                if (!blocking_edges[i].has_value() ||
-                    blocking_edges[i].value().orientation_of_point_to_segment(point.coord) != Orientation::COUNTER_CLOCKWISE) {
-                    modified_graph->add_edge(vertices_to_process[i], point.coord, point.is_visible_across_meridian);
-                }
+            for (const auto &point : find_visible_vertices(vertices_to_process[i], blocking_edges[i])) {
+                modified_graph->add_edge(vertices_to_process[i], point.coord, point.is_visible_across_meridian);
             }
         }
     }
@@ -6,11 +6,20 @@
 #define CAPI_SHORTEST_PATH_COMPUTER_HPP
 
 #include <cmath>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <memory>
 
+#include "constants/constants.hpp"
+#include "search_stats.hpp"
+#include "datastructures/contraction_hierarchy/contraction_hierarchy.hpp"
 #include "datastructures/i_graph/i_graph.hpp"
+#include "datastructures/indexed_graph/indexed_graph.hpp"
+#include "datastructures/landmarks/landmarks.hpp"
+#include "datastructures/lru_cache/lru_cache.hpp"
 #include "datastructures/spatial_segment_index/spatial_segment_index.hpp"
 #include "types/coordinate/coordinate.hpp"
 #include "types/polygon/polygon.hpp"
@@ -22,6 +31,17 @@ struct BatchInterpolateResult {
     std::optional<std::string> error_msg;
 };
 
+struct DistanceMatrix {
+    // distances[i][j] is the length in degrees of the shortest path from the ith source to the jth target, infinite
+    // where there is none
+    std::vector<std::vector<double>> distances;
+    // paths[i][j] is that path, when paths are asked for
+    std::vector<std::vector<std::optional<std::vector<Coordinate>>>> paths;
+    // Why a source or target could not be searched from or to, such as it being on land
+    std::vector<std::optional<std::string>> source_error_msgs;
+    std::vector<std::optional<std::string>> target_error_msgs;
+};
+
 namespace {
     struct LandCollisionCorrection {
         Coordinate corrected_source;
@@ -29,32 +49,241 @@ namespace {
         std::optional<LineSegment> corrected_source_edge;
         std::optional<LineSegment> corrected_dest_edge;
     };
+
+    // One endpoint of a search, moved to the nearest point on the coast if it was on land and that was asked for
+    struct LandCorrectedEndpoint {
+        Coordinate coordinate;
+        bool is_on_land;
+        std::optional<LineSegment> blocking_edge;
+    };
 }
 
+// How the detailed graph is searched. Searches of the coarse graph are always one-directional.
+enum SearchAlgorithm {
+    A_STAR,
+    // Searches forward from the source and backward from the destination at once, guided by the average of the
+    // two directions' heuristics, and stops once no unexpanded vertex can lie on a shorter path
+    BIDIRECTIONAL_A_STAR,
+    // Searches upward from both ends of a contraction hierarchy of the graph (see ContractionHierarchyBuilder), which
+    // the computer must have been given. Paths are the shortest whatever the greediness weighting. With a maximum
+    // distance to search from the source, an A* search runs instead if the shortest path goes further than it.
+    CONTRACTION_HIERARCHY,
+};
+
+// The lower bound on the distance left to go which guides A* searches of the detailed graph. Searches of the coarse
+// graph always use the straight line.
+enum SearchHeuristic {
+    STRAIGHT_LINE,
+    // The largest of the straight line and the bounds given by each landmark (see Landmarks), which the computer must
+    // have been given. It is as consistent as the straight line, so paths found with it are as short.
+    LANDMARKS,
+};
+
+// Finds shortest paths with A* over a visgraph. The search runs over a snapshot of the graph taken on construction,
+// with per-thread search state reused across queries.
+//
+// Given a coarse graph (see VisgraphGenerator::generate_coarse), paths between endpoints further apart than twice the
+// refinement radius are found hierarchically: the detailed graph is only searched within refinement_radius (in
+// degrees) of the source and destination, and the coarse graph in between. Coarse edges are detailed edges, so these
+// paths are valid, but they may be longer than the shortest where the shortest passes through vertices dropped from
+// the coarse graph. The detailed graph is searched in full if no hierarchical path is found.
+//
+// Given a contraction hierarchy of the graph, built from the same vertices in the same order, it is searched instead
+// of either graph for SearchAlgorithm::CONTRACTION_HIERARCHY. Given landmarks of the graph, likewise built from the same
+// vertices, they can guide the A* searches of the detailed graph with SearchHeuristic::LANDMARKS.
+//
+// The computer remembers up to endpoint_cache_capacity recent endpoints: whether each is on land and where it is moved
+// to off it, and the graph vertices visible from it, so that endpoints searched from again skip finding them.
+//
+// Given a path_cache_capacity (in bytes), the computer also remembers recent paths between endpoints off the graph by
+// the cells of a grid path_cache_cell_size degrees wide that their endpoints snap to. A search between endpoints in the
+// same cells as a remembered path, which see the same graph vertices as its endpoints did, follows the remembered path
+// between graph vertices instead, joining it wherever makes the path shortest. These paths are valid, but may be longer
+// than the shortest where the endpoints' best routes part ways within the cells.
 class ShortestPathComputer {
   public:
-    explicit ShortestPathComputer(const std::shared_ptr<IGraph> &graph);
+    explicit ShortestPathComputer(const std::shared_ptr<IGraph> &graph,
+                                  const std::shared_ptr<IGraph> &coarse_graph = nullptr,
+                                  double refinement_radius = DEFAULT_REFINEMENT_RADIUS,
+                                  const std::shared_ptr<ContractionHierarchy> &contraction_hierarchy = nullptr,
+                                  const std::shared_ptr<Landmarks> &landmarks = nullptr,
+                                  size_t endpoint_cache_capacity = DEFAULT_ENDPOINT_CACHE_CAPACITY,
+                                  size_t path_cache_capacity = 0,
+                                  double path_cache_cell_size = DEFAULT_PATH_CACHE_CELL_SIZE);
     [[nodiscard]] std::vector<Coordinate> shortest_path(const Coordinate &source, const Coordinate &destination,
                                                         double maximum_distance_to_search_from_source = INFINITY,
                                                         bool correct_vertices_on_land = false,
-                                                        double a_star_greediness_weighting = 1.0) const;
+                                                        double a_star_greediness_weighting = 1.0,
+                                                        SearchAlgorithm search_algorithm = SearchAlgorithm::A_STAR,
+                                                        SearchHeuristic heuristic = SearchHeuristic::STRAIGHT_LINE,
+                                                        const std::shared_ptr<SearchStats> &stats = nullptr) const;
+    // Pairs with the same endpoints once moved off land are searched once, and endpoints shared by several pairs are
+    // linked to the graph once. Pairs from the same source run one after another, with sources close together in turn.
     [[nodiscard]] std::vector<BatchInterpolateResult>
     shortest_paths(const std::vector<std::pair<Coordinate, Coordinate>> &source_dest_pairs,
                    double maximum_distance_to_search_from_source = INFINITY, bool correct_vertices_on_land = false,
-                   double a_star_greediness_weighting = 1.0) const;
+                   double a_star_greediness_weighting = 1.0,
+                   SearchAlgorithm search_algorithm = SearchAlgorithm::A_STAR,
+                   SearchHeuristic heuristic = SearchHeuristic::STRAIGHT_LINE,
+                   const std::shared_ptr<SearchStats> &stats = nullptr) const;
 
-  private:
+    // Finds the shortest paths from each source to every target with a single Dijkstra search of the detailed graph,
+    // which stops once all the targets are settled. Targets are linked to the graph once for every source.
+    [[nodiscard]] DistanceMatrix distance_matrix(const std::vector<Coordinate> &sources,
+                                                 const std::vector<Coordinate> &targets,
+                                                 double maximum_distance_to_search_from_source = INFINITY,
+                                                 bool correct_vertices_on_land = false, bool include_paths = false,
+                                                 const std::shared_ptr<SearchStats> &stats = nullptr) const;
+
+    // How often endpoints were found in the cache, counting land checks and visible vertex lookups separately
+    [[nodiscard]] CacheStatsSnapshot endpoint_cache_stats() const;
+    // How often searches followed a remembered path, with the cache's size and capacity in bytes
+    [[nodiscard]] CacheStatsSnapshot path_cache_stats() const;
+
+    // Edge lengths in degrees, and the shortest any path between two points could be, directly or across the meridian
     static double distance_measurement(const Coordinate &a, const Coordinate &b, bool is_meridian_spanning);
     static double heuristic_distance_measurement(const Coordinate &a, const Coordinate &b);
 
+  private:
+    // The graph vertices visible from each endpoint of a search when they were found ahead of it, otherwise null
+    struct EndpointAttachments {
+        const std::vector<IndexedGraph::Neighbor> *source = nullptr;
+        const std::vector<IndexedGraph::Neighbor> *destination = nullptr;
+    };
+
+    [[nodiscard]] std::vector<Coordinate>
+    corrected_shortest_path(const LandCollisionCorrection &land_corrections,
+                            double maximum_distance_to_search_from_source, double a_star_greediness_weighting,
+                            SearchAlgorithm search_algorithm, SearchHeuristic heuristic,
+                            const std::shared_ptr<SearchStats> &stats, const EndpointAttachments &attachments) const;
+    // Searches between endpoints off the graph through the path cache
+    [[nodiscard]] std::vector<Coordinate>
+    cached_shortest_path(const LandCollisionCorrection &land_corrections, double maximum_distance_to_search_from_source,
+                         double a_star_greediness_weighting, SearchAlgorithm search_algorithm,
+                         SearchHeuristic heuristic, const std::shared_ptr<SearchStats> &stats,
+                         const EndpointAttachments &attachments) const;
+    [[nodiscard]] std::vector<Coordinate>
+    uncached_shortest_path(const LandCollisionCorrection &land_corrections,
+                           double maximum_distance_to_search_from_source, double a_star_greediness_weighting,
+                           SearchAlgorithm search_algorithm, SearchHeuristic heuristic,
+                           const std::shared_ptr<SearchStats> &stats, const EndpointAttachments &attachments) const;
+    [[nodiscard]] std::vector<Coordinate> detailed_shortest_path(const LandCollisionCorrection &land_corrections,
+                                                                 double maximum_distance_to_search_from_source,
+                                                                 double a_star_greediness_weighting,
+                                                                 SearchAlgorithm search_algorithm,
+                                                                 SearchHeuristic heuristic,
+                                                                 const std::shared_ptr<SearchStats> &stats,
+                                                                 const EndpointAttachments &attachments) const;
+
+    // The endpoints of a search over _indexed_graph as vertex ids. Endpoints which are not graph vertices take the two
+    // ids after the graph's, and are linked to the vertices visible from them.
+    struct IndexedQuery;
+    [[nodiscard]] IndexedQuery index_query(const LandCollisionCorrection &land_corrections, SearchHeuristic heuristic,
+                                           const EndpointAttachments &attachments) const;
+    [[nodiscard]] std::vector<IndexedGraph::Neighbor>
+    find_visible_graph_vertices(const Coordinate &endpoint, const std::optional<LineSegment> &blocking_edge) const;
+    // The vertices visible from a point off the graph, leaving out those on the land side of the edge it was moved
+    // onto off land
+    [[nodiscard]] std::vector<VisibleVertex> find_visible_vertices(const Coordinate &endpoint,
+                                                                   const std::optional<LineSegment> &blocking_edge) const;
+    [[nodiscard]] std::optional<std::vector<Coordinate>> a_star_search(const IndexedQuery &query,
+                                                                       double maximum_distance_to_search_from_source,
+                                                                       double a_star_greediness_weighting,
+                                                                       const std::shared_ptr<SearchStats> &stats) const;
+    [[nodiscard]] std::optional<std::vector<Coordinate>>
+    bidirectional_a_star_search(const IndexedQuery &query, double maximum_distance_to_search_from_source,
+                                double a_star_greediness_weighting, const std::shared_ptr<SearchStats> &stats) const;
+    [[nodiscard]] std::optional<std::vector<Coordinate>>
+    contraction_hierarchy_search(const IndexedQuery &query, const std::shared_ptr<SearchStats> &stats) const;
+
+    // Shortest distances from a root, and the previous vertex on each shortest path, over paths only passing through
+    // vertices within a radius of the root
+    struct SearchTree {
+        std::unordered_map<Coordinate, double> distances;
+        std::unordered_map<Coordinate, Coordinate> previous;
+    };
+
+    [[nodiscard]] static SearchTree search_within_radius(const IGraph &graph, const Coordinate &root, double radius);
+    [[nodiscard]] std::optional<std::vector<Coordinate>>
+    hierarchical_shortest_path(const IGraph &graph, const Coordinate &source, const Coordinate &destination,
+                               double maximum_distance_to_search_from_source, double a_star_greediness_weighting,
+                               const std::shared_ptr<SearchStats> &stats) const;
+
     [[nodiscard]] LandCollisionCorrection handle_land_collisions(const Coordinate &source,
                                                                  const Coordinate &destination,
                                                                  bool correct_vertices_on_land) const;
+    [[nodiscard]] LandCorrectedEndpoint correct_endpoint(const Coordinate &point, bool correct_vertices_on_land) const;
+    // Throws if either endpoint is on land and was not moved off it
+    [[nodiscard]] static LandCollisionCorrection combine_land_corrections(const LandCorrectedEndpoint &source,
+                                                                          const LandCorrectedEndpoint &destination,
+                                                                          bool correct_vertices_on_land);
+    // The nearest point on the coast to a point on land, and the coastline edge it is on
+    [[nodiscard]] std::pair<Coordinate, std::optional<LineSegment>> move_off_land(const Coordinate &point) const;
+    // Whether the endpoints can see each other, through the edges they were moved onto off land
+    [[nodiscard]] bool are_endpoints_visible(const LandCollisionCorrection &land_corrections) const;
     [[nodiscard]] std::shared_ptr<IGraph> create_modified_graph(const LandCollisionCorrection &correction) const;
 
+    // What is known of an endpoint of past searches, each part filled when first needed. A point on land is moved
+    // off it whether or not that was asked for. The visible graph vertices leave out those on the land side of the
+    // edge the point was moved onto, so are only reused for the same edge.
+    struct CachedEndpoint {
+        std::optional<LandCorrectedEndpoint> land_correction;
+        std::optional<LineSegment> blocking_edge;
+        std::optional<std::vector<IndexedGraph::Neighbor>> visible_graph_vertices;
+    };
+
+    // Searches remembered by the path cache: the grid cells of their endpoints, and how they searched
+    struct PathCacheKey {
+        int64_t source_cell_x;
+        int64_t source_cell_y;
+        int64_t destination_cell_x;
+        int64_t destination_cell_y;
+        double maximum_distance_to_search_from_source;
+        double a_star_greediness_weighting;
+        SearchAlgorithm search_algorithm;
+        SearchHeuristic heuristic;
+
+        bool operator==(const PathCacheKey &other) const;
+    };
+    struct PathCacheKeyHash {
+        size_t operator()(const PathCacheKey &key) const;
+    };
+
+    // The graph vertices of a remembered path, the distance along it to each, and fingerprints of the sets of graph
+    // vertices its endpoints saw
+    struct CachedPath {
+        uint64_t source_visibility_fingerprint;
+        uint64_t destination_visibility_fingerprint;
+        std::vector<uint32_t> vertices;
+        std::vector<double> distances_along;
+    };
+
+    [[nodiscard]] PathCacheKey path_cache_key(const LandCollisionCorrection &land_corrections,
+                                              double maximum_distance_to_search_from_source,
+                                              double a_star_greediness_weighting, SearchAlgorithm search_algorithm,
+                                              SearchHeuristic heuristic) const;
+    // The remembered path joined to new endpoints, unless they cannot see any of its vertices in order
+    [[nodiscard]] std::optional<std::vector<Coordinate>>
+    join_cached_path(const CachedPath &cached_path, const Coordinate &source,
+                     const std::vector<IndexedGraph::Neighbor> &source_visible_vertices,
+                     const Coordinate &destination,
+                     const std::vector<IndexedGraph::Neighbor> &destination_visible_vertices,
+                     double maximum_distance_to_search_from_source) const;
+
+    // Checks that data built from the graph ahead of time has the graph's vertices in the same order
+    void check_prebuilt_vertices(const std::string &description, const std::vector<Coordinate> &coordinates) const;
+
     std::shared_ptr<IGraph> _graph;
+    IndexedGraph _indexed_graph;
+    std::shared_ptr<IGraph> _coarse_graph;
+    double _refinement_radius;
+    std::shared_ptr<ContractionHierarchy> _contraction_hierarchy;
+    std::shared_ptr<Landmarks> _landmarks;
     SpatialSegmentIndex _index;
     VistreeGenerator _vistree_gen;
+    std::unique_ptr<LruCache<Coordinate, CachedEndpoint>> _endpoint_cache;
+    double _path_cache_cell_size;
+    std::unique_ptr<LruCache<PathCacheKey, CachedPath, PathCacheKeyHash>> _path_cache;
 };
 
 #endif // CAPI_SHORTEST_PATH_COMPUTER_HPP
@@ -47,6 +47,12 @@ bool Coordinate::operator==(const Coordinate &other) const {
 
 bool Coordinate::operator!=(const Coordinate &other) const { return !(*this == other); }
 
+bool Coordinate::operator<(const Coordinate &other) const {
+    return _longitude_microdegrees < other._longitude_microdegrees ||
+           (_longitude_microdegrees == other._longitude_microdegrees &&
+            _latitude_microdegrees < other._latitude_microdegrees);
+}
+
 Coordinate Coordinate::operator+(const Coordinate &other) const {
     return {_longitude_microdegrees + other._longitude_microdegrees,
             _latitude_microdegrees + other._latitude_microdegrees};
@@ -31,6 +31,8 @@ class Coordinate {
     // Comparison operations
     bool operator==(const Coordinate &other) const;
     bool operator!=(const Coordinate &other) const;
+    // Orders by longitude then latitude, giving a canonical order independent of hashing
+    bool operator<(const Coordinate &other) const;
 
     // Vector operations
     Coordinate operator-() const;
@@ -2,11 +2,14 @@
 // Created by James.Balajan on 31/03/2021.
 //
 
+#include <algorithm>
+#include <cmath>
 #include <s2/s2point.h>
 #include <stdexcept>
 
 #include "line_segment.hpp"
 #include "constants/constants.hpp"
+#include "geom/exact_predicates/exact_predicates.hpp"
 
 Coordinate LineSegment::get_endpoint_1() const { return _endpoint_1; }
 
@@ -70,22 +73,7 @@ std::optional<Coordinate> LineSegment::intersection_with_segment(const LineSegme
 Coordinate LineSegment::get_tangent_vector() const { return _endpoint_2 - _endpoint_1; }
 
 Orientation LineSegment::orientation_of_point_to_segment(const Coordinate &point) const {
-    const auto point_lon = point.get_longitude_microdegrees_long();
-    const auto point_lat = point.get_latitude_microdegrees_long();
-    const auto point_1_lon = _endpoint_1.get_longitude_microdegrees_long();
-    const auto point_1_lat = _endpoint_1.get_latitude_microdegrees_long();
-    const auto point_2_lon = _endpoint_2.get_longitude_microdegrees_long();
-    const auto point_2_lat = _endpoint_2.get_latitude_microdegrees_long();
-
-    const auto signed_area = (point_2_lon - point_1_lon) * (point_lat - point_1_lat) -
-                             (point_2_lat - point_1_lat) * (point_lon - point_1_lon);
-    if (signed_area > 0) {
-        return Orientation::COUNTER_CLOCKWISE;
-    }
-    if (signed_area < 0) {
-        return Orientation::CLOCKWISE;
-    }
-    return Orientation::COLLINEAR;
+    return ExactPredicates::orientation(_endpoint_1, _endpoint_2, point);
 }
 
 bool LineSegment::on_segment(const Coordinate &point) const {
@@ -95,13 +83,43 @@ bool LineSegment::on_segment(const Coordinate &point) const {
         return false;
     }
 
-    return ((_endpoint_1.get_longitude() <= point.get_longitude() &&
-             point.get_longitude() <= _endpoint_2.get_longitude()) ||
-            (_endpoint_2.get_longitude() <= point.get_longitude() &&
-             point.get_longitude() <= _endpoint_1.get_longitude())) &&
-           ((_endpoint_1.get_latitude() <= point.get_latitude() &&
-             point.get_latitude() <= _endpoint_2.get_latitude()) ||
-            (_endpoint_2.get_latitude() <= point.get_latitude() && point.get_latitude() <= _endpoint_1.get_latitude()));
+    const auto point_lon = point.get_longitude_microdegrees();
+    const auto point_lat = point.get_latitude_microdegrees();
+    const auto endpoint_1_lon = _endpoint_1.get_longitude_microdegrees();
+    const auto endpoint_1_lat = _endpoint_1.get_latitude_microdegrees();
+    const auto endpoint_2_lon = _endpoint_2.get_longitude_microdegrees();
+    const auto endpoint_2_lat = _endpoint_2.get_latitude_microdegrees();
+
+    return std::min(endpoint_1_lon, endpoint_2_lon) <= point_lon &&
+           point_lon <= std::max(endpoint_1_lon, endpoint_2_lon) &&
+           std::min(endpoint_1_lat, endpoint_2_lat) <= point_lat &&
+           point_lat <= std::max(endpoint_1_lat, endpoint_2_lat);
+}
+
+bool LineSegment::properly_intersects(const LineSegment &line_segment) const {
+    const auto o1 = orientation_of_point_to_segment(line_segment._endpoint_1);
+    const auto o2 = orientation_of_point_to_segment(line_segment._endpoint_2);
+    const auto o3 = line_segment.orientation_of_point_to_segment(_endpoint_1);
+    const auto o4 = line_segment.orientation_of_point_to_segment(_endpoint_2);
+
+    return o1 != Orientation::COLLINEAR && o2 != Orientation::COLLINEAR && o3 != Orientation::COLLINEAR &&
+           o4 != Orientation::COLLINEAR && o1 != o2 && o3 != o4;
+}
+
+double LineSegment::distance_to_point(const Coordinate &point) const {
+    const auto tangent = get_tangent_vector();
+    const auto endpoint_1_to_point = point - _endpoint_1;
+    const auto tangent_magnitude_squared = tangent.magnitude_squared();
+
+    if (tangent_magnitude_squared == 0) {
+        return endpoint_1_to_point.magnitude();
+    }
+
+    const auto t = std::clamp(tangent.dot_product(endpoint_1_to_point) / tangent_magnitude_squared, 0.0, 1.0);
+    const auto closest_longitude = _endpoint_1.get_longitude() + t * tangent.get_longitude();
+    const auto closest_latitude = _endpoint_1.get_latitude() + t * tangent.get_latitude();
+
+    return std::hypot(point.get_longitude() - closest_longitude, point.get_latitude() - closest_latitude);
 }
 
 Coordinate LineSegment::project(const Coordinate &point, float margin) const {
@@ -131,6 +149,16 @@ bool LineSegment::operator==(const LineSegment &other) const {
 
 bool LineSegment::operator!=(const LineSegment &other) const { return !((*this) == other); }
 
+bool LineSegment::operator<(const LineSegment &other) const {
+    const auto &lesser_endpoint = std::min(_endpoint_1, _endpoint_2);
+    const auto &greater_endpoint = std::max(_endpoint_1, _endpoint_2);
+    const auto &other_lesser_endpoint = std::min(other._endpoint_1, other._endpoint_2);
+    const auto &other_greater_endpoint = std::max(other._endpoint_1, other._endpoint_2);
+
+    return lesser_endpoint < other_lesser_endpoint ||
+           (lesser_endpoint == other_lesser_endpoint && greater_endpoint < other_greater_endpoint);
+}
+
 S2Polyline *LineSegment::to_s2_polyline() const {
     return new S2Polyline(std::vector<S2Point>{_endpoint_1.to_s2_point(), _endpoint_2.to_s2_point()});
 }
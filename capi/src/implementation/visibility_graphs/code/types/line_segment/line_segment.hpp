@@ -24,10 +24,15 @@ class LineSegment {
     [[nodiscard]] Coordinate get_tangent_vector() const;
     [[nodiscard]] Orientation orientation_of_point_to_segment(const Coordinate &point) const;
     [[nodiscard]] bool on_segment(const Coordinate &point) const;
+    // Whether the segments cross at a single point interior to both
+    [[nodiscard]] bool properly_intersects(const LineSegment &line_segment) const;
+    [[nodiscard]] double distance_to_point(const Coordinate &point) const;
     [[nodiscard]] Coordinate project(const Coordinate &point, float margin = 0.0f) const;
 
     bool operator==(const LineSegment &other) const;
     bool operator!=(const LineSegment &other) const;
+    // Orders by the lesser endpoint then the greater, so it agrees with == whichever way round the endpoints are
+    bool operator<(const LineSegment &other) const;
 
     [[nodiscard]] S2Polyline *to_s2_polyline() const;
 
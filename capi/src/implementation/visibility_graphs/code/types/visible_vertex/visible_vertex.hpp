@@ -5,6 +5,10 @@
 #ifndef CAPI_VISIBLE_VERTEX_HPP
 #define CAPI_VISIBLE_VERTEX_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include "types/coordinate/coordinate.hpp"
 
 struct VisibleVertex {
@@ -17,4 +21,12 @@ struct VisibleVertex {
 
 std::ostream &operator<<(std::ostream &outs, const VisibleVertex &coord);
 
+// Visible vertices of many observers, flattened. The vertices visible from observer i are
+// coords[offsets[i]] to coords[offsets[i + 1] - 1], so offsets holds one more entry than there are observers.
+struct VisibleVertexBatch {
+    std::vector<Coordinate> coords;
+    std::vector<uint8_t> is_visible_across_meridian;
+    std::vector<size_t> offsets;
+};
+
 #endif // CAPI_VISIBLE_VERTEX_HPP
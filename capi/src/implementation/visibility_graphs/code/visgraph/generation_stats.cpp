@@ -0,0 +1,59 @@
+#include <utility>
+
+#include "generation_stats.hpp"
+
+GenerationStats::GenerationStats() : _start_time(std::chrono::steady_clock::now()), _finish_time(_start_time) {}
+
+void GenerationStats::start(size_t num_observers, size_t num_threads) {
+    std::lock_guard<std::mutex> guard(_lifecycle_lock);
+
+    _num_observers.store(num_observers, std::memory_order_relaxed);
+    _num_completed_observers.store(0, std::memory_order_relaxed);
+    _num_emitted_edges.store(0, std::memory_order_relaxed);
+
+    _thread_busy_nanoseconds = std::make_unique<std::atomic<int64_t>[]>(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        _thread_busy_nanoseconds[i].store(0, std::memory_order_relaxed);
+    }
+    _num_threads = num_threads;
+
+    _start_time = std::chrono::steady_clock::now();
+    _finished = false;
+}
+
+void GenerationStats::record_observer(size_t thread_num, size_t num_emitted_edges,
+                                      std::chrono::steady_clock::duration busy_time) {
+    _num_completed_observers.fetch_add(1, std::memory_order_relaxed);
+    _num_emitted_edges.fetch_add(num_emitted_edges, std::memory_order_relaxed);
+    _thread_busy_nanoseconds[thread_num].fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(busy_time).count(), std::memory_order_relaxed);
+}
+
+void GenerationStats::finish() {
+    std::lock_guard<std::mutex> guard(_lifecycle_lock);
+
+    _finish_time = std::chrono::steady_clock::now();
+    _finished = true;
+}
+
+GenerationStatsSnapshot GenerationStats::snapshot() const {
+    std::lock_guard<std::mutex> guard(_lifecycle_lock);
+
+    auto thread_busy_seconds = std::vector<double>(_num_threads);
+    for (size_t i = 0; i < _num_threads; ++i) {
+        thread_busy_seconds[i] = static_cast<double>(_thread_busy_nanoseconds[i].load(std::memory_order_relaxed)) / 1e9;
+    }
+
+    const auto end_time = _finished ? _finish_time : std::chrono::steady_clock::now();
+    const auto elapsed_seconds = std::chrono::duration<double>(end_time - _start_time).count();
+    const auto num_completed_observers = _num_completed_observers.load(std::memory_order_relaxed);
+
+    return GenerationStatsSnapshot{
+        .num_observers = _num_observers.load(std::memory_order_relaxed),
+        .num_completed_observers = num_completed_observers,
+        .num_emitted_edges = _num_emitted_edges.load(std::memory_order_relaxed),
+        .thread_busy_seconds = std::move(thread_busy_seconds),
+        .elapsed_seconds = elapsed_seconds,
+        .observers_per_second = elapsed_seconds > 0 ? num_completed_observers / elapsed_seconds : 0.0,
+    };
+}
@@ -0,0 +1,51 @@
+#ifndef CAPI_GENERATION_STATS_HPP
+#define CAPI_GENERATION_STATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct GenerationStatsSnapshot {
+    size_t num_observers;
+    size_t num_completed_observers;
+    // Each edge is counted once per observer it was emitted from
+    size_t num_emitted_edges;
+    // Time each thread spent sweeping observers, rather than scheduling or waiting
+    std::vector<double> thread_busy_seconds;
+    double elapsed_seconds;
+    double observers_per_second;
+};
+
+// Progress of a visgraph generation, which may be polled from another thread while the generation runs.
+// Counters are relaxed atomics, so recording an observer costs a few uncontended increments.
+class GenerationStats {
+  public:
+    GenerationStats();
+
+    // Resets the stats for a generation sweeping num_observers observers on up to num_threads threads
+    void start(size_t num_observers, size_t num_threads);
+    // Thread-safe for distinct thread_nums
+    void record_observer(size_t thread_num, size_t num_emitted_edges, std::chrono::steady_clock::duration busy_time);
+    void finish();
+
+    [[nodiscard]] GenerationStatsSnapshot snapshot() const;
+
+  private:
+    std::atomic<size_t> _num_observers = 0;
+    std::atomic<size_t> _num_completed_observers = 0;
+    std::atomic<size_t> _num_emitted_edges = 0;
+    std::unique_ptr<std::atomic<int64_t>[]> _thread_busy_nanoseconds;
+    size_t _num_threads = 0;
+
+    std::chrono::steady_clock::time_point _start_time;
+    std::chrono::steady_clock::time_point _finish_time;
+    bool _finished = true;
+    // Guards the thread slots, start time and finish time against snapshots taken while starting or finishing
+    mutable std::mutex _lifecycle_lock;
+};
+
+#endif // CAPI_GENERATION_STATS_HPP
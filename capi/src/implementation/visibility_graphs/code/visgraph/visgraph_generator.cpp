@@ -3,73 +3,60 @@
 //
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <random>
 #include <stdexcept>
-#include <indicators/progress_bar.hpp>
-#include <omp.h>
 #include <fmt/core.h>
+#include <s2/s2cell.h>
+#include <s2/s2cell_id.h>
+#include <set>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "constants/constants.hpp"
 #include "coordinate_periodicity/coordinate_periodicity.hpp"
+#include "scheduling/work_stealing_scheduler.hpp"
+#include "serialization/generation_checkpoint.hpp"
+#include "serialization/sparse_graph_builder.hpp"
 #include "visgraph_generator.hpp"
 #include "vistree_generator.hpp"
 
+// Observers are scheduled in batches of spatially adjacent vertices, which share most of the segments they sweep
+static constexpr size_t OBSERVER_BATCH_SIZE = 16;
+
 VisgraphGenerator::VisgraphGenerator() = default;
 
-std::shared_ptr<Graph> VisgraphGenerator::generate(const std::vector<Polygon> &polygons) {
+std::shared_ptr<Graph> VisgraphGenerator::generate(const std::vector<Polygon> &polygons,
+                                                   double periodic_replication_margin, double max_edge_length,
+                                                   const std::shared_ptr<GenerationStats> &stats) {
     auto polygon_vertices = VisgraphGenerator::polygon_vertices(polygons);
     auto visgraph = std::make_shared<Graph>(polygons);
 
-    const auto periodic_polygons = make_polygons_periodic(polygons);
-    auto vistree_gen = VistreeGenerator(periodic_polygons);
-
-    size_t num_vertices = polygon_vertices.size();
-    indicators::ProgressBar bar {
-        indicators::option::BarWidth{50},
-        indicators::option::Start{"["},
-        indicators::option::Fill{"="},
-        indicators::option::Lead{">"},
-        indicators::option::Remainder{" "},
-        indicators::option::End{"]"},
-        indicators::option::PostfixText{"Generating Visibility Graph"},
-        indicators::option::ForegroundColor{indicators::Color::green},
-        indicators::option::FontStyles{std::vector<indicators::FontStyle>{indicators::FontStyle::bold}},
-        indicators::option::ShowElapsedTime{true},
-        indicators::option::ShowRemainingTime{true},
-        indicators::option::Stream{std::cout},
-        indicators::option::MaxProgress{num_vertices},
-    };
-
-#pragma omp parallel shared(visgraph, polygon_vertices, vistree_gen, num_vertices, bar) default(none)
-    {
-        size_t num_threads = omp_get_num_threads();
-
-        if (omp_get_thread_num() == 0) {
-            bar.set_option(indicators::option::MaxProgress{num_vertices / num_threads});
-            bar.set_option(indicators::option::PostfixText(fmt::format("Generating VisGraph ({} threads)", num_threads)));
-        }
+    // No edge can reach further across the meridian than the longest edge allowed
+    const auto replication_margin = std::min(periodic_replication_margin, max_edge_length);
+    const auto periodic_polygons = make_polygons_periodic(polygons, replication_margin);
+    auto vistree_gen = VistreeGenerator(periodic_polygons, replication_margin);
+    const auto index = VisgraphGenerator::make_bounded_visibility_index(polygons, max_edge_length);
 
-#pragma omp for schedule(dynamic)
-        for (size_t i = 0; i < num_vertices; ++i) { // NOLINT
-            const auto visible_vertices = vistree_gen.get_visible_vertices(polygon_vertices[i], true);
+    VisgraphGenerator::sort_spatially(polygon_vertices.begin(), polygon_vertices.end());
 
+    VisgraphGenerator::sweep_observers(
+        polygon_vertices, vistree_gen, index, max_edge_length,
+        [&](const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices) {
             for (const auto &visible_vertex : visible_vertices) {
-                visgraph->add_edge(polygon_vertices[i], visible_vertex.coord, visible_vertex.is_visible_across_meridian);
+                visgraph->add_edge(observer, visible_vertex.coord, visible_vertex.is_visible_across_meridian);
             }
-
-            if (omp_get_thread_num() == 0) {
-                bar.tick();
-            }
-        }
-    }
-
-    bar.mark_as_completed();
+        },
+        stats);
 
     return visgraph;
 }
 
 std::shared_ptr<Graph> VisgraphGenerator::generate_with_shuffled_range(const std::vector<Polygon> &polygons, size_t range_start,
-                                                      size_t range_end, unsigned int seed) {
+                                                      size_t range_end, unsigned int seed,
+                                                      double periodic_replication_margin, double max_edge_length) {
     auto polygon_vertices = VisgraphGenerator::polygon_vertices(polygons);
     auto visgraph = std::make_shared<Graph>(polygons);
     if (polygons.empty()) {
@@ -78,23 +65,340 @@ std::shared_ptr<Graph> VisgraphGenerator::generate_with_shuffled_range(const std
     if (range_start < 0 || range_end > polygon_vertices.size() || range_start > range_end) {
         throw std::runtime_error("Improper range for visgraph generation");
     }
-    auto vistree_gen = VistreeGenerator(make_polygons_periodic(polygons));
+    const auto replication_margin = std::min(periodic_replication_margin, max_edge_length);
+    auto vistree_gen = VistreeGenerator(make_polygons_periodic(polygons, replication_margin), replication_margin);
+    const auto index = VisgraphGenerator::make_bounded_visibility_index(polygons, max_edge_length);
 
     std::mt19937 gen(seed);
     std::shuffle(polygon_vertices.begin(), polygon_vertices.end(), gen);
+    VisgraphGenerator::sort_spatially(polygon_vertices.begin() + range_start, polygon_vertices.begin() + range_end);
 
-#pragma omp parallel for shared(visgraph, vistree_gen, polygon_vertices, range_start, range_end) default(none) schedule(dynamic)
-    for (size_t i = range_start; i < range_end; ++i) { // NOLINT
-        const auto visible_vertices = vistree_gen.get_visible_vertices(polygon_vertices[i], true);
+    VisgraphGenerator::sweep_observers(
+        std::vector<Coordinate>(polygon_vertices.begin() + range_start, polygon_vertices.begin() + range_end),
+        vistree_gen, index, max_edge_length,
+        [&](const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices) {
+            for (const auto &visible_vertex : visible_vertices) {
+                visgraph->add_edge(observer, visible_vertex.coord, visible_vertex.is_visible_across_meridian);
+            }
+        });
+
+    return visgraph;
+}
 
-        for (const auto &visible_vertex : visible_vertices) {
-            visgraph->add_edge(polygon_vertices[i], visible_vertex.coord, visible_vertex.is_visible_across_meridian);
+std::shared_ptr<Graph> VisgraphGenerator::generate_with_checkpoints(const std::vector<Polygon> &polygons,
+                                                                    const std::string &checkpoint_path,
+                                                                    double periodic_replication_margin,
+                                                                    double max_edge_length,
+                                                                    size_t checkpoint_interval,
+                                                                    const std::shared_ptr<GenerationStats> &stats) {
+    auto checkpoint = GenerationCheckpoint(
+        checkpoint_path,
+        VisgraphGenerator::generation_fingerprint(polygons, periodic_replication_margin, max_edge_length),
+        checkpoint_interval);
+    auto visgraph = std::make_shared<Graph>(polygons);
+    checkpoint.replay_into(visgraph);
+
+    auto remaining_vertices = std::vector<Coordinate>();
+    for (const auto &vertex : VisgraphGenerator::polygon_vertices(polygons)) {
+        if (!checkpoint.is_completed(vertex)) {
+            remaining_vertices.push_back(vertex);
         }
     }
 
+    const auto replication_margin = std::min(periodic_replication_margin, max_edge_length);
+    auto vistree_gen = VistreeGenerator(make_polygons_periodic(polygons, replication_margin), replication_margin);
+    const auto index = VisgraphGenerator::make_bounded_visibility_index(polygons, max_edge_length);
+
+    VisgraphGenerator::sort_spatially(remaining_vertices.begin(), remaining_vertices.end());
+
+    VisgraphGenerator::sweep_observers(
+        remaining_vertices, vistree_gen, index, max_edge_length,
+        [&](const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices) {
+            for (const auto &visible_vertex : visible_vertices) {
+                visgraph->add_edge(observer, visible_vertex.coord, visible_vertex.is_visible_across_meridian);
+            }
+
+            checkpoint.record(observer, visible_vertices);
+        },
+        stats);
+
+    checkpoint.flush();
+
     return visgraph;
 }
 
+void VisgraphGenerator::generate_to_sparse_file(const std::vector<Polygon> &polygons, const std::string &output_path,
+                                                size_t memory_limit_bytes, double periodic_replication_margin,
+                                                double max_edge_length,
+                                                const std::shared_ptr<GenerationStats> &stats) {
+    auto polygon_vertices = VisgraphGenerator::polygon_vertices(polygons);
+    auto builder = SparseGraphBuilder(polygons, output_path + ".runs", memory_limit_bytes);
+
+    const auto replication_margin = std::min(periodic_replication_margin, max_edge_length);
+    auto vistree_gen = VistreeGenerator(make_polygons_periodic(polygons, replication_margin), replication_margin);
+    const auto index = VisgraphGenerator::make_bounded_visibility_index(polygons, max_edge_length);
+
+    VisgraphGenerator::sort_spatially(polygon_vertices.begin(), polygon_vertices.end());
+
+    VisgraphGenerator::sweep_observers(
+        polygon_vertices, vistree_gen, index, max_edge_length,
+        [&](const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices) {
+            builder.add_edges(observer, visible_vertices);
+        },
+        stats);
+
+    builder.finalize(output_path);
+}
+
+std::shared_ptr<Graph> VisgraphGenerator::generate_coarse(const std::vector<Polygon> &polygons,
+                                                          const std::vector<Polygon> &coarse_polygons,
+                                                          double periodic_replication_margin, double max_edge_length,
+                                                          const std::shared_ptr<GenerationStats> &stats) {
+    auto coarse_vertices = VisgraphGenerator::polygon_vertices(coarse_polygons);
+    auto coarse_visgraph = std::make_shared<Graph>(coarse_polygons);
+
+    const auto detailed_vertices = VisgraphGenerator::polygon_vertices(polygons);
+    const auto detailed_vertex_set = std::unordered_set<Coordinate>(detailed_vertices.begin(), detailed_vertices.end());
+    for (const auto &vertex : coarse_vertices) {
+        if (detailed_vertex_set.find(vertex) == detailed_vertex_set.end()) {
+            throw std::runtime_error(fmt::format("Coarse vertex {} is not a vertex of the detailed polygons",
+                                                 vertex.to_string_representation()));
+        }
+    }
+
+    // Visibility is swept among the detailed polygons, but only from and to the coarse vertices
+    const auto replication_margin = std::min(periodic_replication_margin, max_edge_length);
+    auto vistree_gen = VistreeGenerator(make_polygons_periodic(polygons, replication_margin), replication_margin);
+    const auto index = VisgraphGenerator::make_bounded_visibility_index(polygons, max_edge_length);
+
+    VisgraphGenerator::sort_spatially(coarse_vertices.begin(), coarse_vertices.end());
+
+    VisgraphGenerator::sweep_observers(
+        coarse_vertices, vistree_gen, index, max_edge_length,
+        [&](const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices) {
+            for (const auto &visible_vertex : visible_vertices) {
+                if (coarse_visgraph->has_vertex(visible_vertex.coord)) {
+                    coarse_visgraph->add_edge(observer, visible_vertex.coord,
+                                              visible_vertex.is_visible_across_meridian);
+                }
+            }
+        },
+        stats);
+
+    return coarse_visgraph;
+}
+
+std::shared_ptr<Graph> VisgraphGenerator::update(const std::shared_ptr<Graph> &graph,
+                                                 const std::vector<Polygon> &added_polygons,
+                                                 const std::vector<Polygon> &removed_polygons,
+                                                 double periodic_replication_margin, double max_edge_length) {
+    auto polygons_to_remove = std::unordered_set<Polygon>(removed_polygons.begin(), removed_polygons.end());
+    auto polygons = std::vector<Polygon>();
+    auto removed_vertices = std::unordered_set<Coordinate>();
+    for (const auto &polygon : graph->get_polygons()) {
+        if (polygons_to_remove.erase(polygon) == 0) {
+            polygons.push_back(polygon);
+        } else {
+            removed_vertices.insert(polygon.get_vertices().begin(), polygon.get_vertices().end());
+        }
+    }
+    if (!polygons_to_remove.empty()) {
+        throw std::runtime_error("Polygons to remove are not part of the graph");
+    }
+    polygons.insert(polygons.end(), added_polygons.begin(), added_polygons.end());
+
+    auto visgraph = std::make_shared<Graph>(polygons);
+
+    auto added_segments = std::vector<LineSegment>();
+    for (const auto &polygon : added_polygons) {
+        const auto segments = polygon.get_line_segments();
+        added_segments.insert(added_segments.end(), segments.begin(), segments.end());
+    }
+
+    const auto old_vertices = graph->get_vertices();
+    auto old_vertex_indices = std::unordered_map<Coordinate, size_t>();
+    for (size_t i = 0; i < old_vertices.size(); ++i) {
+        old_vertex_indices[old_vertices[i]] = i;
+    }
+
+    // Carry over the surviving edges, except those the added polygons now obstruct.
+    // Edges merely touching an added polygon may or may not still be visible, so their endpoints are swept again.
+    auto observers = std::unordered_set<Coordinate>();
+#pragma omp parallel for shared(graph, visgraph, old_vertices, old_vertex_indices, removed_vertices, added_segments, \
+                                observers) default(none) schedule(dynamic)
+    for (size_t i = 0; i < old_vertices.size(); ++i) { // NOLINT
+        const auto &vertex = old_vertices[i];
+        if (removed_vertices.find(vertex) != removed_vertices.end()) {
+            continue;
+        }
+
+        for (const auto &neighbor : graph->get_neighbors(vertex)) {
+            if (old_vertex_indices.at(neighbor) < i || removed_vertices.find(neighbor) != removed_vertices.end()) {
+                continue;
+            }
+
+            const auto meridian_crossing = graph->is_edge_meridian_crossing(vertex, neighbor);
+            const auto edge_segments = VisgraphGenerator::planar_edge_segments(vertex, neighbor, meridian_crossing);
+            bool crosses = false;
+            bool touches = false;
+            for (const auto &edge_segment : edge_segments) {
+                for (const auto &added_segment : added_segments) {
+                    crosses = crosses || edge_segment.properly_intersects(added_segment);
+                    touches = touches || edge_segment.on_segment(added_segment.get_endpoint_1()) ||
+                              added_segment.on_segment(edge_segment.get_endpoint_1()) ||
+                              added_segment.on_segment(edge_segment.get_endpoint_2());
+                }
+            }
+
+            if (!crosses && !touches) {
+                visgraph->add_edge(vertex, neighbor, meridian_crossing);
+            } else if (!crosses) {
+#pragma omp critical
+                {
+                    observers.insert(vertex);
+                    observers.insert(neighbor);
+                }
+            }
+        }
+    }
+
+    for (const auto &polygon : added_polygons) {
+        observers.insert(polygon.get_vertices().begin(), polygon.get_vertices().end());
+    }
+    for (const auto &vertex : visgraph->get_vertices()) {
+        for (const auto &polygon : removed_polygons) {
+            if (VisgraphGenerator::is_within_distance_of_polygon(vertex, polygon, max_edge_length)) {
+                observers.insert(vertex);
+                break;
+            }
+        }
+    }
+
+    const auto replication_margin = std::min(periodic_replication_margin, max_edge_length);
+    auto vistree_gen = VistreeGenerator(make_polygons_periodic(polygons, replication_margin), replication_margin);
+    const auto index = VisgraphGenerator::make_bounded_visibility_index(polygons, max_edge_length);
+
+    auto observer_vertices = std::vector<Coordinate>(observers.begin(), observers.end());
+    VisgraphGenerator::sort_spatially(observer_vertices.begin(), observer_vertices.end());
+
+    VisgraphGenerator::sweep_observers(
+        observer_vertices, vistree_gen, index, max_edge_length,
+        [&](const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices) {
+            for (const auto &visible_vertex : visible_vertices) {
+                visgraph->add_edge(observer, visible_vertex.coord, visible_vertex.is_visible_across_meridian);
+            }
+        },
+        nullptr, false);
+
+    return visgraph;
+}
+
+std::vector<uint64_t> VisgraphGenerator::tile_ids(const std::vector<Polygon> &polygons, int tile_level) {
+    if (tile_level < 0 || tile_level > S2CellId::kMaxLevel) {
+        throw std::runtime_error(fmt::format("Tile level {} is not a valid S2 cell level", tile_level));
+    }
+
+    auto tiles = std::set<uint64_t>();
+    for (const auto &vertex : VisgraphGenerator::polygon_vertices(polygons)) {
+        tiles.insert(VisgraphGenerator::tile_of(vertex, tile_level));
+    }
+
+    return {tiles.begin(), tiles.end()};
+}
+
+std::shared_ptr<Graph> VisgraphGenerator::generate_tile(const std::vector<Polygon> &polygons, uint64_t tile_id,
+                                                        double halo, double periodic_replication_margin) {
+    const auto tile_cell_id = S2CellId(tile_id);
+    if (!tile_cell_id.is_valid()) {
+        throw std::runtime_error(fmt::format("Tile id {} is not a valid S2 cell id", tile_id));
+    }
+    if (!(halo > 0) || std::isinf(halo)) {
+        throw std::runtime_error("Tile halo must be positive and finite");
+    }
+
+    const auto tile_polygons = VisgraphGenerator::polygons_near_tile(polygons, tile_id, halo);
+    auto visgraph = std::make_shared<Graph>(tile_polygons);
+
+    auto tile_vertices = std::vector<Coordinate>();
+    for (const auto &vertex : VisgraphGenerator::polygon_vertices(tile_polygons)) {
+        if (VisgraphGenerator::tile_of(vertex, tile_cell_id.level()) == tile_id) {
+            tile_vertices.push_back(vertex);
+        }
+    }
+
+    const auto replication_margin = std::min(periodic_replication_margin, halo);
+    auto vistree_gen = VistreeGenerator(make_polygons_periodic(tile_polygons, replication_margin), replication_margin);
+    const auto index = VisgraphGenerator::make_bounded_visibility_index(tile_polygons, halo);
+
+    VisgraphGenerator::sort_spatially(tile_vertices.begin(), tile_vertices.end());
+
+    VisgraphGenerator::sweep_observers(
+        tile_vertices, vistree_gen, index, halo,
+        [&](const Coordinate &observer, const std::vector<VisibleVertex> &visible_vertices) {
+            for (const auto &visible_vertex : visible_vertices) {
+                visgraph->add_edge(observer, visible_vertex.coord, visible_vertex.is_visible_across_meridian);
+            }
+        });
+
+    return visgraph;
+}
+
+std::shared_ptr<Graph> VisgraphGenerator::generate_tiled(const std::vector<Polygon> &polygons, int tile_level,
+                                                         double halo, double periodic_replication_margin) {
+    auto tile_graphs = std::vector<std::shared_ptr<Graph>>();
+    for (const auto tile_id : VisgraphGenerator::tile_ids(polygons, tile_level)) {
+        tile_graphs.push_back(VisgraphGenerator::generate_tile(polygons, tile_id, halo, periodic_replication_margin));
+    }
+
+    return merge_graphs(tile_graphs);
+}
+
+void VisgraphGenerator::sweep_observers(
+    const std::vector<Coordinate> &observers, const VistreeGenerator &vistree_gen,
+    const std::unique_ptr<SpatialSegmentIndex> &index, double max_edge_length,
+    const std::function<void(const Coordinate &, const std::vector<VisibleVertex> &)> &on_visible_vertices,
+    const std::shared_ptr<GenerationStats> &stats, bool half_scan) {
+    const auto scheduler = WorkStealingScheduler();
+    if (stats != nullptr) {
+        stats->start(observers.size(), scheduler.get_num_threads());
+    }
+
+    scheduler.run(observers.size(), OBSERVER_BATCH_SIZE, [&](size_t i, size_t thread_num) {
+        const auto sweep_start = std::chrono::steady_clock::now();
+        const auto visible_vertices =
+            VisgraphGenerator::visible_vertices(vistree_gen, index, observers[i], max_edge_length, half_scan);
+        on_visible_vertices(observers[i], visible_vertices);
+
+        if (stats != nullptr) {
+            stats->record_observer(thread_num, visible_vertices.size(), std::chrono::steady_clock::now() - sweep_start);
+        }
+    });
+
+    if (stats != nullptr) {
+        stats->finish();
+    }
+}
+
+std::unique_ptr<SpatialSegmentIndex>
+VisgraphGenerator::make_bounded_visibility_index(const std::vector<Polygon> &polygons, double max_edge_length) {
+    if (std::isinf(max_edge_length)) {
+        return nullptr;
+    }
+
+    return std::make_unique<SpatialSegmentIndex>(polygons);
+}
+
+std::vector<VisibleVertex> VisgraphGenerator::visible_vertices(const VistreeGenerator &vistree_gen,
+                                                               const std::unique_ptr<SpatialSegmentIndex> &index,
+                                                               const Coordinate &observer, double max_edge_length,
+                                                               bool half_scan) {
+    if (index == nullptr) {
+        return vistree_gen.get_visible_vertices(observer, half_scan);
+    }
+
+    return vistree_gen.get_visible_vertices_within_distance(observer, *index, max_edge_length, half_scan);
+}
+
 std::vector<Coordinate> VisgraphGenerator::polygon_vertices(const std::vector<Polygon> &polygons) {
     auto vertices = std::vector<Coordinate>();
 
@@ -105,3 +409,111 @@ std::vector<Coordinate> VisgraphGenerator::polygon_vertices(const std::vector<Po
 
     return vertices;
 }
+
+std::vector<Polygon> VisgraphGenerator::polygons_near_tile(const std::vector<Polygon> &polygons, uint64_t tile_id,
+                                                           double halo) {
+    const auto tile_bound = S2Cell(S2CellId(tile_id)).GetRectBound();
+
+    const auto min_latitude = tile_bound.lat_lo().degrees() - halo;
+    const auto max_latitude = tile_bound.lat_hi().degrees() + halo;
+    auto min_longitude = tile_bound.lng_lo().degrees() - halo;
+    auto max_longitude = tile_bound.lng_hi().degrees() + halo;
+    if (tile_bound.lng().is_inverted()) {
+        // Tile spans the antimeridian
+        max_longitude += LONGITUDE_PERIOD;
+    }
+
+    auto polygons_near = std::vector<Polygon>();
+    for (const auto &polygon : polygons) {
+        double polygon_min_longitude = INFINITY;
+        double polygon_max_longitude = -INFINITY;
+        double polygon_min_latitude = INFINITY;
+        double polygon_max_latitude = -INFINITY;
+        for (const auto &vertex : polygon.get_vertices()) {
+            polygon_min_longitude = std::min(polygon_min_longitude, vertex.get_longitude());
+            polygon_max_longitude = std::max(polygon_max_longitude, vertex.get_longitude());
+            polygon_min_latitude = std::min(polygon_min_latitude, vertex.get_latitude());
+            polygon_max_latitude = std::max(polygon_max_latitude, vertex.get_latitude());
+        }
+
+        if (polygon_max_latitude < min_latitude || polygon_min_latitude > max_latitude) {
+            continue;
+        }
+
+        // The halo may reach across the meridian
+        for (const auto shift : {-LONGITUDE_PERIOD, 0.0, LONGITUDE_PERIOD}) {
+            if (polygon_min_longitude + shift <= max_longitude && polygon_max_longitude + shift >= min_longitude) {
+                polygons_near.push_back(polygon);
+                break;
+            }
+        }
+    }
+
+    return polygons_near;
+}
+
+void VisgraphGenerator::sort_spatially(std::vector<Coordinate>::iterator begin, std::vector<Coordinate>::iterator end) {
+    // S2 cell ids follow a Hilbert curve, so vertices close in the order are close on the globe
+    auto keyed_vertices = std::vector<std::pair<uint64_t, Coordinate>>();
+    keyed_vertices.reserve(std::distance(begin, end));
+    for (auto iter = begin; iter != end; ++iter) {
+        keyed_vertices.emplace_back(S2CellId(iter->to_s2_point()).id(), *iter);
+    }
+
+    std::sort(keyed_vertices.begin(), keyed_vertices.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    std::transform(keyed_vertices.begin(), keyed_vertices.end(), begin,
+                   [](const auto &keyed_vertex) { return keyed_vertex.second; });
+}
+
+uint64_t VisgraphGenerator::tile_of(const Coordinate &coordinate, int tile_level) {
+    return S2CellId(coordinate.to_s2_point()).parent(tile_level).id();
+}
+
+std::vector<LineSegment> VisgraphGenerator::planar_edge_segments(const Coordinate &a, const Coordinate &b,
+                                                                 bool meridian_crossing) {
+    if (!meridian_crossing) {
+        return {LineSegment(a, b)};
+    }
+
+    // Meridian crossing edges leave the world on one side and re-enter on the other
+    const auto period = Coordinate(LONGITUDE_PERIOD_MICRODEGREES, 0);
+    const auto b_beside_a = b.get_longitude() > a.get_longitude() ? b - period : b + period;
+    const auto a_beside_b = a.get_longitude() > b.get_longitude() ? a - period : a + period;
+
+    return {LineSegment(a, b_beside_a), LineSegment(a_beside_b, b)};
+}
+
+bool VisgraphGenerator::is_within_distance_of_polygon(const Coordinate &point, const Polygon &polygon,
+                                                      double distance) {
+    if (std::isinf(distance)) {
+        return true;
+    }
+
+    for (const auto &segment : polygon.get_line_segments()) {
+        for (const auto shift : {-LONGITUDE_PERIOD_MICRODEGREES, 0, LONGITUDE_PERIOD_MICRODEGREES}) {
+            if (segment.distance_to_point(point + Coordinate(shift, 0)) <= distance) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+uint64_t VisgraphGenerator::generation_fingerprint(const std::vector<Polygon> &polygons,
+                                                   double periodic_replication_margin, double max_edge_length) {
+    uint64_t fingerprint = polygons.size();
+    const auto combine = [&fingerprint](uint64_t val) {
+        fingerprint ^= val + 0x9e3779b9 + (fingerprint << 6) + (fingerprint >> 2);
+    };
+
+    for (const auto &polygon : polygons) {
+        combine(std::hash<Polygon>()(polygon));
+    }
+    combine(std::hash<double>()(periodic_replication_margin));
+    combine(std::hash<double>()(max_edge_length));
+
+    return fingerprint;
+}
@@ -6,23 +6,116 @@
 #ifndef CAPI_VISGRAPH_GENERATOR_HPP
 #define CAPI_VISGRAPH_GENERATOR_HPP
 
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <memory>
-#include <iostream>
+#include <string>
 
 #include "datastructures/graph/graph.hpp"
+#include "datastructures/spatial_segment_index/spatial_segment_index.hpp"
 #include "types/polygon/polygon.hpp"
+#include "types/visible_vertex/visible_vertex.hpp"
+#include "visgraph/generation_stats.hpp"
+#include "visgraph/vistree_generator.hpp"
 
 class VisgraphGenerator {
   public:
     explicit VisgraphGenerator();
 
-    [[nodiscard]] static std::shared_ptr<Graph> generate(const std::vector<Polygon> &polygons);
+    // periodic_replication_margin bounds (in degrees) how far across the meridian visibility is computed.
+    // Polygons further from the meridian than this are not replicated, shrinking every sweep.
+    //
+    // max_edge_length (in degrees) skips every edge longer than it, and only sweeps the segments near each vertex.
+    // Shortest paths then chain shorter edges instead, so it must exceed the widest stretch of open water
+    // which has to be crossed without passing another vertex.
+    //
+    // Progress is recorded in stats, if given, which may be polled while generation runs.
+    [[nodiscard]] static std::shared_ptr<Graph> generate(const std::vector<Polygon> &polygons,
+                                                         double periodic_replication_margin = INFINITY,
+                                                         double max_edge_length = INFINITY,
+                                                         const std::shared_ptr<GenerationStats> &stats = nullptr);
     [[nodiscard]] static std::shared_ptr<Graph> generate_with_shuffled_range(const std::vector<Polygon> &polygons, size_t range_start,
-                                                            size_t range_end, unsigned int seed);
+                                                            size_t range_end, unsigned int seed,
+                                                            double periodic_replication_margin = INFINITY,
+                                                            double max_edge_length = INFINITY);
+
+    // Records completed observers in the checkpoint at checkpoint_path as generation progresses.
+    // If the checkpoint already exists, generation resumes from it, skipping the observers it holds.
+    // The checkpoint must have been written for the same polygons and parameters.
+    [[nodiscard]] static std::shared_ptr<Graph>
+    generate_with_checkpoints(const std::vector<Polygon> &polygons, const std::string &checkpoint_path,
+                              double periodic_replication_margin = INFINITY, double max_edge_length = INFINITY,
+                              size_t checkpoint_interval = 1000,
+                              const std::shared_ptr<GenerationStats> &stats = nullptr);
+
+    // Generates the graph straight into a sparse graph file at output_path (see SparseGraphSerializer) without
+    // allocating the dense graph. Edges are buffered in up to memory_limit_bytes, then spilled to sorted runs in
+    // output_path + ".runs", which are merged into the file once every observer has been swept.
+    static void generate_to_sparse_file(const std::vector<Polygon> &polygons, const std::string &output_path,
+                                        size_t memory_limit_bytes, double periodic_replication_margin = INFINITY,
+                                        double max_edge_length = INFINITY,
+                                        const std::shared_ptr<GenerationStats> &stats = nullptr);
+
+    // Generates the coarse level of a hierarchical graph (see ShortestPathComputer) over coarse_polygons, which must
+    // be simplified from polygons so their vertices are a subset of the polygons' vertices. Simplifying outwards (see
+    // PolygonSimplifier::simplify_outwards) keeps the vertices paths bend around.
+    // Coarse vertices are connected when they are visible to one another among the detailed polygons, so every
+    // coarse edge is also an edge of the detailed graph.
+    [[nodiscard]] static std::shared_ptr<Graph>
+    generate_coarse(const std::vector<Polygon> &polygons, const std::vector<Polygon> &coarse_polygons,
+                    double periodic_replication_margin = INFINITY, double max_edge_length = INFINITY,
+                    const std::shared_ptr<GenerationStats> &stats = nullptr);
+
+    // Updates a graph for polygons being added or removed (edited polygons are removed and re-added) without
+    // regenerating it. Edges now crossing the added polygons are dropped and edges touching removed polygons go.
+    // Only the added vertices, and the vertices within max_edge_length of a removed polygon, are swept again.
+    // Removals are therefore only local for graphs generated with a bounded max_edge_length.
+    // The generation parameters must match those the graph was generated with.
+    [[nodiscard]] static std::shared_ptr<Graph> update(const std::shared_ptr<Graph> &graph,
+                                                       const std::vector<Polygon> &added_polygons,
+                                                       const std::vector<Polygon> &removed_polygons,
+                                                       double periodic_replication_margin = INFINITY,
+                                                       double max_edge_length = INFINITY);
+
+    // Tiles are the S2 cells at tile_level holding at least one polygon vertex.
+    // Each tile's graph holds the edges from the vertices inside the tile, generated against only the polygons
+    // within halo (in degrees) of the tile. Edges are capped at the halo length, so the halo contains every
+    // polygon which could obstruct them. Graphs of all tiles merge (see merge_graphs) into the full bounded graph.
+    //
+    // Polygons reaching into the halo are kept whole, so tiles over large polygons stay large.
+    [[nodiscard]] static std::vector<uint64_t> tile_ids(const std::vector<Polygon> &polygons, int tile_level);
+    [[nodiscard]] static std::shared_ptr<Graph> generate_tile(const std::vector<Polygon> &polygons, uint64_t tile_id,
+                                                              double halo,
+                                                              double periodic_replication_margin = INFINITY);
+    [[nodiscard]] static std::shared_ptr<Graph> generate_tiled(const std::vector<Polygon> &polygons, int tile_level,
+                                                               double halo,
+                                                               double periodic_replication_margin = INFINITY);
 
   private:
+    // Sweeps from every observer in parallel, passing each observer's visible vertices to on_visible_vertices
+    static void sweep_observers(
+        const std::vector<Coordinate> &observers, const VistreeGenerator &vistree_gen,
+        const std::unique_ptr<SpatialSegmentIndex> &index, double max_edge_length,
+        const std::function<void(const Coordinate &, const std::vector<VisibleVertex> &)> &on_visible_vertices,
+        const std::shared_ptr<GenerationStats> &stats = nullptr, bool half_scan = true);
+    static std::unique_ptr<SpatialSegmentIndex> make_bounded_visibility_index(const std::vector<Polygon> &polygons,
+                                                                              double max_edge_length);
+    static std::vector<VisibleVertex> visible_vertices(const VistreeGenerator &vistree_gen,
+                                                       const std::unique_ptr<SpatialSegmentIndex> &index,
+                                                       const Coordinate &observer, double max_edge_length,
+                                                       bool half_scan = true);
     static std::vector<Coordinate> polygon_vertices(const std::vector<Polygon> &polygons);
+    static std::vector<Polygon> polygons_near_tile(const std::vector<Polygon> &polygons, uint64_t tile_id,
+                                                   double halo);
+    static void sort_spatially(std::vector<Coordinate>::iterator begin, std::vector<Coordinate>::iterator end);
+    static uint64_t tile_of(const Coordinate &coordinate, int tile_level);
+    static std::vector<LineSegment> planar_edge_segments(const Coordinate &a, const Coordinate &b,
+                                                         bool meridian_crossing);
+    static bool is_within_distance_of_polygon(const Coordinate &point, const Polygon &polygon, double distance);
+    static uint64_t generation_fingerprint(const std::vector<Polygon> &polygons, double periodic_replication_margin,
+                                           double max_edge_length);
 };
 
 #endif // CAPI_VISGRAPH_GENERATOR_HPP
@@ -2,17 +2,33 @@
 // Created by James.Balajan on 6/04/2021.
 //
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <unordered_set>
 
 #include "constants/constants.hpp"
 #include "coordinate_periodicity/coordinate_periodicity.hpp"
+#include "datastructures/sweep_arena/sweep_arena.hpp"
 #include "geom/angle_sorter/angle_sorter.hpp"
+#include "geom/exact_predicates/exact_predicates.hpp"
+#include "geom/segment_kernels/segment_kernels.hpp"
+#include "scheduling/work_stealing_scheduler.hpp"
 #include "types/polyline/three_vertex_polyline.hpp"
 #include "vistree_generator.hpp"
 
 VistreeGenerator::VistreeGenerator(const std::vector<Polygon> &polygons)
-    : _vertices_and_segments(VistreeGenerator::all_vertices_and_incident_segments(polygons)) {}
+    : _vertices_and_segments(VistreeGenerator::all_vertices_and_incident_segments(polygons)),
+      _longest_segment_length(VistreeGenerator::longest_segment_length(_vertices_and_segments)),
+      _all_vertices(VistreeGenerator::all_vertices(_vertices_and_segments)),
+      _all_line_segments(VistreeGenerator::all_line_segments(_vertices_and_segments)) {}
+
+VistreeGenerator::VistreeGenerator(const std::vector<Polygon> &polygons, double periodic_replication_margin)
+    : _vertices_and_segments(VistreeGenerator::all_vertices_and_incident_segments(polygons)),
+      _periodic_replication_margin(periodic_replication_margin),
+      _longest_segment_length(VistreeGenerator::longest_segment_length(_vertices_and_segments)),
+      _all_vertices(VistreeGenerator::all_vertices(_vertices_and_segments)),
+      _all_line_segments(VistreeGenerator::all_line_segments(_vertices_and_segments)) {}
 
 VistreeGenerator::VistreeGenerator(const std::vector<std::shared_ptr<LineSegment>> &segments) {
     _vertices_and_segments = VistreeGenerator::VertexToSegmentMapping();
@@ -30,11 +46,41 @@ VistreeGenerator::VistreeGenerator(const std::vector<std::shared_ptr<LineSegment
         _vertices_and_segments[p1].push_back(segment);
         _vertices_and_segments[p2].push_back(segment);
     }
+
+    _longest_segment_length = VistreeGenerator::longest_segment_length(_vertices_and_segments);
+    _all_vertices = VistreeGenerator::all_vertices(_vertices_and_segments);
+    _all_line_segments = VistreeGenerator::all_line_segments(_vertices_and_segments);
 }
 
 std::vector<VisibleVertex> VistreeGenerator::get_visible_vertices(const Coordinate &observer, bool half_scan) const {
-    return get_visible_vertices_from_candidate_segments_and_vertices(observer, VistreeGenerator::all_vertices(),
-                                                                     VistreeGenerator::all_line_segments(), half_scan);
+    return get_visible_vertices_from_candidate_segments_and_vertices(observer, _all_vertices, _all_line_segments,
+                                                                     half_scan);
+}
+
+VisibleVertexBatch VistreeGenerator::get_visible_vertices_batch(const std::vector<Coordinate> &observers,
+                                                                bool half_scan) const {
+    auto visible_vertices = std::vector<std::vector<VisibleVertex>>(observers.size());
+    WorkStealingScheduler().run(observers.size(), 1, [&](size_t observer_num, size_t) {
+        visible_vertices[observer_num] = get_visible_vertices(observers[observer_num], half_scan);
+    });
+
+    auto batch = VisibleVertexBatch();
+    batch.offsets.reserve(observers.size() + 1);
+    batch.offsets.push_back(0);
+    for (const auto &observer_visible_vertices : visible_vertices) {
+        batch.offsets.push_back(batch.offsets.back() + observer_visible_vertices.size());
+    }
+
+    batch.coords.reserve(batch.offsets.back());
+    batch.is_visible_across_meridian.reserve(batch.offsets.back());
+    for (const auto &observer_visible_vertices : visible_vertices) {
+        for (const auto &visible_vertex : observer_visible_vertices) {
+            batch.coords.push_back(visible_vertex.coord);
+            batch.is_visible_across_meridian.push_back(visible_vertex.is_visible_across_meridian);
+        }
+    }
+
+    return batch;
 }
 
 std::vector<VisibleVertex> VistreeGenerator::get_visible_vertices_from_candidate_segments(
@@ -44,33 +90,107 @@ std::vector<VisibleVertex> VistreeGenerator::get_visible_vertices_from_candidate
         observer, all_vertices_for_line_segments(candidate_segments), candidate_segments, half_scan);
 }
 
+std::vector<VisibleVertex> VistreeGenerator::get_visible_vertices_within_distance(const Coordinate &observer,
+                                                                                 const SpatialSegmentIndex &index,
+                                                                                 double max_distance,
+                                                                                 bool half_scan) const {
+    // A segment within max_distance of the observer (in the plane) has an endpoint within
+    // max_distance + half its length, and the spherical distance never exceeds the planar distance in degrees.
+    // Searching this radius therefore never misses an obstruction. The extra microdegree covers the period offset.
+    const auto search_radius_degrees = max_distance + (_longest_segment_length / 2) + 1e-6;
+    const auto search_radius_radians = search_radius_degrees * M_PI / 180.0;
+    const auto nearby_segments =
+        index.segments_within_distance_of_point(coordinate_from_periodic_coordinate(observer), search_radius_radians);
+
+    auto periodic_segments = std::vector<LineSegment>();
+    periodic_segments.reserve(nearby_segments.size());
+    for (const auto &segment : nearby_segments) {
+        const auto periodic_endpoint_1 = periodic_coordinates_from_coordinate(segment.get_endpoint_1());
+        const auto periodic_endpoint_2 = periodic_coordinates_from_coordinate(segment.get_endpoint_2());
+
+        for (size_t i = 0; i < periodic_endpoint_1.size(); ++i) {
+            if (_vertices_and_segments.find(periodic_endpoint_1[i]) == _vertices_and_segments.end() ||
+                _vertices_and_segments.find(periodic_endpoint_2[i]) == _vertices_and_segments.end()) {
+                continue;
+            }
+
+            periodic_segments.emplace_back(periodic_endpoint_1[i], periodic_endpoint_2[i]);
+        }
+    }
+
+    // The vectorised test rejects most segments, leaving only the few near the threshold to be checked exactly
+    auto periodic_segment_block = SegmentBlock();
+    periodic_segment_block.reserve(periodic_segments.size());
+    for (const auto &segment : periodic_segments) {
+        periodic_segment_block.push_back(segment);
+    }
+    auto possibly_within_distance = std::vector<uint8_t>(periodic_segments.size());
+    SegmentKernels::segments_possibly_within_distance(periodic_segment_block, observer, max_distance,
+                                                      possibly_within_distance.data());
+
+    auto candidate_segments = std::vector<std::shared_ptr<LineSegment>>();
+    candidate_segments.reserve(periodic_segments.size());
+    for (size_t i = 0; i < periodic_segments.size(); ++i) {
+        if (possibly_within_distance[i] && periodic_segments[i].distance_to_point(observer) <= max_distance) {
+            candidate_segments.push_back(std::make_shared<LineSegment>(periodic_segments[i]));
+        }
+    }
+
+    return get_visible_vertices_from_candidate_segments_and_vertices(
+        observer, all_vertices_for_line_segments(candidate_segments), candidate_segments, half_scan, max_distance);
+}
+
 std::vector<VisibleVertex> VistreeGenerator::get_visible_vertices_from_candidate_segments_and_vertices(
     const Coordinate &observer, const std::vector<Coordinate> &candidate_vertices,
-    const std::vector<std::shared_ptr<LineSegment>> &candidate_segments, bool half_scan) const {
+    const std::vector<std::shared_ptr<LineSegment>> &candidate_segments, bool half_scan,
+    double max_visible_distance) const {
     if (_vertices_and_segments.empty()) {
         return {};
     }
 
-    auto vertices_sorted_counter_clockwise_around_observer = candidate_vertices;
+    // Every container local to the sweep is backed by this thread's arena, so once the arena has grown to fit
+    // the largest sweep the loop below makes no heap allocations. Resetting on entry rather than on exit keeps
+    // the arena consistent if a previous sweep threw.
+    thread_local auto arena = SweepArena();
+    arena.reset();
+    auto *const resource = arena.resource();
+
+    auto vertices_sorted_counter_clockwise_around_observer =
+        std::pmr::vector<Coordinate>(candidate_vertices.begin(), candidate_vertices.end(), resource);
     AngleSorter::sort_counter_clockwise_around_observer(observer, vertices_sorted_counter_clockwise_around_observer);
 
-    auto open_edges = OpenEdges();
+    auto open_edges = OpenEdges(resource);
     const auto initial_scanline_segment =
         LineSegment(observer, Coordinate(MAX_PERIODIC_LONGITUDE_MICRODEGREES, observer.get_latitude_microdegrees()));
     const auto initial_scanline_vector = initial_scanline_segment.get_tangent_vector();
+
+    // Segments crossing the initial scanline are found in one vectorised pass, as most candidates miss it.
+    // Segments touching the scanline at an endpoint are opened when the sweep reaches that endpoint instead.
+    auto candidate_segment_block = SegmentBlock(resource);
+    candidate_segment_block.reserve(candidate_segments.size());
     for (const auto &line_segment : candidate_segments) {
-        if (observer == line_segment->get_endpoint_1() || observer == line_segment->get_endpoint_2()) {
+        candidate_segment_block.push_back(*line_segment);
+    }
+    auto crosses_initial_scanline = std::pmr::vector<uint8_t>(candidate_segments.size(), resource);
+    SegmentKernels::segments_crossing_ray(candidate_segment_block, initial_scanline_segment.get_endpoint_1(),
+                                          initial_scanline_segment.get_endpoint_2(),
+                                          crosses_initial_scanline.data());
+
+    for (size_t i = 0; i < candidate_segments.size(); ++i) {
+        if (!crosses_initial_scanline[i]) {
             continue;
         }
 
-        const auto intersection = line_segment->intersection_with_segment(initial_scanline_segment);
-        if (intersection.has_value() && !initial_scanline_segment.on_segment(line_segment->get_endpoint_1()) &&
-            !initial_scanline_segment.on_segment(line_segment->get_endpoint_2())) {
-            open_edges.add_edge((intersection.value() - observer).magnitude_squared_microdegrees(), *line_segment);
-        }
+        const auto &segment = *candidate_segments[i];
+        open_edges.add_edge(ExactPredicates::squared_distance_to_crossing(
+                                segment.get_endpoint_1(), segment.get_endpoint_2(),
+                                initial_scanline_segment.get_endpoint_1(), initial_scanline_segment.get_endpoint_2()),
+                            segment);
     }
 
-    std::vector<VisibleVertex> visible_vertices;
+    auto visible_vertices = std::pmr::vector<VisibleVertex>(resource);
+    auto clockwise_segments = std::pmr::vector<const LineSegment *>(resource);
+    auto counter_clockwise_segments = std::pmr::vector<const LineSegment *>(resource);
     for (const auto &current_vertex : vertices_sorted_counter_clockwise_around_observer) {
         if (observer == current_vertex) {
             continue;
@@ -83,15 +203,17 @@ std::vector<VisibleVertex> VistreeGenerator::get_visible_vertices_from_candidate
         }
 
         const auto &incident_segments = _vertices_and_segments.at(current_vertex);
-        const auto clockwise_segments =
-            VistreeGenerator::orientation_segments(incident_segments, scanline_segment, Orientation::CLOCKWISE);
-        const auto counter_clockwise_segments =
-            VistreeGenerator::orientation_segments(incident_segments, scanline_segment, Orientation::COUNTER_CLOCKWISE);
+        VistreeGenerator::orientation_segments(incident_segments, scanline_segment, Orientation::CLOCKWISE,
+                                               clockwise_segments);
+        VistreeGenerator::orientation_segments(incident_segments, scanline_segment, Orientation::COUNTER_CLOCKWISE,
+                                               counter_clockwise_segments);
 
         VistreeGenerator::erase_segments_from_open_edges(clockwise_segments, open_edges);
 
         const auto curr_vertex_visible = VistreeGenerator::is_vertex_visible(open_edges, observer, current_vertex);
-        if (curr_vertex_visible) {
+        if (curr_vertex_visible &&
+            is_periodic_coordinate_within_margin(current_vertex, _periodic_replication_margin) &&
+            (current_vertex - observer).magnitude() <= max_visible_distance) {
             visible_vertices.push_back(VisibleVertex{
                     .coord = coordinate_from_periodic_coordinate(current_vertex),
                     .is_visible_across_meridian = is_coordinate_over_meridian(current_vertex),
@@ -101,7 +223,7 @@ std::vector<VisibleVertex> VistreeGenerator::get_visible_vertices_from_candidate
         VistreeGenerator::add_segments_to_open_edges(counter_clockwise_segments, open_edges, observer, current_vertex);
     }
 
-    return visible_vertices;
+    return std::vector<VisibleVertex>(visible_vertices.begin(), visible_vertices.end());
 }
 
 VistreeGenerator::VertexToSegmentMapping
@@ -133,26 +255,44 @@ VistreeGenerator::all_vertices_and_incident_segments(const std::vector<Polygon>
     return vertices_and_segments;
 }
 
-std::vector<std::shared_ptr<LineSegment>> VistreeGenerator::all_line_segments() const {
+double VistreeGenerator::longest_segment_length(const VertexToSegmentMapping &vertices_and_segments) {
+    double longest_length = 0;
+    for (const auto &vertex_and_segments : vertices_and_segments) {
+        for (const auto &segment : vertex_and_segments.second) {
+            longest_length = std::max(longest_length, segment->get_tangent_vector().magnitude());
+        }
+    }
+
+    return longest_length;
+}
+
+std::vector<std::shared_ptr<LineSegment>>
+VistreeGenerator::all_line_segments(const VertexToSegmentMapping &vertices_and_segments) {
     std::unordered_set<std::shared_ptr<LineSegment>> segments;
-    segments.reserve(_vertices_and_segments.size());
+    segments.reserve(vertices_and_segments.size());
 
-    for (const auto &vertex_and_segments : _vertices_and_segments) {
+    for (const auto &vertex_and_segments : vertices_and_segments) {
         for (const auto &segment : vertex_and_segments.second) {
             segments.insert(segment);
         }
     }
 
-    return std::vector<std::shared_ptr<LineSegment>>(segments.begin(), segments.end());
+    // Sorted so the sweep does not depend on where the segments happen to be allocated
+    auto sorted_segments = std::vector<std::shared_ptr<LineSegment>>(segments.begin(), segments.end());
+    std::sort(sorted_segments.begin(), sorted_segments.end(),
+              [](const auto &a, const auto &b) { return *a < *b; });
+
+    return sorted_segments;
 }
 
-std::vector<Coordinate> VistreeGenerator::all_vertices() const {
+std::vector<Coordinate> VistreeGenerator::all_vertices(const VertexToSegmentMapping &vertices_and_segments) {
     std::vector<Coordinate> vertices;
-    vertices.reserve(_vertices_and_segments.size());
+    vertices.reserve(vertices_and_segments.size());
 
-    for (const auto &vertex_and_segments : _vertices_and_segments) {
+    for (const auto &vertex_and_segments : vertices_and_segments) {
         vertices.push_back(vertex_and_segments.first);
     }
+    std::sort(vertices.begin(), vertices.end());
 
     return vertices;
 }
@@ -166,23 +306,24 @@ VistreeGenerator::all_vertices_for_line_segments(const std::vector<std::shared_p
         vertices.insert(segment->get_endpoint_2());
     }
 
-    return std::vector<Coordinate>(vertices.begin(), vertices.end());
+    auto sorted_vertices = std::vector<Coordinate>(vertices.begin(), vertices.end());
+    std::sort(sorted_vertices.begin(), sorted_vertices.end());
+
+    return sorted_vertices;
 }
 
-std::vector<std::shared_ptr<LineSegment>>
-VistreeGenerator::orientation_segments(const std::vector<std::shared_ptr<LineSegment>> &segments,
-                                       const LineSegment &scanline_segment, const Orientation &desired_orientation) {
-    std::vector<std::shared_ptr<LineSegment>> orientation_segs;
+void VistreeGenerator::orientation_segments(const std::vector<std::shared_ptr<LineSegment>> &segments,
+                                            const LineSegment &scanline_segment, const Orientation &desired_orientation,
+                                            std::pmr::vector<const LineSegment *> &orientation_segs) {
+    orientation_segs.clear();
 
     for (const auto &segment : segments) {
         const auto adjacent_to_segment_point = segment->get_adjacent_to(scanline_segment.get_endpoint_2());
         const auto segment_orientation = scanline_segment.orientation_of_point_to_segment(adjacent_to_segment_point);
         if (segment_orientation == desired_orientation) {
-            orientation_segs.push_back(segment);
+            orientation_segs.push_back(segment.get());
         }
     }
-
-    return orientation_segs;
 }
 
 bool VistreeGenerator::is_vertex_visible(const OpenEdges &open_edges, const Coordinate &observer_coordinate,
@@ -196,28 +337,19 @@ bool VistreeGenerator::is_vertex_visible(const OpenEdges &open_edges, const Coor
         // Essentially we build artificial walls based on the edges we know obstruct vision (those adjacent)
         // This will be a constant time operation as each vertex only has two adjacent edges
 
-        auto barrier_polyline_vertices = std::vector<Coordinate>();
-        barrier_polyline_vertices.reserve(3);
-
         const auto &vertex_segments = _vertices_and_segments.at(observer_coordinate);
-        for (size_t i = 0; i < vertex_segments.size(); ++i) {
-            barrier_polyline_vertices.push_back(vertex_segments[i]->get_endpoint_1());
-            if (i != 0)
-                barrier_polyline_vertices.push_back(vertex_segments[i]->get_endpoint_2());
-        }
-
-        const auto barrier_polyline = ThreeVertexPolyline(barrier_polyline_vertices[0], barrier_polyline_vertices[1],
-                                                          barrier_polyline_vertices[2]);
+        const auto barrier_polyline =
+            ThreeVertexPolyline(vertex_segments[0]->get_endpoint_1(), vertex_segments[1]->get_endpoint_1(),
+                                vertex_segments[1]->get_endpoint_2());
         if (!barrier_polyline.point_visible(vertex_in_question)) {
             return false;
         }
     }
 
     if (!open_edges.empty()) {
-        const auto &closest_edge = open_edges.closest_edge();
-        const auto intersection =
-            closest_edge.intersection_with_segment(LineSegment(observer_coordinate, vertex_in_question));
-        if (intersection.has_value() && intersection.value() != vertex_in_question) {
+        const auto closest_edge = open_edges.closest_edge();
+        if (ExactPredicates::crosses_ray_before_vertex(closest_edge.get_endpoint_1(), closest_edge.get_endpoint_2(),
+                                                       observer_coordinate, vertex_in_question)) {
             return false;
         }
     }
@@ -225,20 +357,19 @@ bool VistreeGenerator::is_vertex_visible(const OpenEdges &open_edges, const Coor
     return true;
 }
 
-void VistreeGenerator::erase_segments_from_open_edges(const std::vector<std::shared_ptr<LineSegment>> &segments,
+void VistreeGenerator::erase_segments_from_open_edges(const std::pmr::vector<const LineSegment *> &segments,
                                                       OpenEdges &open_edges) {
     for (const auto &segment : segments) {
         open_edges.remove_edge(*segment);
     }
 }
 
-void VistreeGenerator::add_segments_to_open_edges(const std::vector<std::shared_ptr<LineSegment>> &segments,
+void VistreeGenerator::add_segments_to_open_edges(const std::pmr::vector<const LineSegment *> &segments,
                                                   OpenEdges &open_edges, const Coordinate &observer,
                                                   const Coordinate &current_vertex) {
+    // Every segment opened here starts at current_vertex, which is therefore where it meets the scanline
+    const auto distance_squared = (current_vertex - observer).magnitude_squared_microdegrees();
     for (const auto &segment : segments) {
-        const auto intersection = segment->intersection_with_segment(LineSegment(observer, current_vertex));
-        const auto distance_squared = (intersection.value() - observer).magnitude_squared_microdegrees();
-
         open_edges.add_edge(distance_squared, *segment);
     }
 }
@@ -5,12 +5,15 @@
 #ifndef CAPI_VISTREE_GENERATOR_HPP
 #define CAPI_VISTREE_GENERATOR_HPP
 
+#include <cmath>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <vector>
 
 #include "datastructures/open_edges/open_edges.hpp"
+#include "datastructures/spatial_segment_index/spatial_segment_index.hpp"
 #include "types/coordinate/coordinate.hpp"
 #include "types/line_segment/line_segment.hpp"
 #include "types/polygon/polygon.hpp"
@@ -19,25 +22,39 @@
 class VistreeGenerator {
   public:
     explicit VistreeGenerator(const std::vector<Polygon> &polygons);
+    // Vertices further than periodic_replication_margin degrees across the meridian are never reported visible,
+    // as the periodic copies which could obstruct them may not have been replicated (see make_polygons_periodic)
+    VistreeGenerator(const std::vector<Polygon> &polygons, double periodic_replication_margin);
     explicit VistreeGenerator(const std::vector<std::shared_ptr<LineSegment>> &segments);
     [[nodiscard]] std::vector<VisibleVertex> get_visible_vertices(const Coordinate &observer,
                                                                   bool half_scan = false) const;
+    // Sweeps from every observer in parallel
+    [[nodiscard]] VisibleVertexBatch get_visible_vertices_batch(const std::vector<Coordinate> &observers,
+                                                                bool half_scan = false) const;
     [[nodiscard]] std::vector<VisibleVertex>
     get_visible_vertices_from_candidate_segments(const Coordinate &observer,
                                                  const std::vector<std::shared_ptr<LineSegment>> &candidate_segments,
                                                  bool half_scan = false) const;
+    // Only segments within max_distance (in degrees) of the observer can obstruct a vertex that close to it,
+    // so candidates are culled through the spatial index, which must be built from the non-periodic polygons
+    [[nodiscard]] std::vector<VisibleVertex> get_visible_vertices_within_distance(const Coordinate &observer,
+                                                                                  const SpatialSegmentIndex &index,
+                                                                                  double max_distance,
+                                                                                  bool half_scan = false) const;
 
   private:
     using VertexToSegmentMapping = std::unordered_map<Coordinate, std::vector<std::shared_ptr<LineSegment>>>;
 
     static VertexToSegmentMapping all_vertices_and_incident_segments(const std::vector<Polygon> &polygons);
-    static std::vector<std::shared_ptr<LineSegment>>
-    orientation_segments(const std::vector<std::shared_ptr<LineSegment>> &segments, const LineSegment &scanline_segment,
-                         const Orientation &desired_orientation);
+    static double longest_segment_length(const VertexToSegmentMapping &vertices_and_segments);
+    // Fills orientation_segs (cleared first) so its capacity is reused across the sweep
+    static void orientation_segments(const std::vector<std::shared_ptr<LineSegment>> &segments,
+                                     const LineSegment &scanline_segment, const Orientation &desired_orientation,
+                                     std::pmr::vector<const LineSegment *> &orientation_segs);
 
-    static void erase_segments_from_open_edges(const std::vector<std::shared_ptr<LineSegment>> &segments,
+    static void erase_segments_from_open_edges(const std::pmr::vector<const LineSegment *> &segments,
                                                OpenEdges &open_edges);
-    static void add_segments_to_open_edges(const std::vector<std::shared_ptr<LineSegment>> &segments,
+    static void add_segments_to_open_edges(const std::pmr::vector<const LineSegment *> &segments,
                                            OpenEdges &open_edges, const Coordinate &observer,
                                            const Coordinate &current_vertex);
 
@@ -46,13 +63,20 @@ class VistreeGenerator {
 
     [[nodiscard]] std::vector<VisibleVertex> get_visible_vertices_from_candidate_segments_and_vertices(
         const Coordinate &observer, const std::vector<Coordinate> &candidate_vertices,
-        const std::vector<std::shared_ptr<LineSegment>> &candidate_segments, bool half_scan) const;
-    [[nodiscard]] std::vector<std::shared_ptr<LineSegment>> all_line_segments() const;
-    [[nodiscard]] std::vector<Coordinate> all_vertices() const;
+        const std::vector<std::shared_ptr<LineSegment>> &candidate_segments, bool half_scan,
+        double max_visible_distance = INFINITY) const;
+    [[nodiscard]] static std::vector<std::shared_ptr<LineSegment>>
+    all_line_segments(const VertexToSegmentMapping &vertices_and_segments);
+    [[nodiscard]] static std::vector<Coordinate> all_vertices(const VertexToSegmentMapping &vertices_and_segments);
     [[nodiscard]] bool is_vertex_visible(const OpenEdges &open_edges, const Coordinate &observer_coordinate,
                                          const Coordinate &vertex_in_question) const;
 
     VertexToSegmentMapping _vertices_and_segments;
+    double _periodic_replication_margin = INFINITY;
+    double _longest_segment_length;
+    // Cached so that full scans do not rebuild them for every observer
+    std::vector<Coordinate> _all_vertices;
+    std::vector<std::shared_ptr<LineSegment>> _all_line_segments;
 };
 
 #endif // CAPI_VISTREE_GENERATOR_HPP
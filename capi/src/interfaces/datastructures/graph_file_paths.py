@@ -7,6 +7,26 @@ class IGraphFilePaths(abc.ABC):
     def default_graph_path(self) -> str:
         pass
 
+    @property
+    @abc.abstractmethod
+    def coarse_graph_path(self) -> str:
+        pass
+
+    @property
+    @abc.abstractmethod
+    def contraction_hierarchy_path(self) -> str:
+        pass
+
+    @property
+    @abc.abstractmethod
+    def landmarks_path(self) -> str:
+        pass
+
+    @property
+    @abc.abstractmethod
+    def sparse_graph_path(self) -> str:
+        pass
+
     @property
     @abc.abstractmethod
     def folder_path(self) -> str:
@@ -1,13 +1,90 @@
 import abc
+import math
+import typing
+
+from capi.src.implementation.visibility_graphs import VisGraphGenerationStats
 
 
 class IGraphGenerator(abc.ABC):
     @abc.abstractmethod
-    def generate(self, shape_file_path: str, output_path: str) -> None:
+    def generate(
+        self,
+        shape_file_path: str,
+        output_path: str,
+        periodic_replication_margin: float = math.inf,
+        max_edge_length: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
+        checkpoint_path: typing.Optional[str] = None,
+        stats: typing.Optional[VisGraphGenerationStats] = None,
+        coarse_simplification_tolerance_metres: typing.Optional[float] = None,
+        build_contraction_hierarchy: bool = False,
+        num_landmarks: int = 0,
+    ) -> None:
+        pass
+
+    @abc.abstractmethod
+    def resume(
+        self,
+        shape_file_path: str,
+        output_path: str,
+        checkpoint_path: str,
+        periodic_replication_margin: float = math.inf,
+        max_edge_length: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
+        stats: typing.Optional[VisGraphGenerationStats] = None,
+        coarse_simplification_tolerance_metres: typing.Optional[float] = None,
+        build_contraction_hierarchy: bool = False,
+        num_landmarks: int = 0,
+    ) -> None:
+        pass
+
+    @abc.abstractmethod
+    def generate_with_memory_limit(
+        self,
+        shape_file_path: str,
+        output_path: str,
+        memory_limit_bytes: int,
+        periodic_replication_margin: float = math.inf,
+        max_edge_length: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
+        stats: typing.Optional[VisGraphGenerationStats] = None,
+        coarse_simplification_tolerance_metres: typing.Optional[float] = None,
+        build_contraction_hierarchy: bool = False,
+        num_landmarks: int = 0,
+    ) -> None:
         pass
 
     @abc.abstractmethod
     def generate_for_vertex_range(
-        self, shape_file_path: str, output_path: str, current_split_num: int, num_splits: int, seed: int
+        self,
+        shape_file_path: str,
+        output_path: str,
+        current_split_num: int,
+        num_splits: int,
+        seed: int,
+        periodic_replication_margin: float = math.inf,
+        max_edge_length: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
+    ) -> None:
+        pass
+
+    @abc.abstractmethod
+    def get_tile_ids(self, shape_file_path: str, tile_level: int) -> typing.Sequence[int]:
+        pass
+
+    @abc.abstractmethod
+    def generate_for_tile(
+        self,
+        shape_file_path: str,
+        output_path: str,
+        tile_id: int,
+        halo: float,
+        periodic_replication_margin: float = math.inf,
+        simplification_method: typing.Optional[str] = None,
+        simplification_tolerance_metres: float = 0.0,
     ) -> None:
         pass
@@ -3,6 +3,13 @@ import math
 import typing
 
 from capi.src.implementation.dtos.coordinate import Coordinate
+from capi.src.implementation.dtos.distance_matrix import DistanceMatrix
+from capi.src.implementation.visibility_graphs import (
+    VisGraphCacheStatsSnapshot,
+    VisGraphSearchAlgorithm,
+    VisGraphSearchHeuristic,
+    VisGraphSearchStats,
+)
 
 
 class IPathInterpolator(abc.ABC):
@@ -14,6 +21,9 @@ class IPathInterpolator(abc.ABC):
         search_distance_from_source_limit: float = math.inf,
         correct_vertices_on_land: bool = False,
         a_star_greediness_weighting: float = 1.0,
+        search_algorithm: VisGraphSearchAlgorithm = VisGraphSearchAlgorithm.A_STAR,
+        heuristic: VisGraphSearchHeuristic = VisGraphSearchHeuristic.STRAIGHT_LINE,
+        stats: typing.Optional[VisGraphSearchStats] = None,
     ) -> typing.Sequence[Coordinate]:
         pass
 
@@ -24,5 +34,28 @@ class IPathInterpolator(abc.ABC):
         search_distance_from_source_limit: float = math.inf,
         correct_vertices_on_land: bool = False,
         a_star_greediness_weighting: float = 1.0,
+        search_algorithm: VisGraphSearchAlgorithm = VisGraphSearchAlgorithm.A_STAR,
+        heuristic: VisGraphSearchHeuristic = VisGraphSearchHeuristic.STRAIGHT_LINE,
+        stats: typing.Optional[VisGraphSearchStats] = None,
     ) -> typing.Sequence[typing.Optional[typing.Sequence[Coordinate]]]:
         pass
+
+    @abc.abstractmethod
+    def distance_matrix(
+        self,
+        sources: typing.Sequence[Coordinate],
+        destinations: typing.Sequence[Coordinate],
+        search_distance_from_source_limit: float = math.inf,
+        correct_vertices_on_land: bool = False,
+        include_paths: bool = False,
+        stats: typing.Optional[VisGraphSearchStats] = None,
+    ) -> DistanceMatrix:
+        pass
+
+    @abc.abstractmethod
+    def endpoint_cache_stats(self) -> VisGraphCacheStatsSnapshot:
+        pass
+
+    @abc.abstractmethod
+    def path_cache_stats(self) -> VisGraphCacheStatsSnapshot:
+        pass
@@ -4,7 +4,13 @@ from tempfile import TemporaryDirectory
 
 from capi.src.implementation.datastructures.graph_file_paths import GraphFilePaths
 from capi.src.implementation.graph_generator import GraphGenerator
-from capi.src.implementation.visibility_graphs import load_graph_from_file
+from capi.src.implementation.visibility_graphs import (
+    VisGraphGenerationStats,
+    load_contraction_hierarchy_from_file,
+    load_graph_from_file,
+    load_landmarks_from_file,
+    load_sparse_graph_from_file,
+)
 from capi.test.test_files.test_files_dir import TEST_FILES_DIR
 
 
@@ -29,6 +35,153 @@ class TestGraphGenerator(unittest.TestCase):
 
         self.assertEqual(expected_normal_graph, actual_normal_graph)
 
+    def test_generate_with_stats(self):
+        with TemporaryDirectory() as temp_dir:
+            stats = VisGraphGenerationStats()
+
+            generator = GraphGenerator()
+            generator.generate(
+                os.path.join(TEST_FILES_DIR, "smaller.shp"),
+                os.path.join(temp_dir, "out_smaller_graph"),
+                stats=stats,
+            )
+
+        snapshot = stats.snapshot()
+        self.assertGreater(snapshot.num_observers, 0)
+        self.assertEqual(snapshot.num_observers, snapshot.num_completed_observers)
+        self.assertGreater(snapshot.num_emitted_edges, 0)
+        self.assertGreater(len(snapshot.thread_busy_seconds), 0)
+        self.assertGreater(snapshot.observers_per_second, 0)
+
+    def test_generate_with_coarse_graph(self):
+        with TemporaryDirectory() as temp_dir:
+            output_graph_path = os.path.join(temp_dir, "out_smaller_graph")
+
+            generator = GraphGenerator()
+            generator.generate(
+                os.path.join(TEST_FILES_DIR, "smaller.shp"),
+                output_graph_path,
+                coarse_simplification_tolerance_metres=10000.0,
+            )
+
+            graph_paths = GraphFilePaths(output_graph_path)
+            graph = load_graph_from_file(graph_paths.default_graph_path)
+            coarse_graph = load_graph_from_file(graph_paths.coarse_graph_path)
+
+        self.assertLess(len(coarse_graph.vertices), len(graph.vertices))
+
+    def test_generate_with_contraction_hierarchy(self):
+        with TemporaryDirectory() as temp_dir:
+            output_graph_path = os.path.join(temp_dir, "out_smaller_graph")
+
+            generator = GraphGenerator()
+            generator.generate(
+                os.path.join(TEST_FILES_DIR, "smaller.shp"),
+                output_graph_path,
+                build_contraction_hierarchy=True,
+            )
+
+            graph_paths = GraphFilePaths(output_graph_path)
+            graph = load_graph_from_file(graph_paths.default_graph_path)
+            contraction_hierarchy = load_contraction_hierarchy_from_file(graph_paths.contraction_hierarchy_path)
+
+        self.assertEqual(graph.vertices, contraction_hierarchy.vertices)
+        self.assertGreater(contraction_hierarchy.num_upward_edges, 0)
+
+    def test_generate_with_landmarks(self):
+        with TemporaryDirectory() as temp_dir:
+            output_graph_path = os.path.join(temp_dir, "out_smaller_graph")
+
+            generator = GraphGenerator()
+            generator.generate(
+                os.path.join(TEST_FILES_DIR, "smaller.shp"),
+                output_graph_path,
+                num_landmarks=4,
+            )
+
+            graph_paths = GraphFilePaths(output_graph_path)
+            graph = load_graph_from_file(graph_paths.default_graph_path)
+            landmarks = load_landmarks_from_file(graph_paths.landmarks_path)
+
+        self.assertEqual(graph.vertices, landmarks.vertices)
+        self.assertEqual(4, landmarks.num_landmarks)
+
+    def test_generate_with_checkpoint(self):
+        expected_graph_path = os.path.join(TEST_FILES_DIR, "smaller_graph")
+
+        with TemporaryDirectory() as temp_dir:
+            output_graph_path = os.path.join(temp_dir, "out_smaller_graph")
+            checkpoint_path = os.path.join(temp_dir, "checkpoint")
+
+            expected_graph_paths = GraphFilePaths(expected_graph_path)
+            expected_normal_graph = load_graph_from_file(expected_graph_paths.default_graph_path)
+
+            generator = GraphGenerator()
+            generator.generate(
+                os.path.join(TEST_FILES_DIR, "smaller.shp"),
+                output_graph_path,
+                checkpoint_path=checkpoint_path,
+            )
+
+            actual_graph_paths = GraphFilePaths(output_graph_path)
+            actual_normal_graph = load_graph_from_file(actual_graph_paths.default_graph_path)
+
+            self.assertFalse(os.path.exists(checkpoint_path))
+
+            with self.assertRaises(FileNotFoundError):
+                generator.resume(os.path.join(TEST_FILES_DIR, "smaller.shp"), output_graph_path, checkpoint_path)
+
+        self.assertEqual(expected_normal_graph, actual_normal_graph)
+
+    def test_generate_with_memory_limit(self):
+        expected_graph_path = os.path.join(TEST_FILES_DIR, "smaller_graph")
+
+        with TemporaryDirectory() as temp_dir:
+            output_graph_path = os.path.join(temp_dir, "out_smaller_graph")
+
+            expected_graph_paths = GraphFilePaths(expected_graph_path)
+            expected_normal_graph = load_graph_from_file(expected_graph_paths.default_graph_path)
+
+            generator = GraphGenerator()
+            generator.generate_with_memory_limit(
+                os.path.join(TEST_FILES_DIR, "smaller.shp"),
+                output_graph_path,
+                16 * 1024,
+            )
+
+            actual_graph_paths = GraphFilePaths(output_graph_path)
+            actual_sparse_graph = load_sparse_graph_from_file(actual_graph_paths.sparse_graph_path)
+
+            self.assertFalse(os.path.exists(actual_graph_paths.default_graph_path))
+
+        self.assertEqual(expected_normal_graph.vertices, actual_sparse_graph.vertices)
+        for vertex in expected_normal_graph.vertices:
+            self.assertCountEqual(expected_normal_graph.get_neighbors(vertex), actual_sparse_graph.get_neighbors(vertex))
+
+    def test_generate_with_memory_limit_and_search_data(self):
+        with TemporaryDirectory() as temp_dir:
+            output_graph_path = os.path.join(temp_dir, "out_smaller_graph")
+
+            generator = GraphGenerator()
+            generator.generate_with_memory_limit(
+                os.path.join(TEST_FILES_DIR, "smaller.shp"),
+                output_graph_path,
+                16 * 1024,
+                coarse_simplification_tolerance_metres=10000.0,
+                build_contraction_hierarchy=True,
+                num_landmarks=4,
+            )
+
+            graph_paths = GraphFilePaths(output_graph_path)
+            sparse_graph = load_sparse_graph_from_file(graph_paths.sparse_graph_path)
+            coarse_graph = load_graph_from_file(graph_paths.coarse_graph_path)
+            contraction_hierarchy = load_contraction_hierarchy_from_file(graph_paths.contraction_hierarchy_path)
+            landmarks = load_landmarks_from_file(graph_paths.landmarks_path)
+
+            self.assertLess(len(coarse_graph.vertices), len(sparse_graph.vertices))
+            self.assertEqual(sparse_graph.vertices, contraction_hierarchy.vertices)
+            self.assertEqual(sparse_graph.vertices, landmarks.vertices)
+
     def test_generate_for_vertex_range(self):
         for test_case in [(0, 2, "smaller_graph_range_1"), (1, 2, "smaller_graph_range_2")]:
             expected_graph_path = os.path.join(TEST_FILES_DIR, test_case[2])
@@ -52,3 +205,15 @@ class TestGraphGenerator(unittest.TestCase):
                 actual_normal_graph = load_graph_from_file(actual_graph_paths.default_graph_path)
 
             self.assertEqual(expected_normal_graph, actual_normal_graph)
+
+    def test_generate_unknown_simplification_method(self):
+        with TemporaryDirectory() as temp_dir:
+            generator = GraphGenerator()
+
+            with self.assertRaises(ValueError):
+                generator.generate(
+                    os.path.join(TEST_FILES_DIR, "smaller.shp"),
+                    os.path.join(temp_dir, "out_smaller_graph"),
+                    simplification_method="unknown",
+                    simplification_tolerance_metres=100.0,
+                )
@@ -6,6 +6,7 @@ from haversine import haversine  # type: ignore
 
 from capi.src.implementation.dtos.coordinate import Coordinate
 from capi.src.implementation.path_interpolator import PathInterpolator
+from capi.src.implementation.visibility_graphs import VisGraphSearchAlgorithm, VisGraphSearchStats
 from capi.test.test_files.test_files_dir import TEST_FILES_DIR
 
 
@@ -76,6 +77,16 @@ class TestPathInterpolator(unittest.TestCase):
                 a_star_greediness_weighting=1.1,
             )
 
+    def test_copenhagen_to_singapore_bidirectional(self):
+        path = self._INTERPOLATOR.interpolate(
+            self._COPENHAGEN_COORDINATES,
+            self._SINGAPORE_COORDINATES,
+            a_star_greediness_weighting=1.1,
+            search_algorithm=VisGraphSearchAlgorithm.BIDIRECTIONAL_A_STAR,
+        )
+
+        self._assert_paths_equal(self._COPENHAGEN_TO_SINGAPORE_PATH, path)
+
     def test_copenhagen_to_stockholm(self):
         path = self._INTERPOLATOR.interpolate(
             self._COPENHAGEN_COORDINATES, self._STOCKHOLM_COORDINATES, a_star_greediness_weighting=1.1
@@ -99,6 +110,58 @@ class TestPathInterpolator(unittest.TestCase):
         for expected_path, path in zip(expected_paths, paths):
             self._assert_paths_equal(expected_path, path)
 
+    def test_batch_interpolate_with_stats(self):
+        stats = VisGraphSearchStats()
+
+        self._INTERPOLATOR.batch_interpolate(
+            [
+                (self._COPENHAGEN_COORDINATES, self._SINGAPORE_COORDINATES),
+                (self._COPENHAGEN_COORDINATES, self._STOCKHOLM_COORDINATES),
+            ],
+            a_star_greediness_weighting=1.1,
+            stats=stats,
+        )
+
+        snapshot = stats.snapshot()
+        self.assertEqual(snapshot.num_searches, 2)
+        self.assertGreater(snapshot.num_expanded_vertices, 0)
+        self.assertGreaterEqual(snapshot.num_relaxed_edges, snapshot.num_expanded_vertices)
+
+    def test_distance_matrix(self):
+        matrix = self._INTERPOLATOR.distance_matrix(
+            [self._COPENHAGEN_COORDINATES],
+            [self._SINGAPORE_COORDINATES, self._STOCKHOLM_COORDINATES],
+            include_paths=True,
+        )
+
+        self.assertGreater(matrix.distances[0][0], matrix.distances[0][1])
+        self._assert_paths_equal(self._COPENHAGEN_TO_SINGAPORE_PATH, matrix.paths[0][0])
+        self._assert_paths_equal(self._COPENHAGEN_TO_STOCKHOLM_PATH, matrix.paths[0][1])
+
+    def test_endpoint_cache_stats(self):
+        self._INTERPOLATOR.interpolate(self._COPENHAGEN_COORDINATES, self._STOCKHOLM_COORDINATES)
+        before = self._INTERPOLATOR.endpoint_cache_stats()
+        path = self._INTERPOLATOR.interpolate(self._COPENHAGEN_COORDINATES, self._STOCKHOLM_COORDINATES)
+        after = self._INTERPOLATOR.endpoint_cache_stats()
+
+        self._assert_paths_equal(self._COPENHAGEN_TO_STOCKHOLM_PATH, path)
+        self.assertGreater(after.num_hits, before.num_hits)
+        self.assertEqual(after.num_misses, before.num_misses)
+        self.assertGreater(after.hit_rate, 0)
+
+    def test_path_cache_stats(self):
+        interpolator = PathInterpolator(visibility_graph_file_path=self._GRAPH_FILE_PATH, path_cache_capacity=1 << 20)
+        self.assertEqual(self._INTERPOLATOR.path_cache_stats().capacity, 0)
+
+        interpolator.interpolate(self._COPENHAGEN_COORDINATES, self._STOCKHOLM_COORDINATES)
+        path = interpolator.interpolate(self._COPENHAGEN_COORDINATES, self._STOCKHOLM_COORDINATES)
+        stats = interpolator.path_cache_stats()
+
+        self._assert_paths_equal(self._COPENHAGEN_TO_STOCKHOLM_PATH, path)
+        self.assertEqual(stats.num_hits, 1)
+        self.assertEqual(stats.num_entries, 1)
+        self.assertGreater(stats.size, 0)
+
     def test_cross_meridian(self):
         coords_1 = Coordinate(latitude=1, longitude=104)
         coords_2 = Coordinate(latitude=37, longitude=-125)
@@ -0,0 +1,52 @@
+#include <catch.hpp>
+#include <vector>
+
+#include "constants/constants.hpp"
+#include "coordinate_periodicity/coordinate_periodicity.hpp"
+#include "types/coordinate/coordinate.hpp"
+#include "types/polygon/polygon.hpp"
+
+TEST_CASE("Make polygons periodic replicates every polygon by default") {
+    const auto polygons = std::vector<Polygon>{
+        Polygon({Coordinate(1., 0.), Coordinate(0., 1.), Coordinate(-1., 0.)}),
+        Polygon({Coordinate(179., 0.), Coordinate(178., 1.), Coordinate(177., 0.)}),
+    };
+
+    const auto periodic_polygons = make_polygons_periodic(polygons);
+
+    REQUIRE(periodic_polygons.size() == 3 * polygons.size());
+}
+
+TEST_CASE("Make polygons periodic only replicates polygons within the margin of the meridian") {
+    const auto far_polygon = Polygon({Coordinate(1., 0.), Coordinate(0., 1.), Coordinate(-1., 0.)});
+    const auto east_polygon = Polygon({Coordinate(179., 0.), Coordinate(178., 1.), Coordinate(177., 0.)});
+    const auto west_polygon = Polygon({Coordinate(-177., 0.), Coordinate(-178., 1.), Coordinate(-179., 0.)});
+
+    const auto periodic_polygons = make_polygons_periodic({far_polygon, east_polygon, west_polygon}, 5.0);
+
+    const auto shifted = [](const Polygon &polygon, int32_t offset) {
+        auto vertices = std::vector<Coordinate>();
+        for (const auto &vertex : polygon.get_vertices()) {
+            vertices.emplace_back(vertex.get_longitude_microdegrees() + offset, vertex.get_latitude_microdegrees());
+        }
+        return Polygon(vertices);
+    };
+
+    const auto expected_polygons = std::vector<Polygon>{
+        far_polygon,
+        east_polygon,
+        shifted(east_polygon, -LONGITUDE_PERIOD_MICRODEGREES),
+        west_polygon,
+        shifted(west_polygon, LONGITUDE_PERIOD_MICRODEGREES),
+    };
+    REQUIRE(periodic_polygons == expected_polygons);
+}
+
+TEST_CASE("Periodic coordinate within margin") {
+    REQUIRE(is_periodic_coordinate_within_margin(Coordinate(170., 0.), 0.));
+    REQUIRE(is_periodic_coordinate_within_margin(Coordinate(184., 0.), 5.));
+    REQUIRE(is_periodic_coordinate_within_margin(Coordinate(-184., 0.), 5.));
+    REQUIRE_FALSE(is_periodic_coordinate_within_margin(Coordinate(186., 0.), 5.));
+    REQUIRE_FALSE(is_periodic_coordinate_within_margin(Coordinate(-186., 0.), 5.));
+    REQUIRE(is_periodic_coordinate_within_margin(Coordinate(400., 0.), INFINITY));
+}
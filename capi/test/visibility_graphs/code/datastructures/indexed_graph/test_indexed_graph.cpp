@@ -0,0 +1,49 @@
+#include <catch.hpp>
+
+#include "datastructures/graph/graph.hpp"
+#include "datastructures/indexed_graph/indexed_graph.hpp"
+#include "visgraph/visgraph_generator.hpp"
+
+TEST_CASE("IndexedGraph matches the graph it snapshots") {
+    const auto polygons = std::vector<Polygon>{
+        Polygon({Coordinate(1., 0.), Coordinate(0., 1.), Coordinate(-1., 0.)}),
+        Polygon({Coordinate(5., 0.), Coordinate(3., 0.), Coordinate(4., 2.)}),
+        Polygon({Coordinate(179., 0.), Coordinate(178., 1.5), Coordinate(177., 0.)}),
+        Polygon({Coordinate(-178., -1.), Coordinate(-177., 0.5), Coordinate(-179., 0.5)}),
+    };
+    const auto graph = VisgraphGenerator::generate(polygons);
+    const auto indexed_graph = IndexedGraph(*graph);
+
+    const auto vertices = graph->get_vertices();
+    REQUIRE(indexed_graph.get_num_vertices() == vertices.size());
+
+    for (uint32_t i = 0; i < vertices.size(); ++i) {
+        REQUIRE(indexed_graph.get_coordinate(i) == vertices[i]);
+        REQUIRE(indexed_graph.find_vertex(vertices[i]) == i);
+
+        const auto neighbors = indexed_graph.get_neighbors(i);
+        REQUIRE(neighbors.size() == graph->get_neighbors(vertices[i]).size());
+        for (const auto &neighbor : neighbors) {
+            const auto &neighbor_coordinate = indexed_graph.get_coordinate(neighbor.vertex);
+            REQUIRE(graph->has_edge(vertices[i], neighbor_coordinate));
+            REQUIRE(neighbor.is_meridian_crossing == graph->is_edge_meridian_crossing(vertices[i], neighbor_coordinate));
+        }
+    }
+
+    REQUIRE_FALSE(indexed_graph.find_vertex(Coordinate(10., 10.)).has_value());
+}
+
+TEST_CASE("IndexedGraph does not see later changes to the graph") {
+    const auto coord1 = Coordinate(1., 2.);
+    const auto coord2 = Coordinate(2., 1.);
+    const auto coord3 = Coordinate(1., 1.);
+
+    auto graph = Graph(std::vector<Polygon>{Polygon({coord1, coord2, coord3})});
+    graph.add_edge(coord1, coord2, false);
+    const auto indexed_graph = IndexedGraph(graph);
+    graph.add_edge(coord1, coord3, true);
+
+    const auto neighbors = indexed_graph.get_neighbors(indexed_graph.find_vertex(coord1).value());
+    REQUIRE(neighbors.size() == 1);
+    REQUIRE(indexed_graph.get_coordinate(neighbors.begin()->vertex) == coord2);
+}
@@ -0,0 +1,65 @@
+#include <catch.hpp>
+#include <memory>
+#include <string>
+
+#include "datastructures/lru_cache/lru_cache.hpp"
+
+TEST_CASE("LruCache evicts the least recently used entry") {
+    auto cache = LruCache<int, std::string>(2);
+    cache.insert(1, std::make_shared<const std::string>("one"));
+    cache.insert(2, std::make_shared<const std::string>("two"));
+
+    // Finding 1 makes 2 the least recently used
+    const auto one = cache.find(1);
+    REQUIRE(*one == "one");
+    cache.insert(3, std::make_shared<const std::string>("three"));
+    REQUIRE(cache.find(2) == nullptr);
+    REQUIRE(*cache.find(3) == "three");
+
+    // Values found stay valid once evicted
+    cache.insert(4, std::make_shared<const std::string>("four"));
+    REQUIRE(cache.find(1) == nullptr);
+    REQUIRE(*one == "one");
+
+    const auto stats = cache.snapshot();
+    REQUIRE(stats.num_hits == 2);
+    REQUIRE(stats.num_misses == 2);
+    REQUIRE(stats.num_entries == 2);
+    REQUIRE(stats.capacity == 2);
+}
+
+TEST_CASE("LruCache replaces values of existing keys") {
+    auto cache = LruCache<int, std::string>(2);
+    cache.insert(1, std::make_shared<const std::string>("one"));
+    cache.insert(2, std::make_shared<const std::string>("two"));
+    cache.insert(1, std::make_shared<const std::string>("uno"));
+    cache.insert(3, std::make_shared<const std::string>("three"));
+
+    REQUIRE(*cache.find(1) == "uno");
+    REQUIRE(cache.find(2) == nullptr);
+    REQUIRE(cache.snapshot().num_entries == 2);
+}
+
+TEST_CASE("LruCache with no capacity holds nothing") {
+    auto cache = LruCache<int, std::string>(0);
+    cache.insert(1, std::make_shared<const std::string>("one"));
+    REQUIRE(cache.find(1) == nullptr);
+    REQUIRE(cache.snapshot().num_entries == 0);
+}
+
+TEST_CASE("LruCache evicts entries until their sizes fit") {
+    auto cache = LruCache<int, std::string>(10);
+    cache.insert(1, std::make_shared<const std::string>("one"), 4);
+    cache.insert(2, std::make_shared<const std::string>("two"), 4);
+    cache.insert(3, std::make_shared<const std::string>("three"), 7);
+    REQUIRE(cache.find(1) == nullptr);
+    REQUIRE(cache.find(2) == nullptr);
+    REQUIRE(cache.snapshot().size == 7);
+
+    // Entries larger than the whole cache are not held, and replacing an entry replaces its size
+    cache.insert(4, std::make_shared<const std::string>("four"), 11);
+    REQUIRE(cache.find(4) == nullptr);
+    cache.insert(3, std::make_shared<const std::string>("three"), 2);
+    REQUIRE(cache.snapshot().size == 2);
+    REQUIRE(*cache.find(3) == "three");
+}
@@ -0,0 +1,36 @@
+#include <catch.hpp>
+
+#include "datastructures/open_edges/open_edges.hpp"
+
+TEST_CASE("Open edges break distance ties by endpoints") {
+    const auto segment_1 = LineSegment(Coordinate(1., 0.), Coordinate(1., 2.));
+    const auto segment_2 = LineSegment(Coordinate(2., -1.), Coordinate(0., 1.));
+    const auto segment_3 = LineSegment(Coordinate(3., 0.), Coordinate(3., 1.));
+
+    auto forward_edges = OpenEdges();
+    forward_edges.add_edge(10, segment_1);
+    forward_edges.add_edge(10, segment_2);
+    forward_edges.add_edge(20, segment_3);
+
+    auto reverse_edges = OpenEdges();
+    reverse_edges.add_edge(20, segment_3);
+    reverse_edges.add_edge(10, segment_2);
+    reverse_edges.add_edge(10, segment_1);
+
+    // Neither edge at the tied distance is dropped, and the same one is closest whichever was added first
+    REQUIRE(forward_edges.closest_edge() == segment_2);
+    REQUIRE(reverse_edges.closest_edge() == segment_2);
+
+    forward_edges.remove_edge(segment_2);
+    REQUIRE(forward_edges.closest_edge() == segment_1);
+    forward_edges.remove_edge(segment_1);
+    REQUIRE(forward_edges.closest_edge() == segment_3);
+
+    // Adding an edge again moves it rather than duplicating it
+    forward_edges.add_edge(5, segment_1);
+    forward_edges.add_edge(30, segment_1);
+    REQUIRE(forward_edges.closest_edge() == segment_3);
+    forward_edges.remove_edge(segment_3);
+    forward_edges.remove_edge(segment_1);
+    REQUIRE(forward_edges.empty());
+}
@@ -0,0 +1,42 @@
+#include <catch.hpp>
+#include <memory_resource>
+#include <vector>
+
+#include "datastructures/sweep_arena/sweep_arena.hpp"
+
+TEST_CASE("Sweep Arena reuses its buffer between resets") {
+    auto arena = SweepArena(1024);
+
+    auto *const first_allocation = arena.resource()->allocate(256, alignof(std::max_align_t));
+    arena.reset();
+    auto *const second_allocation = arena.resource()->allocate(256, alignof(std::max_align_t));
+
+    REQUIRE(first_allocation == second_allocation);
+    REQUIRE(arena.get_capacity_bytes() == 1024);
+}
+
+TEST_CASE("Sweep Arena grows to fit an overflowing sweep") {
+    auto arena = SweepArena(1024);
+
+    {
+        auto values = std::pmr::vector<int>(arena.resource());
+        for (int i = 0; i < 10000; ++i) {
+            values.push_back(i);
+        }
+        REQUIRE(values[9999] == 9999);
+    }
+    arena.reset();
+
+    const auto grown_capacity = arena.get_capacity_bytes();
+    REQUIRE(grown_capacity >= 10000 * sizeof(int));
+
+    {
+        auto values = std::pmr::vector<int>(arena.resource());
+        for (int i = 0; i < 10000; ++i) {
+            values.push_back(i);
+        }
+    }
+    arena.reset();
+
+    REQUIRE(arena.get_capacity_bytes() == grown_capacity);
+}
@@ -0,0 +1,77 @@
+#include <catch.hpp>
+#include <vector>
+
+#include "geom/angular_cover/angular_cover.hpp"
+#include "types/coordinate/coordinate.hpp"
+#include "types/line_segment/line_segment.hpp"
+
+namespace {
+std::vector<LineSegment> square_around_origin(double half_width) {
+    const auto a = Coordinate(-half_width, -half_width);
+    const auto b = Coordinate(half_width, -half_width);
+    const auto c = Coordinate(half_width, half_width);
+    const auto d = Coordinate(-half_width, half_width);
+    return {LineSegment(a, b), LineSegment(b, c), LineSegment(c, d), LineSegment(d, a)};
+}
+} // namespace
+
+TEST_CASE("AngularCover segments enclosing the observer hide all directions") {
+    const auto observer = Coordinate(0., 0.);
+    REQUIRE(AngularCover::hides_all_directions(observer, square_around_origin(1.)));
+    REQUIRE(AngularCover::hides_all_directions(Coordinate(0.5, -0.9), square_around_origin(1.)));
+
+    // Segments meeting only at an endpoint still hide the direction through it
+    REQUIRE(AngularCover::hides_all_directions(
+        observer, {LineSegment(Coordinate(1., 0.), Coordinate(-1., 1.)), LineSegment(Coordinate(-1., 1.), Coordinate(-1., -1.)),
+                   LineSegment(Coordinate(-1., -1.), Coordinate(1., 0.))}));
+}
+
+TEST_CASE("AngularCover gaps leave directions unhidden") {
+    const auto observer = Coordinate(0., 0.);
+    auto segments = square_around_origin(1.);
+    REQUIRE_FALSE(AngularCover::hides_all_directions(observer, {}));
+    REQUIRE_FALSE(AngularCover::hides_all_directions(Coordinate(2., 0.), segments));
+
+    // A gap a microdegree wide, across the reference direction and away from it
+    segments[1] = LineSegment(Coordinate(1., -1.), Coordinate(1, 0));
+    segments.emplace_back(Coordinate(1000000, 1), Coordinate(1., 1.));
+    REQUIRE_FALSE(AngularCover::hides_all_directions(observer, segments));
+    segments.back() = LineSegment(Coordinate(1., 0.), Coordinate(1., 1.));
+    REQUIRE(AngularCover::hides_all_directions(observer, segments));
+    segments[2] = LineSegment(Coordinate(1., 1.), Coordinate(0, 1000000));
+    segments.emplace_back(Coordinate(-1, 1000000), Coordinate(-1., 1.));
+    REQUIRE_FALSE(AngularCover::hides_all_directions(observer, segments));
+
+    // Segments collinear with the observer hide nothing
+    REQUIRE_FALSE(AngularCover::hides_all_directions(
+        observer, {LineSegment(Coordinate(1., 0.), Coordinate(2., 0.)), LineSegment(Coordinate(0., 1.), Coordinate(0., -1.))}));
+}
+
+TEST_CASE("AngularCover only directions clockwise of an edge need hiding") {
+    // The observer is on the edge, so only the directions below it need hiding
+    const auto edge = LineSegment(Coordinate(-1., 0.), Coordinate(1., 0.));
+    const auto below = std::vector<LineSegment>{
+        edge,
+        LineSegment(Coordinate(2., 0.), Coordinate(2., -1.)),
+        LineSegment(Coordinate(2., -1.), Coordinate(-2., -1.)),
+        LineSegment(Coordinate(-2., -1.), Coordinate(-2., 0.)),
+    };
+    REQUIRE(AngularCover::hides_directions_clockwise_of(Coordinate(0., 0.), below, edge));
+    REQUIRE_FALSE(AngularCover::hides_all_directions(Coordinate(0., 0.), below));
+
+    // Directions along the edge need hiding too
+    auto short_of_edge_line = below;
+    short_of_edge_line[3] = LineSegment(Coordinate(-2., -1.), Coordinate(-2., -0.5));
+    REQUIRE_FALSE(AngularCover::hides_directions_clockwise_of(Coordinate(0., 0.), short_of_edge_line, edge));
+
+    // Above the edge rays just below the line reach points under it past the walls unless they rise above it. Below
+    // the edge every direction needs hiding, which the edge does above the observer.
+    const auto observer_above = Coordinate(0., 0.000001);
+    REQUIRE_FALSE(AngularCover::hides_directions_clockwise_of(observer_above, below, edge));
+    auto walls_above_line = below;
+    walls_above_line[1] = LineSegment(Coordinate(2., 0.5), Coordinate(2., -1.));
+    walls_above_line[3] = LineSegment(Coordinate(-2., -1.), Coordinate(-2., 0.5));
+    REQUIRE(AngularCover::hides_directions_clockwise_of(observer_above, walls_above_line, edge));
+    REQUIRE_FALSE(AngularCover::hides_directions_clockwise_of(Coordinate(0., -0.000001), below, edge));
+    REQUIRE(AngularCover::hides_directions_clockwise_of(Coordinate(0., -0.000001), walls_above_line, edge));
+}
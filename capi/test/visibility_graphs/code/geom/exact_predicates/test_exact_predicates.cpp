@@ -0,0 +1,79 @@
+#include <catch.hpp>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include "geom/exact_predicates/exact_predicates.hpp"
+#include "types/coordinate/coordinate.hpp"
+#include "types/line_segment/line_segment.hpp"
+
+TEST_CASE("Exact Predicates orientation") {
+    const auto start = Coordinate(0, 0);
+    const auto end = Coordinate(100, 100);
+
+    REQUIRE(ExactPredicates::orientation(start, end, Coordinate(0, 100)) == Orientation::COUNTER_CLOCKWISE);
+    REQUIRE(ExactPredicates::orientation(start, end, Coordinate(100, 0)) == Orientation::CLOCKWISE);
+    REQUIRE(ExactPredicates::orientation(start, end, Coordinate(50, 50)) == Orientation::COLLINEAR);
+
+    // Products of these differences overflow 64 bits, and the floating point filter cannot resolve them
+    const auto min = std::numeric_limits<int32_t>::min();
+    const auto max = std::numeric_limits<int32_t>::max();
+    REQUIRE(ExactPredicates::orientation(Coordinate(min, min), Coordinate(max, max), Coordinate(max - 1, max - 1)) ==
+            Orientation::COLLINEAR);
+    REQUIRE(ExactPredicates::orientation(Coordinate(min, min), Coordinate(max, max), Coordinate(max - 1, max)) ==
+            Orientation::COUNTER_CLOCKWISE);
+}
+
+TEST_CASE("Exact Predicates crosses ray before vertex") {
+    const auto observer = Coordinate(0, 0);
+    const auto vertex = Coordinate(10, 10);
+
+    // Crossing between the observer and the vertex
+    REQUIRE(ExactPredicates::crosses_ray_before_vertex(Coordinate(0, 10), Coordinate(10, 0), observer, vertex));
+    // Ending at the vertex
+    REQUIRE_FALSE(ExactPredicates::crosses_ray_before_vertex(Coordinate(0, 20), vertex, observer, vertex));
+    // Crossing beyond the vertex
+    REQUIRE_FALSE(ExactPredicates::crosses_ray_before_vertex(Coordinate(0, 30), Coordinate(30, 0), observer, vertex));
+    // Collinear edges only obstruct when ending at the observer
+    REQUIRE(ExactPredicates::crosses_ray_before_vertex(observer, Coordinate(-5, -5), observer, vertex));
+    REQUIRE_FALSE(ExactPredicates::crosses_ray_before_vertex(Coordinate(2, 2), Coordinate(5, 5), observer, vertex));
+
+    // Crosses just short of the vertex, at a point which rounds to the vertex
+    REQUIRE(ExactPredicates::crosses_ray_before_vertex(Coordinate(54, -14), Coordinate(9, 20), observer,
+                                                       Coordinate(15, 16)));
+}
+
+TEST_CASE("Exact Predicates agree with intersection_with_segment away from rounding") {
+    auto generator = std::mt19937(42);
+    auto grid_coordinate = std::uniform_int_distribution<int32_t>(-4, 4);
+    const auto random_coordinate = [&]() {
+        return Coordinate(grid_coordinate(generator) * 1000000, grid_coordinate(generator) * 1000000);
+    };
+
+    for (size_t i = 0; i < 10000; ++i) {
+        const auto edge = LineSegment(random_coordinate(), random_coordinate());
+        const auto observer = random_coordinate();
+        const auto vertex = random_coordinate();
+        if (observer == vertex) {
+            continue;
+        }
+
+        const auto intersection = edge.intersection_with_segment(LineSegment(observer, vertex));
+        const auto expected = intersection.has_value() && intersection.value() != vertex;
+        REQUIRE(ExactPredicates::crosses_ray_before_vertex(edge.get_endpoint_1(), edge.get_endpoint_2(), observer,
+                                                           vertex) == expected);
+    }
+}
+
+TEST_CASE("Exact Predicates squared distance to crossing") {
+    const auto ray_start = Coordinate(0, 0);
+    const auto ray_end = Coordinate(100, 0);
+
+    REQUIRE(ExactPredicates::squared_distance_to_crossing(Coordinate(30, -10), Coordinate(30, 10), ray_start,
+                                                          ray_end) == 900);
+    // Crossing at 20.5 along the ray is rounded away from the start
+    REQUIRE(ExactPredicates::squared_distance_to_crossing(Coordinate(20, -1), Coordinate(21, 1), ray_start,
+                                                          ray_end) == 441);
+    REQUIRE_THROWS(ExactPredicates::squared_distance_to_crossing(Coordinate(0, 1), Coordinate(10, 1), ray_start,
+                                                                 ray_end));
+}
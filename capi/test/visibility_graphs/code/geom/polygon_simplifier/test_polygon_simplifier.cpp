@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <catch.hpp>
+#include <vector>
+
+#include "geom/polygon_simplifier/polygon_simplifier.hpp"
+#include "types/coordinate/coordinate.hpp"
+#include "types/polygon/polygon.hpp"
+
+namespace {
+bool contains_vertex(const std::vector<Coordinate> &vertices, const Coordinate &vertex) {
+    return std::find(vertices.begin(), vertices.end(), vertex) != vertices.end();
+}
+} // namespace
+
+TEST_CASE("Polygon Simplifier removes small convex vertices") {
+    const auto polygon = Polygon({Coordinate(0., 0.), Coordinate(0.49999, 0.), Coordinate(0.5, -0.00001),
+                                  Coordinate(0.50001, 0.), Coordinate(1., 0.), Coordinate(1., 1.), Coordinate(0., 1.)});
+    const auto expected_vertices =
+        Polygon({Coordinate(0., 0.), Coordinate(1., 0.), Coordinate(1., 1.), Coordinate(0., 1.)}).get_vertices();
+
+    for (const auto method : {SimplificationMethod::DOUGLAS_PEUCKER, SimplificationMethod::VISVALINGAM}) {
+        const auto simplified = PolygonSimplifier::simplify({polygon}, method, 10.0);
+
+        REQUIRE(simplified.size() == 1);
+        REQUIRE(simplified[0].get_vertices() == expected_vertices);
+    }
+}
+
+TEST_CASE("Polygon Simplifier never moves boundaries seaward") {
+    // Dropping the notch would fill in water
+    const auto notch = Coordinate(0.5, 0.00001);
+    const auto polygon = Polygon({Coordinate(0., 0.), Coordinate(0.49999, 0.), notch, Coordinate(0.50001, 0.),
+                                  Coordinate(1., 0.), Coordinate(1., 1.), Coordinate(0., 1.)});
+
+    for (const auto method : {SimplificationMethod::DOUGLAS_PEUCKER, SimplificationMethod::VISVALINGAM}) {
+        const auto simplified_vertices = PolygonSimplifier::simplify({polygon}, method, 10.0)[0].get_vertices();
+
+        REQUIRE(contains_vertex(simplified_vertices, notch));
+    }
+}
+
+TEST_CASE("Polygon Simplifier outwards removes notches and keeps spikes") {
+    const auto notch = Coordinate(0.5, 0.00001);
+    const auto spike = Coordinate(0.5, 1.00001);
+    const auto polygon = Polygon({Coordinate(0., 0.), Coordinate(0.49999, 0.), notch, Coordinate(0.50001, 0.),
+                                  Coordinate(1., 0.), Coordinate(1., 1.), Coordinate(0.50001, 1.), spike,
+                                  Coordinate(0.49999, 1.), Coordinate(0., 1.)});
+
+    for (const auto method : {SimplificationMethod::DOUGLAS_PEUCKER, SimplificationMethod::VISVALINGAM}) {
+        const auto simplified_vertices =
+            PolygonSimplifier::simplify_outwards({polygon}, method, 10.0)[0].get_vertices();
+
+        REQUIRE(!contains_vertex(simplified_vertices, notch));
+        REQUIRE(contains_vertex(simplified_vertices, spike));
+    }
+}
+
+TEST_CASE("Polygon Simplifier does not introduce self intersections") {
+    // A narrow inlet reaches into the triangle that removing the spike would cut off
+    const auto spike = Coordinate(0.5, -0.0001);
+    const auto polygon = Polygon({
+        Coordinate(0., 0.),
+        Coordinate(0.4, 0.),
+        spike,
+        Coordinate(0.6, 0.),
+        Coordinate(1., 0.),
+        Coordinate(1., 1.),
+        Coordinate(0.5001, 1.),
+        Coordinate(0.5001, -0.00005),
+        Coordinate(0.4999, -0.00005),
+        Coordinate(0.4999, 1.),
+        Coordinate(0., 1.),
+    });
+
+    for (const auto method : {SimplificationMethod::DOUGLAS_PEUCKER, SimplificationMethod::VISVALINGAM}) {
+        const auto simplified_vertices = PolygonSimplifier::simplify({polygon}, method, 1000.0)[0].get_vertices();
+
+        REQUIRE(contains_vertex(simplified_vertices, spike));
+        REQUIRE(contains_vertex(simplified_vertices, Coordinate(0.5001, -0.00005)));
+        REQUIRE(contains_vertex(simplified_vertices, Coordinate(0.4999, -0.00005)));
+    }
+}
+
+TEST_CASE("Polygon Simplifier zero tolerance leaves polygons unchanged") {
+    const auto polygon = Polygon(
+        {Coordinate(0., 0.), Coordinate(0.5, -0.00001), Coordinate(1., 0.), Coordinate(1., 1.), Coordinate(0., 1.)});
+
+    for (const auto method : {SimplificationMethod::DOUGLAS_PEUCKER, SimplificationMethod::VISVALINGAM}) {
+        REQUIRE(PolygonSimplifier::simplify({polygon}, method, 0.0)[0] == polygon);
+    }
+}
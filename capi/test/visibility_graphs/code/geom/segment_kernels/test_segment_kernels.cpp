@@ -0,0 +1,93 @@
+#include <catch.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "constants/constants.hpp"
+#include "geom/segment_kernels/segment_kernels.hpp"
+#include "types/coordinate/coordinate.hpp"
+#include "types/line_segment/line_segment.hpp"
+
+namespace {
+std::vector<LineSegment> random_segments(std::mt19937 &generator, size_t num_segments) {
+    // A coarse grid makes collinear and touching segments common
+    auto grid_coordinate = std::uniform_int_distribution<int32_t>(-6, 6);
+    const auto random_coordinate = [&]() {
+        return Coordinate(grid_coordinate(generator) * 90000000, grid_coordinate(generator) * 15000000);
+    };
+
+    auto segments = std::vector<LineSegment>();
+    for (size_t i = 0; i < num_segments; ++i) {
+        segments.emplace_back(random_coordinate(), random_coordinate());
+    }
+    return segments;
+}
+
+std::vector<InstructionSet> supported_instruction_sets() {
+    auto instruction_sets = std::vector<InstructionSet>();
+    for (const auto instruction_set : {InstructionSet::SCALAR, InstructionSet::AVX2, InstructionSet::AVX512}) {
+        if (SegmentKernels::is_supported(instruction_set)) {
+            instruction_sets.push_back(instruction_set);
+        }
+    }
+    return instruction_sets;
+}
+} // namespace
+
+TEST_CASE("Segment Kernels segments crossing ray") {
+    auto generator = std::mt19937(42);
+    const auto segments = random_segments(generator, 203);
+
+    auto block = SegmentBlock();
+    for (const auto &segment : segments) {
+        block.push_back(segment);
+    }
+
+    for (const auto &ray_start : {Coordinate(0, 0), Coordinate(-540000001, 15000000), Coordinate(90000000, 0)}) {
+        const auto ray = LineSegment(ray_start, Coordinate(MAX_PERIODIC_LONGITUDE_MICRODEGREES,
+                                                           ray_start.get_latitude_microdegrees()));
+
+        auto expected_hits = std::vector<uint8_t>();
+        for (const auto &segment : segments) {
+            const auto crosses = segment.intersection_with_segment(ray).has_value() &&
+                                 !ray.on_segment(segment.get_endpoint_1()) && !ray.on_segment(segment.get_endpoint_2());
+            expected_hits.push_back(crosses ? 1 : 0);
+        }
+
+        for (const auto instruction_set : supported_instruction_sets()) {
+            auto hits = std::vector<uint8_t>(segments.size());
+            SegmentKernels::segments_crossing_ray(block, ray.get_endpoint_1(), ray.get_endpoint_2(), hits.data(),
+                                                  instruction_set);
+
+            REQUIRE(hits == expected_hits);
+        }
+    }
+}
+
+TEST_CASE("Segment Kernels segments possibly within distance") {
+    auto generator = std::mt19937(7);
+    const auto segments = random_segments(generator, 203);
+    const auto point = Coordinate(10000000, 5000000);
+
+    auto block = SegmentBlock();
+    for (const auto &segment : segments) {
+        block.push_back(segment);
+    }
+
+    for (const auto max_distance : {0.0, 20.0, 95.0, static_cast<double>(INFINITY)}) {
+        for (const auto instruction_set : supported_instruction_sets()) {
+            auto hits = std::vector<uint8_t>(segments.size());
+            SegmentKernels::segments_possibly_within_distance(block, point, max_distance, hits.data(),
+                                                              instruction_set);
+
+            for (size_t i = 0; i < segments.size(); ++i) {
+                const auto distance = segments[i].distance_to_point(point);
+                if (distance <= max_distance) {
+                    REQUIRE(hits[i] == 1);
+                } else if (distance > max_distance * 1.001 + 1e-3) {
+                    REQUIRE(hits[i] == 0);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#include <atomic>
+#include <catch.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "scheduling/work_stealing_scheduler.hpp"
+
+TEST_CASE("Work Stealing Scheduler runs every task once") {
+    for (const size_t num_threads : {1, 2, 4, 7}) {
+        for (const size_t num_tasks : {0, 1, 5, 100, 1001}) {
+            for (const size_t batch_size : {0, 1, 3, 64}) {
+                auto task_run_counts = std::vector<std::atomic<int>>(num_tasks);
+                std::atomic<bool> thread_num_in_range = true;
+
+                WorkStealingScheduler(num_threads).run(num_tasks, batch_size, [&](size_t task_num, size_t thread_num) {
+                    thread_num_in_range = thread_num_in_range && thread_num < num_threads;
+                    ++task_run_counts[task_num];
+                });
+
+                REQUIRE(thread_num_in_range);
+                for (const auto &count : task_run_counts) {
+                    REQUIRE(count == 1);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Work Stealing Scheduler rethrows task exceptions") {
+    REQUIRE_THROWS_AS(WorkStealingScheduler(4).run(100, 1,
+                                                   [](size_t task_num, size_t) {
+                                                       if (task_num == 42) {
+                                                           throw std::runtime_error("Task failed");
+                                                       }
+                                                   }),
+                      std::runtime_error);
+}
@@ -0,0 +1,43 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <fstream>
+
+#include "serialization/contraction_hierarchy_serializer.hpp"
+#include "shortest_path/contraction_hierarchy_builder.hpp"
+#include "visgraph/visgraph_generator.hpp"
+
+TEST_CASE("Contraction hierarchy serialize") {
+    const auto graph = VisgraphGenerator::generate({
+        Polygon({Coordinate(1., 0.), Coordinate(0., 1.5), Coordinate(-1., 0.)}),
+        Polygon({Coordinate(4., 0.), Coordinate(3., 1.), Coordinate(2., 0.)}),
+        Polygon({Coordinate(179., 0.), Coordinate(178., 1.5), Coordinate(177., 0.)}),
+    });
+    const auto hierarchy = ContractionHierarchyBuilder::build(*graph);
+
+    char tmp_name[L_tmpnam];
+    tmpnam(tmp_name);
+
+    ContractionHierarchySerializer::serialize_to_file(hierarchy, tmp_name);
+    const auto deserialized_hierarchy = ContractionHierarchySerializer::deserialize_from_file(tmp_name);
+
+    REQUIRE(deserialized_hierarchy->get_coordinates() == hierarchy->get_coordinates());
+    REQUIRE(deserialized_hierarchy->get_ranks() == hierarchy->get_ranks());
+    REQUIRE(deserialized_hierarchy->get_edge_offsets() == hierarchy->get_edge_offsets());
+    REQUIRE(deserialized_hierarchy->get_edges().size() == hierarchy->get_edges().size());
+    for (size_t i = 0; i < hierarchy->get_edges().size(); ++i) {
+        REQUIRE(deserialized_hierarchy->get_edges()[i].vertex == hierarchy->get_edges()[i].vertex);
+        REQUIRE(deserialized_hierarchy->get_edges()[i].middle_vertex == hierarchy->get_edges()[i].middle_vertex);
+        REQUIRE(deserialized_hierarchy->get_edges()[i].length == hierarchy->get_edges()[i].length);
+    }
+
+    // Truncated files are rejected rather than read past their end
+    {
+        auto in = std::ifstream(tmp_name, std::ios::binary);
+        const auto contents = std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        auto out = std::ofstream(tmp_name, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size() - 1));
+    }
+    REQUIRE_THROWS(ContractionHierarchySerializer::deserialize_from_file(tmp_name));
+
+    remove(tmp_name);
+}
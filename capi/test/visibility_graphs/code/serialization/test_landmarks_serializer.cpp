@@ -0,0 +1,37 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <fstream>
+
+#include "serialization/landmarks_serializer.hpp"
+#include "shortest_path/landmark_builder.hpp"
+#include "visgraph/visgraph_generator.hpp"
+
+TEST_CASE("Landmarks serialize") {
+    const auto graph = VisgraphGenerator::generate({
+        Polygon({Coordinate(1., 0.), Coordinate(0., 1.5), Coordinate(-1., 0.)}),
+        Polygon({Coordinate(4., 0.), Coordinate(3., 1.), Coordinate(2., 0.)}),
+        Polygon({Coordinate(179., 0.), Coordinate(178., 1.5), Coordinate(177., 0.)}),
+    });
+    const auto landmarks = LandmarkBuilder::build(*graph, 3);
+
+    char tmp_name[L_tmpnam];
+    tmpnam(tmp_name);
+
+    LandmarksSerializer::serialize_to_file(landmarks, tmp_name);
+    const auto deserialized_landmarks = LandmarksSerializer::deserialize_from_file(tmp_name);
+
+    REQUIRE(deserialized_landmarks->get_coordinates() == landmarks->get_coordinates());
+    REQUIRE(deserialized_landmarks->get_landmark_vertices() == landmarks->get_landmark_vertices());
+    REQUIRE(deserialized_landmarks->get_distances() == landmarks->get_distances());
+
+    // Truncated files are rejected rather than read past their end
+    {
+        auto in = std::ifstream(tmp_name, std::ios::binary);
+        const auto contents = std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        auto out = std::ofstream(tmp_name, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size() - 1));
+    }
+    REQUIRE_THROWS(LandmarksSerializer::deserialize_from_file(tmp_name));
+
+    remove(tmp_name);
+}
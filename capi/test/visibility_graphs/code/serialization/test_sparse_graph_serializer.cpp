@@ -0,0 +1,99 @@
+#include <catch.hpp>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <unordered_set>
+
+#include "datastructures/graph/graph.hpp"
+#include "serialization/sparse_graph_builder.hpp"
+#include "serialization/sparse_graph_serializer.hpp"
+
+TEST_CASE("Sparse graph serialize") {
+    const auto coord1 = Coordinate(1., 2.);
+    const auto coord2 = Coordinate(2., 1.);
+    const auto coord3 = Coordinate(1., 1.);
+    const auto coord4 = Coordinate(39.068387, 47.276612);
+
+    // coord1 - coord2, coord1 - coord3 and coord3 - coord4 over the meridian
+    auto graph = std::make_shared<SparseGraph>(
+        std::vector<Polygon>{Polygon({coord1, coord2}), Polygon({coord3, coord4})},
+        std::vector<uint64_t>{0, 2, 3, 5, 6}, std::vector<uint32_t>{1, 2, 0, 0, 3, 2},
+        std::vector<uint8_t>{SparseGraph::CONNECTED, SparseGraph::CONNECTED, SparseGraph::CONNECTED,
+                             SparseGraph::CONNECTED, SparseGraph::CONNECTED_OVER_MERIDIAN,
+                             SparseGraph::CONNECTED_OVER_MERIDIAN});
+
+    char tmp_name[L_tmpnam];
+    tmpnam(tmp_name);
+
+    SparseGraphSerializer::serialize_to_file(graph, tmp_name);
+    const auto deserialized_graph = SparseGraphSerializer::deserialize_from_file(tmp_name);
+
+    remove(tmp_name);
+
+    REQUIRE(deserialized_graph->get_vertices() == graph->get_vertices());
+    REQUIRE(deserialized_graph->get_neighbor_offsets() == graph->get_neighbor_offsets());
+    REQUIRE(deserialized_graph->get_neighbor_indices() == graph->get_neighbor_indices());
+    REQUIRE(deserialized_graph->get_edge_states() == graph->get_edge_states());
+
+    REQUIRE(deserialized_graph->has_edge(coord1, coord2));
+    REQUIRE(deserialized_graph->has_edge(coord3, coord1));
+    REQUIRE_FALSE(deserialized_graph->has_edge(coord2, coord3));
+    REQUIRE_FALSE(deserialized_graph->has_edge(coord1, coord1));
+    REQUIRE(deserialized_graph->is_edge_meridian_crossing(coord4, coord3));
+    REQUIRE_FALSE(deserialized_graph->is_edge_meridian_crossing(coord1, coord2));
+    REQUIRE_THROWS(deserialized_graph->add_edge(coord2, coord3, false));
+    REQUIRE_THROWS(deserialized_graph->has_edge(coord1, Coordinate(5., 5.)));
+}
+
+TEST_CASE("Sparse graph builder merges spilled runs") {
+    // Enough edges to spill more runs than are merged in one pass
+    auto polygon_vertices = std::vector<Coordinate>();
+    for (int i = 0; i < 400; ++i) {
+        polygon_vertices.emplace_back(std::cos(i * 2 * M_PI / 400), std::sin(i * 2 * M_PI / 400));
+    }
+    const auto polygons = std::vector<Polygon>{Polygon(polygon_vertices)};
+    const auto &vertices = polygons[0].get_vertices();
+    REQUIRE(vertices.size() == polygon_vertices.size());
+
+    auto expected_graph = std::make_shared<Graph>(polygons);
+
+    char tmp_name[L_tmpnam];
+    tmpnam(tmp_name);
+    const auto run_directory = std::string(tmp_name) + ".runs";
+
+    {
+        auto builder = SparseGraphBuilder(polygons, run_directory, 0);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            auto visible_vertices = std::vector<VisibleVertex>();
+            for (size_t j = 0; j < vertices.size(); ++j) {
+                if ((i + j) % 3 != 0) {
+                    // Seen from both ends, with the meridian flag differing on some, as a full scan would
+                    const auto is_visible_across_meridian = (i * j) % 5 == 0 && i > j;
+                    visible_vertices.push_back(VisibleVertex{.coord = vertices[j],
+                                                             .is_visible_across_meridian = is_visible_across_meridian});
+                    expected_graph->add_edge(vertices[i], vertices[j], is_visible_across_meridian);
+                }
+            }
+            builder.add_edges(vertices[i], visible_vertices);
+        }
+        REQUIRE(builder.get_num_runs() > 64);
+
+        builder.finalize(tmp_name);
+        REQUIRE(builder.get_num_runs() == 0);
+    }
+    REQUIRE_FALSE(std::filesystem::exists(run_directory));
+
+    const auto graph = SparseGraphSerializer::deserialize_from_file(tmp_name);
+    remove(tmp_name);
+
+    for (const auto &a : vertices) {
+        const auto neighbors = graph->get_neighbors(a);
+        const auto expected_neighbors = expected_graph->get_neighbors(a);
+        REQUIRE(std::unordered_set<Coordinate>(neighbors.begin(), neighbors.end()) ==
+                std::unordered_set<Coordinate>(expected_neighbors.begin(), expected_neighbors.end()));
+
+        for (const auto &b : neighbors) {
+            REQUIRE(graph->is_edge_meridian_crossing(a, b) == expected_graph->is_edge_meridian_crossing(a, b));
+        }
+    }
+}
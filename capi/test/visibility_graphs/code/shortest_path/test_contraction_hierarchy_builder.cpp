@@ -0,0 +1,84 @@
+#include <catch.hpp>
+#include <cmath>
+
+#include "datastructures/indexed_graph/indexed_graph.hpp"
+#include "shortest_path/contraction_hierarchy_builder.hpp"
+#include "shortest_path/shortest_path_computer.hpp"
+#include "visgraph/visgraph_generator.hpp"
+
+namespace {
+std::shared_ptr<Graph> generate_islands_graph() {
+    auto island_vertices = std::vector<Coordinate>();
+    for (int i = 0; i < 40; ++i) {
+        const auto angle = i * 2 * M_PI / 40;
+        const auto radius = i % 2 == 0 ? 8. : 6.;
+        island_vertices.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+
+    return VisgraphGenerator::generate({
+        Polygon(island_vertices),
+        Polygon({Coordinate(-12., -3.), Coordinate(-11., -3.), Coordinate(-11.5, 3.)}),
+        Polygon({Coordinate(179., 0.), Coordinate(178., 1.5), Coordinate(177., 0.)}),
+        Polygon({Coordinate(-178., -1.), Coordinate(-177., 0.5), Coordinate(-179., 0.5)}),
+    });
+}
+} // namespace
+
+TEST_CASE("ContractionHierarchyBuilder ranks each vertex once with edges only leading upward") {
+    const auto graph = generate_islands_graph();
+    const auto hierarchy = ContractionHierarchyBuilder::build(*graph);
+
+    REQUIRE(hierarchy->get_coordinates() == graph->get_vertices());
+
+    auto ranks = hierarchy->get_ranks();
+    std::sort(ranks.begin(), ranks.end());
+    for (uint32_t i = 0; i < ranks.size(); ++i) {
+        REQUIRE(ranks[i] == i);
+    }
+
+    for (uint32_t vertex = 0; vertex < hierarchy->get_num_vertices(); ++vertex) {
+        const auto edges = hierarchy->get_upward_edges(vertex);
+        for (const auto &edge : edges) {
+            REQUIRE(hierarchy->get_ranks()[edge.vertex] > hierarchy->get_ranks()[vertex]);
+            if (edge.middle_vertex != ContractionHierarchy::NO_MIDDLE_VERTEX) {
+                REQUIRE(hierarchy->get_ranks()[edge.middle_vertex] < hierarchy->get_ranks()[vertex]);
+            }
+        }
+        REQUIRE(std::is_sorted(edges.begin(), edges.end(),
+                               [](const ContractionHierarchy::UpwardEdge &a,
+                                  const ContractionHierarchy::UpwardEdge &b) { return a.vertex < b.vertex; }));
+    }
+}
+
+TEST_CASE("ContractionHierarchyBuilder shortcuts unpack into graph paths of the same length") {
+    const auto graph = generate_islands_graph();
+    const auto indexed_graph = IndexedGraph(*graph);
+    const auto hierarchy = ContractionHierarchyBuilder::build(*graph);
+
+    size_t num_shortcuts = 0;
+    for (uint32_t vertex = 0; vertex < hierarchy->get_num_vertices(); ++vertex) {
+        for (const auto &edge : hierarchy->get_upward_edges(vertex)) {
+            auto path = std::vector<uint32_t>{vertex};
+            hierarchy->unpack_edge(vertex, edge.vertex, path);
+            REQUIRE(path.back() == edge.vertex);
+            REQUIRE((path.size() == 2) == (edge.middle_vertex == ContractionHierarchy::NO_MIDDLE_VERTEX));
+            num_shortcuts += path.size() > 2;
+
+            double length = 0;
+            for (size_t i = 1; i < path.size(); ++i) {
+                const auto &a = indexed_graph.get_coordinate(path[i - 1]);
+                const auto &b = indexed_graph.get_coordinate(path[i]);
+                REQUIRE(graph->has_edge(a, b));
+                length += ShortestPathComputer::distance_measurement(a, b, graph->is_edge_meridian_crossing(a, b));
+            }
+            REQUIRE(std::abs(length - edge.length) < 1e-9);
+
+            // Unpacking from either end gives the same path
+            auto reverse_path = std::vector<uint32_t>{edge.vertex};
+            hierarchy->unpack_edge(edge.vertex, vertex, reverse_path);
+            std::reverse(reverse_path.begin(), reverse_path.end());
+            REQUIRE(reverse_path == path);
+        }
+    }
+    REQUIRE(num_shortcuts > 0);
+}
@@ -0,0 +1,64 @@
+#include <catch.hpp>
+#include <cmath>
+#include <unordered_set>
+
+#include "shortest_path/landmark_builder.hpp"
+#include "shortest_path/shortest_path_computer.hpp"
+#include "visgraph/visgraph_generator.hpp"
+
+TEST_CASE("LandmarkBuilder picks distinct landmarks with their shortest distances") {
+    auto island_vertices = std::vector<Coordinate>();
+    for (int i = 0; i < 40; ++i) {
+        const auto angle = i * 2 * M_PI / 40;
+        const auto radius = i % 2 == 0 ? 8. : 6.;
+        island_vertices.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    const auto graph = VisgraphGenerator::generate({
+        Polygon(island_vertices),
+        Polygon({Coordinate(-12., -3.), Coordinate(-11., -3.), Coordinate(-11.5, 3.)}),
+        Polygon({Coordinate(179., 0.), Coordinate(178., 1.5), Coordinate(177., 0.)}),
+    });
+    const auto landmarks = LandmarkBuilder::build(*graph, 4);
+    const auto path_computer = ShortestPathComputer(graph);
+
+    REQUIRE(landmarks->get_coordinates() == graph->get_vertices());
+    REQUIRE(landmarks->get_num_landmarks() == 4);
+    const auto &landmark_vertices = landmarks->get_landmark_vertices();
+    REQUIRE(std::unordered_set<uint32_t>(landmark_vertices.begin(), landmark_vertices.end()).size() == 4);
+
+    const auto &vertices = graph->get_vertices();
+    for (uint32_t landmark = 0; landmark < landmarks->get_num_landmarks(); ++landmark) {
+        const auto &landmark_coordinate = vertices[landmark_vertices[landmark]];
+        for (uint32_t vertex = 0; vertex < vertices.size(); ++vertex) {
+            const auto distance = landmarks->get_distances()[vertex * landmarks->get_num_landmarks() + landmark];
+            if (vertices[vertex] == landmark_coordinate) {
+                REQUIRE(distance == 0);
+                continue;
+            }
+
+            const auto path = path_computer.shortest_path(landmark_coordinate, vertices[vertex]);
+            double path_length = 0;
+            for (size_t i = 1; i < path.size(); ++i) {
+                path_length += ShortestPathComputer::distance_measurement(
+                    path[i - 1], path[i], graph->is_edge_meridian_crossing(path[i - 1], path[i]));
+            }
+            REQUIRE(std::abs(distance - path_length) < 1e-9);
+        }
+    }
+}
+
+TEST_CASE("LandmarkBuilder picks no more landmarks than vertices") {
+    const auto graph = VisgraphGenerator::generate({
+        Polygon({Coordinate(1., 0.), Coordinate(0., 1.5), Coordinate(-1., 0.)}),
+        Polygon({Coordinate(4., 0.), Coordinate(3., 1.), Coordinate(2., 0.)}),
+    });
+
+    const auto landmarks = LandmarkBuilder::build(*graph);
+    REQUIRE(landmarks->get_num_landmarks() > 0);
+    REQUIRE(landmarks->get_num_landmarks() <= graph->get_vertices().size());
+    REQUIRE(landmarks->get_distances().size() == landmarks->get_num_landmarks() * graph->get_vertices().size());
+
+    const auto no_landmarks = LandmarkBuilder::build(*graph, 0);
+    REQUIRE(no_landmarks->get_num_landmarks() == 0);
+    REQUIRE(no_landmarks->get_distances().empty());
+}
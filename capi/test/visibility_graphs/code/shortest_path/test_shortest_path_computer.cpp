@@ -3,11 +3,58 @@
 //
 
 #include <catch.hpp>
+#include <cmath>
 
 #include "datastructures/graph/graph.hpp"
+#include "geom/polygon_simplifier/polygon_simplifier.hpp"
+#include "shortest_path/contraction_hierarchy_builder.hpp"
+#include "shortest_path/landmark_builder.hpp"
 #include "shortest_path/shortest_path_computer.hpp"
 #include "visgraph/visgraph_generator.hpp"
 
+namespace {
+// A star-shaped island with points 8 degrees from the origin, and inlets between them reaching in to inlet_radius
+Polygon star_island_polygon(int num_points = 20, double inlet_radius = 6.) {
+    auto island_vertices = std::vector<Coordinate>();
+    for (int i = 0; i < 2 * num_points; ++i) {
+        const auto angle = i * M_PI / num_points;
+        const auto radius = i % 2 == 0 ? 8. : inlet_radius;
+        island_vertices.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    return Polygon(island_vertices);
+}
+
+// A square island 2 degrees across, centred on the origin
+Polygon square_island_polygon() {
+    return Polygon({Coordinate(1., 1.), Coordinate(1., -1.), Coordinate(-1., -1.), Coordinate(-1., 1.)});
+}
+
+// The star island, a thin island to its west, and an island by the meridian
+std::vector<Polygon> star_island_polygons() {
+    return {
+        star_island_polygon(),
+        Polygon({Coordinate(-12., -3.), Coordinate(-11., -3.), Coordinate(-11.5, 3.)}),
+        Polygon({Coordinate(179., 0.), Coordinate(178., 1.5), Coordinate(177., 0.)}),
+    };
+}
+
+// Endpoints off the graph of the star island polygons, on it, and either side of the meridian
+std::vector<Coordinate> star_island_endpoints() {
+    return {
+        Coordinate(-14., 0.5), Coordinate(10., -0.5), Coordinate(0.3, 10.), Coordinate(-9., -9.),
+        Coordinate(8., 0.),    Coordinate(176., 0.5), Coordinate(-179., 0.5),
+    };
+}
+
+double path_length(const std::vector<Coordinate> &path) {
+    double length = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        length += ShortestPathComputer::heuristic_distance_measurement(path[i - 1], path[i]);
+    }
+    return length;
+}
+} // namespace
+
 TEST_CASE("ShortestPathComputer shortest path") {
     const auto poly1 = Polygon({
         Coordinate(1., 0.),
@@ -218,3 +265,428 @@ TEST_CASE("ShortestPathComputer prevent going out of bounds") {
 
     REQUIRE_THROWS(path_computer.shortest_path(a, b, 1.));
 }
+
+TEST_CASE("ShortestPathComputer search state does not leak between queries") {
+    const auto small_graph = VisgraphGenerator::generate({Polygon({
+        Coordinate(1., 0.),
+        Coordinate(0., 1.),
+        Coordinate(-1., 0.),
+    })});
+    const auto large_graph = VisgraphGenerator::generate({
+        Polygon({Coordinate(1., 0.), Coordinate(0., 1.5), Coordinate(-1., 0.)}),
+        Polygon({Coordinate(4., 0.), Coordinate(3., 1.), Coordinate(2., 0.)}),
+        Polygon({Coordinate(179., 0.), Coordinate(178., 1.5), Coordinate(177., 0.)}),
+    });
+    const auto small_path_computer = ShortestPathComputer(small_graph);
+    const auto large_path_computer = ShortestPathComputer(large_graph);
+
+    const auto small_path = small_path_computer.shortest_path(Coordinate(-2., 0.), Coordinate(1., 1.));
+    const auto large_path = large_path_computer.shortest_path(Coordinate(-2., 0.), Coordinate(3., 1.));
+
+    // Searches on this thread share their state, whichever computer runs them
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(large_path_computer.shortest_path(Coordinate(-2., 0.), Coordinate(3., 1.)) == large_path);
+        REQUIRE(small_path_computer.shortest_path(Coordinate(-2., 0.), Coordinate(1., 1.)) == small_path);
+        REQUIRE_THROWS(small_path_computer.shortest_path(Coordinate(-2., 0.), Coordinate(1., 1.), 1.));
+    }
+}
+
+TEST_CASE("ShortestPathComputer expands each vertex at most once") {
+    const auto graph = VisgraphGenerator::generate({star_island_polygon()});
+    const auto path_computer = ShortestPathComputer(graph);
+
+    const auto a = Coordinate(-10., 0.5);
+    const auto b = Coordinate(10., -0.5);
+    auto num_expanded_vertices = std::vector<size_t>();
+    for (const auto a_star_greediness_weighting : {1., 3.}) {
+        const auto stats = std::make_shared<SearchStats>();
+        const auto path = path_computer.shortest_path(a, b, INFINITY, false, a_star_greediness_weighting,
+                                                      SearchAlgorithm::A_STAR, SearchHeuristic::STRAIGHT_LINE, stats);
+
+        REQUIRE(path.front() == a);
+        REQUIRE(path.back() == b);
+        for (size_t i = 2; i < path.size() - 1; ++i) {
+            REQUIRE(graph->has_edge(path[i - 1], path[i]));
+        }
+
+        const auto snapshot = stats->snapshot();
+        REQUIRE(snapshot.num_searches == 1);
+        REQUIRE(snapshot.num_expanded_vertices > 0);
+        REQUIRE(snapshot.num_expanded_vertices <= graph->get_vertices().size() + 1);
+        REQUIRE(snapshot.num_relaxed_edges >= snapshot.num_expanded_vertices);
+        num_expanded_vertices.push_back(snapshot.num_expanded_vertices);
+    }
+
+    // The greedier search heads more directly around the island
+    REQUIRE(num_expanded_vertices[1] <= num_expanded_vertices[0]);
+}
+
+TEST_CASE("ShortestPathComputer bidirectional search finds the same paths") {
+    const auto graph = VisgraphGenerator::generate(star_island_polygons());
+    const auto path_computer = ShortestPathComputer(graph);
+
+    const auto endpoints = star_island_endpoints();
+    for (const auto &a : endpoints) {
+        for (const auto &b : endpoints) {
+            if (a == b) {
+                continue;
+            }
+
+            REQUIRE(path_computer.shortest_path(a, b, INFINITY, false, 1., SearchAlgorithm::BIDIRECTIONAL_A_STAR) ==
+                    path_computer.shortest_path(a, b));
+        }
+    }
+
+    const auto a = Coordinate(-14., 0.5);
+    const auto b = Coordinate(10., -0.5);
+    REQUIRE_THROWS(path_computer.shortest_path(a, b, 5., false, 1., SearchAlgorithm::BIDIRECTIONAL_A_STAR));
+
+    const auto paths = path_computer.shortest_paths({{a, b}, {b, a}}, INFINITY, false, 1.,
+                                                    SearchAlgorithm::BIDIRECTIONAL_A_STAR);
+    REQUIRE(paths[0].path == path_computer.shortest_path(a, b));
+    REQUIRE(paths[1].path == path_computer.shortest_path(b, a));
+}
+
+TEST_CASE("ShortestPathComputer bidirectional search expands fewer vertices without a heuristic") {
+    auto islands = std::vector<Polygon>();
+    for (int i = -5; i <= 5; ++i) {
+        for (int j = -5; j <= 5; ++j) {
+            islands.push_back(Polygon({
+                Coordinate(4. * i + 1., 4. * j),
+                Coordinate(4. * i + 0.5, 4. * j + 1.),
+                Coordinate(4. * i, 4. * j),
+            }));
+        }
+    }
+    const auto graph = VisgraphGenerator::generate(islands);
+    const auto path_computer = ShortestPathComputer(graph);
+
+    // Without a heuristic, the two searches each cover about half the distance between the endpoints. The islands'
+    // peaks are collinear, so the two may pick different paths of the same length.
+    const auto dijkstra_stats = std::make_shared<SearchStats>();
+    const auto bidirectional_dijkstra_stats = std::make_shared<SearchStats>();
+    const auto a = Coordinate(-5.5, 0.5);
+    const auto b = Coordinate(6.5, 0.5);
+    const auto dijkstra_path =
+        path_computer.shortest_path(a, b, INFINITY, false, 0., SearchAlgorithm::A_STAR, SearchHeuristic::STRAIGHT_LINE,
+                                    dijkstra_stats);
+    const auto bidirectional_dijkstra_path =
+        path_computer.shortest_path(a, b, INFINITY, false, 0., SearchAlgorithm::BIDIRECTIONAL_A_STAR,
+                                    SearchHeuristic::STRAIGHT_LINE, bidirectional_dijkstra_stats);
+    REQUIRE(std::abs(path_length(bidirectional_dijkstra_path) - path_length(dijkstra_path)) < 1e-9);
+    REQUIRE(bidirectional_dijkstra_stats->snapshot().num_expanded_vertices <
+            dijkstra_stats->snapshot().num_expanded_vertices);
+}
+
+TEST_CASE("ShortestPathComputer contraction hierarchy search finds the same paths") {
+    const auto graph = VisgraphGenerator::generate(star_island_polygons());
+    const auto hierarchy = ContractionHierarchyBuilder::build(*graph);
+    const auto path_computer = ShortestPathComputer(graph, nullptr, DEFAULT_REFINEMENT_RADIUS, hierarchy);
+
+    const auto endpoints = star_island_endpoints();
+    const auto stats = std::make_shared<SearchStats>();
+    for (const auto &a : endpoints) {
+        for (const auto &b : endpoints) {
+            if (a == b) {
+                continue;
+            }
+
+            REQUIRE(path_computer.shortest_path(a, b, INFINITY, false, 1., SearchAlgorithm::CONTRACTION_HIERARCHY,
+                                                SearchHeuristic::STRAIGHT_LINE,
+                                                stats) == path_computer.shortest_path(a, b));
+        }
+    }
+    REQUIRE(stats->snapshot().num_searches > 0);
+
+    // Paths going further from the source than the maximum distance are searched for within it instead
+    const auto a = Coordinate(-14., 0.5);
+    const auto b = Coordinate(10., -0.5);
+    REQUIRE_THROWS(path_computer.shortest_path(a, b, 5., false, 1., SearchAlgorithm::CONTRACTION_HIERARCHY));
+    REQUIRE(path_computer.shortest_path(a, b, 30., false, 1., SearchAlgorithm::CONTRACTION_HIERARCHY) ==
+            path_computer.shortest_path(a, b, 30.));
+
+    const auto paths = path_computer.shortest_paths({{a, b}, {b, a}}, INFINITY, false, 1.,
+                                                    SearchAlgorithm::CONTRACTION_HIERARCHY);
+    REQUIRE(paths[0].path == path_computer.shortest_path(a, b));
+    REQUIRE(paths[1].path == path_computer.shortest_path(b, a));
+
+    REQUIRE_THROWS(ShortestPathComputer(graph).shortest_path(a, b, INFINITY, false, 1.,
+                                                              SearchAlgorithm::CONTRACTION_HIERARCHY));
+    const auto other_graph = VisgraphGenerator::generate({star_island_polygon()});
+    REQUIRE_THROWS(ShortestPathComputer(other_graph, nullptr, DEFAULT_REFINEMENT_RADIUS, hierarchy));
+}
+
+TEST_CASE("ShortestPathComputer landmark heuristic finds paths as short with fewer expansions") {
+    // A bay opening east, whose back the straight line leads searches from the west into, among small islands
+    auto polygons = std::vector<Polygon>{Polygon({
+        Coordinate(-10., -10.),
+        Coordinate(10., -10.),
+        Coordinate(10., -6.),
+        Coordinate(-6., -6.),
+        Coordinate(-6., 6.),
+        Coordinate(10., 6.),
+        Coordinate(10., 10.),
+        Coordinate(-10., 10.),
+    })};
+    for (int x = -20; x <= 20; x += 4) {
+        for (int y = -20; y <= 20; y += 4) {
+            if (std::abs(x) > 12 || std::abs(y) > 12) {
+                polygons.push_back(Polygon({Coordinate(x + 1., y + 1.), Coordinate(x + 0.5, y + 2.),
+                                            Coordinate(x + 0., y + 1.)}));
+            }
+        }
+    }
+    const auto graph = VisgraphGenerator::generate(polygons);
+    const auto landmarks = LandmarkBuilder::build(*graph, 8);
+    const auto path_computer = ShortestPathComputer(graph, nullptr, DEFAULT_REFINEMENT_RADIUS, nullptr, landmarks);
+
+    // Endpoints off the graph and on it
+    const auto sources = std::vector<Coordinate>{Coordinate(-14., 0.5), Coordinate(-10., 10.), Coordinate(-15., -15.)};
+    const auto destinations = std::vector<Coordinate>{Coordinate(0., 0.5), Coordinate(-6., 6.)};
+    const auto straight_line_stats = std::make_shared<SearchStats>();
+    const auto landmark_stats = std::make_shared<SearchStats>();
+    for (const auto &a : sources) {
+        for (const auto &b : destinations) {
+            const auto shortest_path = path_computer.shortest_path(a, b, INFINITY, false, 1., SearchAlgorithm::A_STAR,
+                                                                   SearchHeuristic::STRAIGHT_LINE, straight_line_stats);
+            for (const auto search_algorithm : {SearchAlgorithm::A_STAR, SearchAlgorithm::BIDIRECTIONAL_A_STAR}) {
+                const auto path =
+                    path_computer.shortest_path(a, b, INFINITY, false, 1., search_algorithm, SearchHeuristic::LANDMARKS,
+                                                search_algorithm == SearchAlgorithm::A_STAR ? landmark_stats : nullptr);
+                REQUIRE(path.front() == a);
+                REQUIRE(path.back() == b);
+                REQUIRE(std::abs(path_length(path) - path_length(shortest_path)) < 1e-9);
+            }
+        }
+    }
+    REQUIRE(landmark_stats->snapshot().num_expanded_vertices < straight_line_stats->snapshot().num_expanded_vertices);
+
+    const auto a = sources.front();
+    const auto b = destinations.front();
+    const auto paths = path_computer.shortest_paths({{a, b}, {b, a}}, INFINITY, false, 1., SearchAlgorithm::A_STAR,
+                                                    SearchHeuristic::LANDMARKS);
+    REQUIRE(std::abs(path_length(paths[0].path.value()) - path_length(path_computer.shortest_path(a, b))) < 1e-9);
+    REQUIRE(std::abs(path_length(paths[1].path.value()) - path_length(path_computer.shortest_path(b, a))) < 1e-9);
+
+    REQUIRE_THROWS(ShortestPathComputer(graph).shortest_path(a, b, INFINITY, false, 1., SearchAlgorithm::A_STAR,
+                                                              SearchHeuristic::LANDMARKS));
+    const auto other_graph = VisgraphGenerator::generate({polygons.front()});
+    REQUIRE_THROWS(ShortestPathComputer(other_graph, nullptr, DEFAULT_REFINEMENT_RADIUS, nullptr, landmarks));
+}
+
+TEST_CASE("ShortestPathComputer distance matrix matches single paths") {
+    const auto graph = VisgraphGenerator::generate(star_island_polygons());
+    const auto path_computer = ShortestPathComputer(graph);
+
+    // Endpoints off the graph, on it, either side of the meridian, and one seen directly from the first source
+    const auto sources = std::vector<Coordinate>{Coordinate(-14., 0.5), Coordinate(8., 0.), Coordinate(-179., 0.5)};
+    const auto targets = std::vector<Coordinate>{Coordinate(10., -0.5), Coordinate(0.3, 10.), Coordinate(-9., -9.),
+                                                 Coordinate(176., 0.5), Coordinate(-14., 5.)};
+    const auto stats = std::make_shared<SearchStats>();
+    const auto matrix = path_computer.distance_matrix(sources, targets, INFINITY, false, true, stats);
+    REQUIRE(stats->snapshot().num_searches == sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        REQUIRE(!matrix.source_error_msgs[i].has_value());
+        for (size_t j = 0; j < targets.size(); ++j) {
+            const auto path = path_computer.shortest_path(sources[i], targets[j]);
+            REQUIRE(matrix.paths[i][j] == path);
+            REQUIRE(std::abs(matrix.distances[i][j] - path_length(path)) < 1e-9);
+        }
+    }
+
+    // Paths are left out unless asked for, and targets further than the maximum distance are not reached
+    const auto near_matrix = path_computer.distance_matrix(sources, targets, 30.);
+    REQUIRE(near_matrix.paths.empty());
+    REQUIRE(std::abs(near_matrix.distances[0][0] - matrix.distances[0][0]) < 1e-9);
+    REQUIRE(std::isinf(near_matrix.distances[0][3]));
+
+    // Endpoints on land are reported unless they are moved off it
+    const auto on_land = Coordinate(0., 0.);
+    const auto land_matrix = path_computer.distance_matrix({sources[0], on_land}, {targets[0], on_land});
+    REQUIRE(land_matrix.source_error_msgs[1].has_value());
+    REQUIRE(land_matrix.target_error_msgs[1].has_value());
+    REQUIRE(std::isinf(land_matrix.distances[0][1]));
+    REQUIRE(std::abs(land_matrix.distances[0][0] - matrix.distances[0][0]) < 1e-9);
+    const auto corrected_matrix =
+        path_computer.distance_matrix({sources[0], on_land}, {targets[0], on_land}, INFINITY, true, true);
+    REQUIRE(corrected_matrix.paths[0][1] == path_computer.shortest_path(sources[0], on_land, INFINITY, true));
+    REQUIRE(corrected_matrix.paths[1][0] == path_computer.shortest_path(on_land, targets[0], INFINITY, true));
+}
+
+TEST_CASE("ShortestPathComputer batches match single paths with repeated endpoints") {
+    const auto graph = VisgraphGenerator::generate(star_island_polygons());
+    const auto path_computer = ShortestPathComputer(graph);
+
+    // Repeated pairs, sources shared across destinations, the same source written either side of the meridian, and
+    // endpoints on land
+    const auto a = Coordinate(-14., 0.5);
+    const auto b = Coordinate(10., -0.5);
+    const auto c = Coordinate(0.3, 10.);
+    const auto d = Coordinate(-179., 0.5);
+    const auto on_land = Coordinate(0., 0.);
+    const auto source_dest_pairs = std::vector<std::pair<Coordinate, Coordinate>>{
+        {a, b}, {a, c}, {a, b}, {c, b}, {d, a}, {Coordinate(181., 0.5), a}, {a, on_land}, {on_land, b}, {a, b},
+    };
+
+    for (const auto correct_vertices_on_land : {false, true}) {
+        const auto stats = std::make_shared<SearchStats>();
+        const auto paths = path_computer.shortest_paths(source_dest_pairs, INFINITY, correct_vertices_on_land, 1.,
+                                                        SearchAlgorithm::A_STAR, SearchHeuristic::STRAIGHT_LINE, stats);
+        REQUIRE(paths.size() == source_dest_pairs.size());
+        for (size_t i = 0; i < source_dest_pairs.size(); ++i) {
+            const auto &[source, destination] = source_dest_pairs[i];
+            const auto is_on_land = source == on_land || destination == on_land;
+            if (is_on_land && !correct_vertices_on_land) {
+                REQUIRE_FALSE(paths[i].path.has_value());
+                REQUIRE(paths[i].error_msg.has_value());
+                REQUIRE_THROWS(path_computer.shortest_path(source, destination));
+            } else {
+                REQUIRE_FALSE(paths[i].error_msg.has_value());
+                REQUIRE(paths[i].path == path_computer.shortest_path(source, destination, INFINITY,
+                                                                     correct_vertices_on_land));
+            }
+        }
+
+        // Each distinct pair is searched at most once
+        REQUIRE(stats->snapshot().num_searches <= (correct_vertices_on_land ? 6 : 4));
+    }
+}
+
+TEST_CASE("ShortestPathComputer batches keep errors to the pairs using a failing endpoint") {
+    const auto graph = VisgraphGenerator::generate({square_island_polygon()});
+    const auto path_computer = ShortestPathComputer(graph);
+
+    const auto a = Coordinate(-2., 0.5);
+    const auto b = Coordinate(2., -0.5);
+    const auto c = Coordinate(0.5, 3.);
+    // Off the globe, so it cannot be checked against land
+    const auto invalid = Coordinate(0., 95.);
+    REQUIRE_THROWS(path_computer.shortest_path(a, invalid));
+
+    const auto source_dest_pairs = std::vector<std::pair<Coordinate, Coordinate>>{
+        {a, b}, {invalid, b}, {a, c}, {a, invalid}, {c, b},
+    };
+    for (const auto correct_vertices_on_land : {false, true}) {
+        const auto paths = path_computer.shortest_paths(source_dest_pairs, INFINITY, correct_vertices_on_land);
+        REQUIRE(paths.size() == source_dest_pairs.size());
+        for (size_t i = 0; i < source_dest_pairs.size(); ++i) {
+            const auto &[source, destination] = source_dest_pairs[i];
+            if (source == invalid || destination == invalid) {
+                REQUIRE_FALSE(paths[i].path.has_value());
+                REQUIRE(paths[i].error_msg.has_value());
+            } else {
+                REQUIRE_FALSE(paths[i].error_msg.has_value());
+                REQUIRE(paths[i].path == path_computer.shortest_path(source, destination));
+            }
+        }
+    }
+}
+
+TEST_CASE("ShortestPathComputer remembers endpoints searched from again") {
+    const auto graph = VisgraphGenerator::generate({square_island_polygon()});
+    const auto a = Coordinate(-2., 0.5);
+    const auto b = Coordinate(2., -0.5);
+    const auto on_land = Coordinate(0.5, 0.);
+
+    const auto uncached_computer =
+        ShortestPathComputer(graph, nullptr, DEFAULT_REFINEMENT_RADIUS, nullptr, nullptr, 0);
+    const auto path_computer = ShortestPathComputer(graph);
+    REQUIRE(path_computer.endpoint_cache_stats().num_hits == 0);
+
+    const auto path = path_computer.shortest_path(a, b);
+    const auto misses = path_computer.endpoint_cache_stats().num_misses;
+    REQUIRE(path_computer.shortest_path(b, a) == uncached_computer.shortest_path(b, a));
+    REQUIRE(path_computer.shortest_path(a, b) == path);
+    REQUIRE(path == uncached_computer.shortest_path(a, b));
+
+    // Both endpoints are checked against land and linked to the graph from the cache the second time round
+    const auto stats = path_computer.endpoint_cache_stats();
+    REQUIRE(stats.num_misses == misses);
+    REQUIRE(stats.num_hits >= 8);
+    REQUIRE(stats.num_entries == 2);
+    REQUIRE(uncached_computer.endpoint_cache_stats().num_entries == 0);
+
+    // A point on land is remembered whether or not it was moved off it
+    REQUIRE_THROWS(path_computer.shortest_path(on_land, b));
+    REQUIRE(path_computer.shortest_path(on_land, b, INFINITY, true) ==
+            uncached_computer.shortest_path(on_land, b, INFINITY, true));
+    REQUIRE_THROWS(path_computer.shortest_path(on_land, b));
+}
+
+TEST_CASE("ShortestPathComputer follows remembered paths between nearby endpoints") {
+    const auto graph = VisgraphGenerator::generate({square_island_polygon()});
+    const auto a = Coordinate(-2.05, 0.75);
+    const auto b = Coordinate(2.05, 0.65);
+    // In the same grid cells as a and b, and seeing the same graph vertices
+    const auto nearby_a = Coordinate(-2.02, 0.78);
+    const auto nearby_b = Coordinate(2.08, 0.62);
+
+    const auto uncached_computer = ShortestPathComputer(graph);
+    const auto path_computer =
+        ShortestPathComputer(graph, nullptr, DEFAULT_REFINEMENT_RADIUS, nullptr, nullptr,
+                             DEFAULT_ENDPOINT_CACHE_CAPACITY, 1 << 20, DEFAULT_PATH_CACHE_CELL_SIZE);
+    REQUIRE(uncached_computer.path_cache_stats().capacity == 0);
+
+    REQUIRE(path_computer.shortest_path(a, b) == uncached_computer.shortest_path(a, b));
+    auto stats = path_computer.path_cache_stats();
+    REQUIRE(stats.num_misses == 1);
+    REQUIRE(stats.num_entries == 1);
+    REQUIRE(stats.size > 0);
+
+    const auto nearby_path = path_computer.shortest_path(nearby_a, nearby_b);
+    REQUIRE(path_computer.path_cache_stats().num_hits == 1);
+    REQUIRE(nearby_path == uncached_computer.shortest_path(nearby_a, nearby_b));
+
+    // Endpoints in other cells, and searches made differently, are searched afresh
+    const auto below_a = Coordinate(-2.05, -0.75);
+    REQUIRE(path_computer.shortest_path(below_a, b) == uncached_computer.shortest_path(below_a, b));
+    REQUIRE(path_computer.shortest_path(a, b, INFINITY, false, 1.5) ==
+            uncached_computer.shortest_path(a, b, INFINITY, false, 1.5));
+    stats = path_computer.path_cache_stats();
+    REQUIRE(stats.num_hits == 1);
+    REQUIRE(stats.num_misses == 3);
+    REQUIRE(uncached_computer.path_cache_stats().num_entries == 0);
+
+    REQUIRE_THROWS(ShortestPathComputer(graph, nullptr, DEFAULT_REFINEMENT_RADIUS, nullptr, nullptr,
+                                        DEFAULT_ENDPOINT_CACHE_CAPACITY, 1 << 20, 0.));
+}
+
+TEST_CASE("ShortestPathComputer hierarchical shortest path") {
+    // A jagged island between the endpoints, whose coarse graph keeps only the tips of its spikes
+    const auto polygons = std::vector<Polygon>{star_island_polygon(30, 7.), Polygon({
+        Coordinate(-21., -1.),
+        Coordinate(-20., -1.),
+        Coordinate(-20.5, 1.),
+    })};
+    const auto coarse_polygons =
+        PolygonSimplifier::simplify_outwards(polygons, SimplificationMethod::VISVALINGAM, 200000.);
+
+    const auto graph = VisgraphGenerator::generate(polygons);
+    const auto coarse_graph = VisgraphGenerator::generate_coarse(polygons, coarse_polygons);
+    REQUIRE(coarse_graph->get_vertices().size() < graph->get_vertices().size());
+
+    const auto a = Coordinate(-30., 0.);
+    const auto b = Coordinate(30., 0.5);
+    const auto path_computer = ShortestPathComputer(graph);
+    const auto hierarchical_path_computer = ShortestPathComputer(graph, coarse_graph, 5.);
+
+    const auto shortest_path = path_computer.shortest_path(a, b);
+    const auto hierarchical_path = hierarchical_path_computer.shortest_path(a, b);
+
+    REQUIRE(hierarchical_path.front() == a);
+    REQUIRE(hierarchical_path.back() == b);
+    for (size_t i = 2; i < hierarchical_path.size() - 1; ++i) {
+        REQUIRE(graph->has_edge(hierarchical_path[i - 1], hierarchical_path[i]));
+    }
+    REQUIRE(path_length(hierarchical_path) >= path_length(shortest_path) - 1e-9);
+    REQUIRE(path_length(hierarchical_path) <= path_length(shortest_path) * 1.05);
+
+    // Nearby endpoints are searched on the detailed graph alone
+    REQUIRE(hierarchical_path_computer.shortest_path(Coordinate(-9., 0.), Coordinate(-5., 8.)) ==
+            path_computer.shortest_path(Coordinate(-9., 0.), Coordinate(-5., 8.)));
+
+    // Falls back to the detailed graph when the coarse graph has no route
+    const auto disconnected_path_computer =
+        ShortestPathComputer(graph, std::make_shared<Graph>(coarse_polygons), 5.);
+    REQUIRE(disconnected_path_computer.shortest_path(a, b) == shortest_path);
+}
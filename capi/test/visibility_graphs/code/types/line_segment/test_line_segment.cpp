@@ -97,3 +97,23 @@ TEST_CASE("Line Segment Project") {
     REQUIRE(std::abs(proj_point_2.get_longitude() - expected_proj_point_2.get_longitude()) < 0.0001);
     REQUIRE(std::abs(proj_point_2.get_latitude() - expected_proj_point_2.get_latitude()) < 0.0001);
 }
+
+TEST_CASE("Line Segment distance to point") {
+    const auto line_segment = LineSegment(Coordinate(0.0, 0.0), Coordinate(2.0, 0.0));
+    const auto degenerate_segment = LineSegment(Coordinate(1.0, 1.0), Coordinate(1.0, 1.0));
+
+    REQUIRE(std::abs(line_segment.distance_to_point(Coordinate(1.0, 0.0))) < 0.0001);
+    REQUIRE(std::abs(line_segment.distance_to_point(Coordinate(1.0, 1.5)) - 1.5) < 0.0001);
+    REQUIRE(std::abs(line_segment.distance_to_point(Coordinate(-3.0, 4.0)) - 5.0) < 0.0001);
+    REQUIRE(std::abs(line_segment.distance_to_point(Coordinate(5.0, -4.0)) - 5.0) < 0.0001);
+    REQUIRE(std::abs(degenerate_segment.distance_to_point(Coordinate(4.0, 5.0)) - 5.0) < 0.0001);
+}
+
+TEST_CASE("Line Segment Properly Intersects") {
+    const auto segment = LineSegment(Coordinate(0., 0.), Coordinate(2., 2.));
+
+    REQUIRE(segment.properly_intersects(LineSegment(Coordinate(0., 2.), Coordinate(2., 0.))));
+    REQUIRE_FALSE(segment.properly_intersects(LineSegment(Coordinate(1., 1.), Coordinate(2., 0.))));
+    REQUIRE_FALSE(segment.properly_intersects(LineSegment(Coordinate(1., 1.), Coordinate(3., 3.))));
+    REQUIRE_FALSE(segment.properly_intersects(LineSegment(Coordinate(3., 0.), Coordinate(4., 1.))));
+}
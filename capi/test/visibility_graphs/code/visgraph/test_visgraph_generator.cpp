@@ -3,15 +3,25 @@
 //
 
 #include <catch.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <omp.h>
 #include <vector>
 
 #include "constants/constants.hpp"
+#include "geom/polygon_simplifier/polygon_simplifier.hpp"
+#include "serialization/graph_serializer.hpp"
+#include "serialization/sparse_graph_serializer.hpp"
 #include "types/coordinate/coordinate.hpp"
 #include "types/polygon/polygon.hpp"
 #include "types/visible_vertex/visible_vertex.hpp"
 #include "visgraph/visgraph_generator.hpp"
 
 void add_edges(const Coordinate &source, const std::vector<VisibleVertex> &neighbors, const std::shared_ptr<Graph>& g);
+// Islands either side of the origin, one with a concave side, and a pair either side of the meridian
+std::vector<Polygon> polygons_straddling_meridian();
 
 TEST_CASE("Visgraph Generator Normal Case") {
     const auto poly1 = Polygon({
@@ -133,8 +143,298 @@ TEST_CASE("Visgraph Generator Polygon along world boundary") {
     REQUIRE(*visgraph == *expected_vis_graph);
 }
 
+TEST_CASE("Visgraph Generator periodic replication margin") {
+    const auto poly1 = Polygon({
+        Coordinate(1., 0.),
+        Coordinate(0., 1.),
+        Coordinate(-1., 0.),
+    });
+
+    const auto poly2 = Polygon({
+        Coordinate(5., 0.),
+        Coordinate(3., 0.),
+        Coordinate(4., 2.),
+    });
+
+    // Neither polygon is within 10 degrees of the meridian, so nothing is visible across it
+    const auto visgraph = VisgraphGenerator::generate(std::vector<Polygon>{poly1, poly2}, 10.0);
+    const auto full_range_visgraph = VisgraphGenerator::generate_with_shuffled_range(
+        std::vector<Polygon>{poly1, poly2}, 0, poly1.get_vertices().size() + poly2.get_vertices().size(), 42, 10.0);
+
+    auto expected_vis_graph = std::make_shared<Graph>(std::vector<Polygon> {poly1, poly2});
+    add_edges(Coordinate(5., 0.),
+              {
+                  VisibleVertex{.coord = Coordinate(3., 0.), .is_visible_across_meridian = false},
+                  VisibleVertex{.coord = Coordinate(4., 2.), .is_visible_across_meridian = false},
+              },
+              expected_vis_graph);
+    add_edges(Coordinate(-1., 0.),
+              {
+                  VisibleVertex{.coord = Coordinate(1., 0.), .is_visible_across_meridian = false},
+                  VisibleVertex{.coord = Coordinate(3., 0.), .is_visible_across_meridian = false},
+                  VisibleVertex{.coord = Coordinate(0., 1.), .is_visible_across_meridian = false},
+              },
+              expected_vis_graph);
+    add_edges(Coordinate(3., 0.),
+              {
+                  VisibleVertex{.coord = Coordinate(1., 0.), .is_visible_across_meridian = false},
+                  VisibleVertex{.coord = Coordinate(0., 1.), .is_visible_across_meridian = false},
+                  VisibleVertex{.coord = Coordinate(4., 2.), .is_visible_across_meridian = false},
+              },
+              expected_vis_graph);
+    add_edges(Coordinate(4., 2.),
+              {
+                  VisibleVertex{.coord = Coordinate(1., 0.), .is_visible_across_meridian = false},
+                  VisibleVertex{.coord = Coordinate(0., 1.), .is_visible_across_meridian = false},
+              },
+              expected_vis_graph);
+    add_edges(Coordinate(0., 1.),
+              {
+                  VisibleVertex{.coord = Coordinate(1., 0.), .is_visible_across_meridian = false},
+              },
+              expected_vis_graph);
+
+    REQUIRE(*visgraph == *expected_vis_graph);
+    REQUIRE(*full_range_visgraph == *expected_vis_graph);
+}
+
+TEST_CASE("Visgraph Generator periodic replication margin along world boundary") {
+    const auto polygon = Polygon({
+        Coordinate(MAX_LONGITUDE, MAX_LATITUDE),
+        Coordinate(MAX_LONGITUDE, MIN_LATITUDE),
+        Coordinate(MIN_LONGITUDE, MIN_LATITUDE),
+        Coordinate(MIN_LONGITUDE, MAX_LATITUDE),
+    });
+
+    const auto visgraph = VisgraphGenerator::generate(std::vector<Polygon>{polygon});
+    const auto margin_visgraph = VisgraphGenerator::generate(std::vector<Polygon>{polygon}, 1.0);
+
+    REQUIRE(*visgraph == *margin_visgraph);
+}
+
+TEST_CASE("Visgraph Generator bounded edge length") {
+    const auto polygons = polygons_straddling_meridian();
+    const auto max_edge_length = 4.5;
+
+    const auto visgraph = VisgraphGenerator::generate(polygons);
+    const auto bounded_visgraph = VisgraphGenerator::generate(polygons, INFINITY, max_edge_length);
+    const auto bounded_range_visgraph =
+        VisgraphGenerator::generate_with_shuffled_range(polygons, 0, visgraph->get_vertices().size(), 42, INFINITY,
+                                                        max_edge_length);
+    const auto loosely_bounded_visgraph = VisgraphGenerator::generate(polygons, INFINITY, 1000.0);
+
+    size_t num_bounded_edges = 0;
+    for (const auto &a : visgraph->get_vertices()) {
+        for (const auto &b : visgraph->get_vertices()) {
+            if (a == b) {
+                continue;
+            }
+
+            const auto meridian_crossing = visgraph->is_edge_meridian_crossing(a, b);
+            const auto edge_length =
+                meridian_crossing ? std::min((a + Coordinate(LONGITUDE_PERIOD_MICRODEGREES, 0) - b).magnitude(),
+                                             (a - Coordinate(LONGITUDE_PERIOD_MICRODEGREES, 0) - b).magnitude())
+                                  : (a - b).magnitude();
+            const auto expect_edge = visgraph->has_edge(a, b) && edge_length <= max_edge_length;
+
+            REQUIRE(bounded_visgraph->has_edge(a, b) == expect_edge);
+            REQUIRE(bounded_visgraph->is_edge_meridian_crossing(a, b) == (expect_edge && meridian_crossing));
+            num_bounded_edges += expect_edge;
+        }
+    }
+
+    REQUIRE(num_bounded_edges > 0);
+    REQUIRE(*bounded_range_visgraph == *bounded_visgraph);
+    REQUIRE(*loosely_bounded_visgraph == *visgraph);
+}
+
+TEST_CASE("Visgraph Generator tiled generation") {
+    const auto polygons = polygons_straddling_meridian();
+    const auto halo = 4.5;
+    const auto tile_level = 4;
+
+    const auto bounded_visgraph = VisgraphGenerator::generate(polygons, INFINITY, halo);
+    const auto tiled_visgraph = VisgraphGenerator::generate_tiled(polygons, tile_level, halo);
+
+    REQUIRE(VisgraphGenerator::tile_ids(polygons, tile_level).size() > 1);
+    REQUIRE(tiled_visgraph->get_vertices().size() == bounded_visgraph->get_vertices().size());
+    for (const auto &a : bounded_visgraph->get_vertices()) {
+        for (const auto &b : bounded_visgraph->get_vertices()) {
+            REQUIRE(tiled_visgraph->has_edge(a, b) == bounded_visgraph->has_edge(a, b));
+            REQUIRE(tiled_visgraph->is_edge_meridian_crossing(a, b) ==
+                    bounded_visgraph->is_edge_meridian_crossing(a, b));
+        }
+    }
+
+    REQUIRE_THROWS(VisgraphGenerator::generate_tiled(polygons, tile_level, INFINITY));
+    REQUIRE_THROWS(VisgraphGenerator::tile_ids(polygons, -1));
+}
+
+TEST_CASE("Visgraph Generator resumes from checkpoint") {
+    const auto polygons = polygons_straddling_meridian();
+    const auto expected_visgraph = VisgraphGenerator::generate(polygons);
+
+    char tmp_name[L_tmpnam];
+    tmpnam(tmp_name);
+
+    const auto checkpointed_visgraph = VisgraphGenerator::generate_with_checkpoints(polygons, tmp_name, INFINITY,
+                                                                                    INFINITY, 4);
+    REQUIRE(*checkpointed_visgraph == *expected_visgraph);
+
+    // Simulate dying part way through writing the checkpoint
+    std::filesystem::resize_file(tmp_name, std::filesystem::file_size(tmp_name) / 2);
+    const auto resumed_visgraph = VisgraphGenerator::generate_with_checkpoints(polygons, tmp_name, INFINITY,
+                                                                               INFINITY, 4);
+    REQUIRE(*resumed_visgraph == *expected_visgraph);
+
+    REQUIRE_THROWS(VisgraphGenerator::generate_with_checkpoints(polygons, tmp_name, INFINITY, 10.0, 4));
+
+    remove(tmp_name);
+}
+
+TEST_CASE("Visgraph Generator sparse generation within a memory limit") {
+    const auto polygons = polygons_straddling_meridian();
+    const auto expected_visgraph = VisgraphGenerator::generate(polygons);
+
+    char tmp_name[L_tmpnam];
+    tmpnam(tmp_name);
+
+    VisgraphGenerator::generate_to_sparse_file(polygons, tmp_name, 0);
+    const auto sparse_visgraph = SparseGraphSerializer::deserialize_from_file(tmp_name);
+
+    remove(tmp_name);
+    REQUIRE_FALSE(std::filesystem::exists(std::string(tmp_name) + ".runs"));
+
+    REQUIRE(sparse_visgraph->get_vertices() == expected_visgraph->get_vertices());
+    for (const auto &a : expected_visgraph->get_vertices()) {
+        for (const auto &b : expected_visgraph->get_vertices()) {
+            REQUIRE(sparse_visgraph->has_edge(a, b) == expected_visgraph->has_edge(a, b));
+            REQUIRE(sparse_visgraph->is_edge_meridian_crossing(a, b) ==
+                    expected_visgraph->is_edge_meridian_crossing(a, b));
+        }
+    }
+}
+
+TEST_CASE("Visgraph Generator output is independent of the number of threads") {
+    auto polygons = polygons_straddling_meridian();
+    // Vertices collinear with others, so edges tie in distance during the sweep
+    polygons.push_back(Polygon({Coordinate(7., 0.), Coordinate(8., 0.), Coordinate(7.5, 1.)}));
+
+    const auto serialized_graph = [&polygons](int num_threads) {
+        const auto max_threads = omp_get_max_threads();
+        omp_set_num_threads(num_threads);
+        const auto graph = VisgraphGenerator::generate(polygons);
+        omp_set_num_threads(max_threads);
+
+        char tmp_name[L_tmpnam];
+        tmpnam(tmp_name);
+        GraphSerializer::serialize_to_file(graph, tmp_name);
+
+        auto file = std::ifstream(tmp_name, std::ios::binary);
+        auto contents = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        remove(tmp_name);
+
+        return contents;
+    };
+
+    const auto single_threaded_graph = serialized_graph(1);
+    REQUIRE(serialized_graph(3) == single_threaded_graph);
+    REQUIRE(serialized_graph(8) == single_threaded_graph);
+}
+
+TEST_CASE("Visgraph Generator records generation stats") {
+    const auto polygons = std::vector<Polygon>{
+        Polygon({Coordinate(1., 0.), Coordinate(0., 1.), Coordinate(-1., 0.)}),
+        Polygon({Coordinate(5., 0.), Coordinate(3., 0.), Coordinate(4., 2.)}),
+        Polygon({Coordinate(12., 3.), Coordinate(9., 4.), Coordinate(10., -2.), Coordinate(11., 1.)}),
+    };
+    auto stats = std::make_shared<GenerationStats>();
+
+    const auto visgraph = VisgraphGenerator::generate(polygons, INFINITY, INFINITY, stats);
+    const auto snapshot = stats->snapshot();
+
+    size_t num_edges = 0;
+    for (const auto &vertex : visgraph->get_vertices()) {
+        num_edges += visgraph->get_neighbors(vertex).size();
+    }
+
+    REQUIRE(snapshot.num_observers == 10);
+    REQUIRE(snapshot.num_completed_observers == 10);
+    // Observers only sweep half of the plane, so each edge is emitted from at least one end
+    REQUIRE(snapshot.num_emitted_edges >= num_edges / 2);
+    REQUIRE(snapshot.num_emitted_edges <= num_edges);
+    REQUIRE_FALSE(snapshot.thread_busy_seconds.empty());
+    REQUIRE(snapshot.elapsed_seconds > 0);
+    REQUIRE(snapshot.observers_per_second > 0);
+
+    // Elapsed time stops when generation finishes
+    REQUIRE(stats->snapshot().elapsed_seconds == snapshot.elapsed_seconds);
+}
+
+TEST_CASE("Visgraph Generator coarse graph") {
+    auto polygons = polygons_straddling_meridian();
+    // Islands with slight bumps along their bases, which the coarse polygons smooth over
+    polygons.push_back(Polygon({Coordinate(-4., 0.), Coordinate(-3., 0.02), Coordinate(-2., 0.), Coordinate(-3., 1.)}));
+    polygons.push_back(Polygon({Coordinate(6., -3.), Coordinate(7., -2.98), Coordinate(8., -3.), Coordinate(7., -2.)}));
+    const auto coarse_polygons =
+        PolygonSimplifier::simplify_outwards(polygons, SimplificationMethod::VISVALINGAM, 20000.);
+
+    const auto visgraph = VisgraphGenerator::generate(polygons);
+    const auto coarse_visgraph = VisgraphGenerator::generate_coarse(polygons, coarse_polygons);
+
+    // The coarse graph is the detailed graph restricted to the coarse vertices
+    REQUIRE(coarse_visgraph->get_vertices().size() < visgraph->get_vertices().size());
+    for (const auto &a : coarse_visgraph->get_vertices()) {
+        for (const auto &b : coarse_visgraph->get_vertices()) {
+            REQUIRE(coarse_visgraph->has_edge(a, b) == visgraph->has_edge(a, b));
+            REQUIRE(coarse_visgraph->is_edge_meridian_crossing(a, b) == visgraph->is_edge_meridian_crossing(a, b));
+        }
+    }
+
+    REQUIRE_THROWS(VisgraphGenerator::generate_coarse(
+        polygons, {Polygon({Coordinate(1., 0.), Coordinate(0., 2.), Coordinate(-1., 0.)})}));
+}
+
+TEST_CASE("Visgraph Generator incremental update") {
+    // Swaps the second shared polygon for one overlapping it, and adds back the last, across the meridian from another
+    const auto shared_polygons = polygons_straddling_meridian();
+    const auto kept_polygons = std::vector<Polygon>{shared_polygons[0], shared_polygons[2], shared_polygons[3]};
+    const auto removed_polygon = shared_polygons[1];
+    const auto added_polygons = std::vector<Polygon>{
+        Polygon({Coordinate(6., 1.), Coordinate(5., 3.), Coordinate(4., 1.)}),
+        shared_polygons[4],
+    };
+
+    auto polygons = kept_polygons;
+    polygons.push_back(removed_polygon);
+    auto updated_polygons = kept_polygons;
+    updated_polygons.insert(updated_polygons.end(), added_polygons.begin(), added_polygons.end());
+
+    for (const auto max_edge_length : {static_cast<double>(INFINITY), 4.5}) {
+        const auto visgraph = VisgraphGenerator::generate(polygons, INFINITY, max_edge_length);
+        const auto expected_visgraph = VisgraphGenerator::generate(updated_polygons, INFINITY, max_edge_length);
+
+        const auto updated_visgraph =
+            VisgraphGenerator::update(visgraph, added_polygons, {removed_polygon}, INFINITY, max_edge_length);
+
+        REQUIRE(*updated_visgraph == *expected_visgraph);
+    }
+
+    REQUIRE_THROWS(VisgraphGenerator::update(VisgraphGenerator::generate(kept_polygons), {}, {removed_polygon}));
+}
+
 void add_edges(const Coordinate &source, const std::vector<VisibleVertex> &neighbors, const std::shared_ptr<Graph>& g) {
     for (const auto &neighbor : neighbors) {
         g->add_edge(source, neighbor.coord, neighbor.is_visible_across_meridian);
     }
 }
+
+std::vector<Polygon> polygons_straddling_meridian() {
+    return std::vector<Polygon>{
+        Polygon({Coordinate(1., 0.), Coordinate(0., 1.), Coordinate(-1., 0.)}),
+        Polygon({Coordinate(5., 0.), Coordinate(3., 0.), Coordinate(4., 2.)}),
+        Polygon({Coordinate(12., 3.), Coordinate(9., 4.), Coordinate(10., -2.), Coordinate(11., 1.)}),
+        Polygon({Coordinate(179., 0.), Coordinate(178., 1.5), Coordinate(177., 0.)}),
+        Polygon({Coordinate(-178., -1.), Coordinate(-177., 0.5), Coordinate(-179., 0.5)}),
+    };
+}
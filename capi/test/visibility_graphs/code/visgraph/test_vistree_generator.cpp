@@ -683,4 +683,47 @@ TEST_CASE("Vistree generator sees neighbors") {
     std::sort(expected_vertices.begin(), expected_vertices.end(), coord_sorter);
 
     REQUIRE(visible_vertices == expected_vertices);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Vistree Generator get visible vertices batch") {
+    const auto poly1 = Polygon({
+        Coordinate(1., 0.),
+        Coordinate(0., 1.),
+        Coordinate(-1., 0.),
+        Coordinate(-1., -1.),
+        Coordinate(0., -1.),
+        Coordinate(0.3, -0.5),
+    });
+
+    const auto poly2 = Polygon({
+        Coordinate(3., -1.),
+        Coordinate(2., -2.),
+        Coordinate(2.9, -3.),
+        Coordinate(3., -3.),
+        Coordinate(4., -2.),
+    });
+
+    const auto generator = VistreeGenerator(std::vector<Polygon>{poly1, poly2});
+    const auto observers = std::vector<Coordinate>{
+        Coordinate(1., 0.), Coordinate(5., 5.), Coordinate(2.5, -2.5), Coordinate(-5., 0.), Coordinate(3., -1.),
+    };
+
+    const auto batch = generator.get_visible_vertices_batch(observers);
+
+    REQUIRE(batch.offsets.size() == observers.size() + 1);
+    REQUIRE(batch.offsets.front() == 0);
+    REQUIRE(batch.offsets.back() == batch.coords.size());
+    REQUIRE(batch.is_visible_across_meridian.size() == batch.coords.size());
+
+    for (size_t i = 0; i < observers.size(); ++i) {
+        auto batch_visible_vertices = std::vector<VisibleVertex>();
+        for (size_t j = batch.offsets[i]; j < batch.offsets[i + 1]; ++j) {
+            batch_visible_vertices.push_back(VisibleVertex{
+                .coord = batch.coords[j],
+                .is_visible_across_meridian = batch.is_visible_across_meridian[j] != 0,
+            });
+        }
+
+        REQUIRE(batch_visible_vertices == generator.get_visible_vertices(observers[i]));
+    }
+}